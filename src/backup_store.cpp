@@ -0,0 +1,298 @@
+// Content-addressed backup history: files are split into 4 KB chunks that are stored once by
+// hash, and every backup generation is a small manifest listing the chunks of its files.
+#include "backup_store.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <unordered_set>
+#include <utility>
+
+#include "save_commit.h"
+#include "save_view.h"
+
+namespace io {
+namespace {
+constexpr const char *kManifestHeader = "PM3000 BACKUP";
+constexpr const char *kManifestSuffix = ".manifest";
+
+bool writeAtomically(const std::filesystem::path &path, const void *data, std::size_t size) {
+    std::filesystem::path temp = path;
+    temp += ".tmp";
+    if (!writeFileDurable(temp, data, size)) {
+        return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
+
+bool readManifest(const std::filesystem::path &path, BackupGeneration &generation) {
+    std::ifstream in(path);
+    std::string line;
+    if (!in || !std::getline(in, line) || line != kManifestHeader) {
+        return false;
+    }
+
+    BackupFile *current = nullptr;
+    std::size_t remaining = 0;
+    while (std::getline(in, line)) {
+        if (remaining > 0 && current != nullptr) {
+            current->chunks.push_back(line);
+            --remaining;
+            continue;
+        }
+        std::istringstream fields(line);
+        std::string kind;
+        fields >> kind;
+        if (kind == "label") {
+            fields >> generation.label;
+        } else if (kind == "time") {
+            fields >> generation.time;
+        } else if (kind == "file") {
+            BackupFile file;
+            fields >> file.name >> file.size >> remaining;
+            generation.files.push_back(std::move(file));
+            current = &generation.files.back();
+        }
+    }
+    return remaining == 0;
+}
+
+// Only the header and label lines, for deciding what to prune without reading the chunk lists.
+bool readLabel(const std::filesystem::path &path, std::string &label) {
+    std::ifstream in(path);
+    std::string line;
+    if (!in || !std::getline(in, line) || line != kManifestHeader || !std::getline(in, line)) {
+        return false;
+    }
+    std::istringstream fields(line);
+    std::string kind;
+    return fields >> kind >> label && kind == "label";
+}
+} // namespace
+
+BackupStore::BackupStore(std::filesystem::path root) : storeRoot(std::move(root)) {}
+
+std::string BackupStore::chunkKey(const void *data, std::size_t size) {
+    // Two unrelated 64-bit hashes (FNV-1a and a multiply-rotate mix) make a 128-bit key.
+    const auto *bytes = static_cast<const unsigned char *>(data);
+    std::uint64_t fnv = 1469598103934665603ULL;
+    std::uint64_t mix = 0x9E3779B97F4A7C15ULL ^ size;
+    for (std::size_t i = 0; i < size; ++i) {
+        fnv = (fnv ^ bytes[i]) * 1099511628211ULL;
+        mix = (mix ^ bytes[i]) * 0xFF51AFD7ED558CCDULL;
+        mix = (mix << 31) | (mix >> 33);
+    }
+    char key[33];
+    std::snprintf(key, sizeof(key), "%016" PRIx64 "%016" PRIx64, fnv, mix);
+    return key;
+}
+
+std::filesystem::path BackupStore::chunkPath(const std::string &key) const {
+    return storeRoot / "chunks" / key.substr(0, 2) / key;
+}
+
+std::filesystem::path BackupStore::manifestPath(std::uint32_t id) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%08u%s", static_cast<unsigned>(id), kManifestSuffix);
+    return storeRoot / "manifests" / name;
+}
+
+std::filesystem::path BackupStore::counterPath() const {
+    return storeRoot / "manifests" / "next";
+}
+
+std::vector<std::uint32_t> BackupStore::manifestIds() const {
+    std::vector<std::uint32_t> ids;
+    std::error_code ec;
+    for (const auto &entry : std::filesystem::directory_iterator(storeRoot / "manifests", ec)) {
+        const auto &path = entry.path();
+        if (path.extension() != kManifestSuffix) {
+            continue;
+        }
+        auto id = static_cast<std::uint32_t>(std::strtoul(path.stem().string().c_str(), nullptr, 10));
+        if (id != 0) {
+            ids.push_back(id);
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+std::uint32_t BackupStore::nextId() const {
+    std::ifstream in(counterPath());
+    std::uint32_t id = 0;
+    std::error_code ec;
+    if (in >> id && id != 0 && !std::filesystem::exists(manifestPath(id), ec)) {
+        return id;
+    }
+    // No counter yet (or one left behind by an older store): one past the newest manifest.
+    auto ids = manifestIds();
+    return ids.empty() ? 1 : ids.back() + 1;
+}
+
+std::uint32_t BackupStore::addGeneration(const std::string &label, const std::vector<std::filesystem::path> &files,
+                                         std::string &error) {
+    std::error_code ec;
+    std::filesystem::create_directories(storeRoot / "manifests", ec);
+    if (ec) {
+        error = "Failed to create backup directory: " + storeRoot.string();
+        return 0;
+    }
+
+    std::uint32_t id = nextId();
+
+    std::string manifest = std::string(kManifestHeader) + "\nlabel " + label + "\ntime " +
+                           std::to_string(static_cast<long long>(std::time(nullptr))) + "\n";
+    std::unordered_set<std::string> stored;
+    for (const auto &path : files) {
+        MappedFile source;
+        try {
+            source = MappedFile(path);
+        } catch (const std::runtime_error &e) {
+            error = e.what();
+            return 0;
+        }
+
+        std::vector<std::string> keys;
+        for (std::size_t offset = 0; offset < source.size(); offset += kBackupChunkSize) {
+            std::size_t size = std::min(kBackupChunkSize, source.size() - offset);
+            std::string key = chunkKey(source.data() + offset, size);
+            std::filesystem::path target = chunkPath(key);
+            if (stored.insert(key).second && !std::filesystem::exists(target, ec)) {
+                std::filesystem::create_directories(target.parent_path(), ec);
+                if (!writeAtomically(target, source.data() + offset, size)) {
+                    error = "Could not write backup chunk " + target.string();
+                    return 0;
+                }
+            }
+            keys.push_back(std::move(key));
+        }
+
+        manifest += "file " + path.filename().string() + " " + std::to_string(source.size()) + " " +
+                    std::to_string(keys.size()) + "\n";
+        for (const auto &key : keys) {
+            manifest += key + "\n";
+        }
+    }
+
+    // Chunks are durable before the manifest that refers to them appears.
+    std::filesystem::path manifestFile = manifestPath(id);
+    if (!writeAtomically(manifestFile, manifest.data(), manifest.size())) {
+        error = "Could not write backup manifest " + manifestFile.string();
+        return 0;
+    }
+    // A lost counter update only costs the directory listing in nextId().
+    std::string counter = std::to_string(id + 1) + "\n";
+    writeAtomically(counterPath(), counter.data(), counter.size());
+    syncFolder(manifestFile.parent_path());
+    return id;
+}
+
+std::vector<BackupGeneration> BackupStore::generations() const {
+    std::vector<BackupGeneration> result;
+    for (std::uint32_t id : manifestIds()) {
+        BackupGeneration generation;
+        generation.id = id;
+        if (readManifest(manifestPath(id), generation)) {
+            result.push_back(std::move(generation));
+        }
+    }
+    return result;
+}
+
+bool BackupStore::restore(std::uint32_t id, const std::filesystem::path &targetFolder, std::string &error) const {
+    BackupGeneration generation;
+    if (!readManifest(manifestPath(id), generation)) {
+        error = "Unknown backup generation " + std::to_string(id);
+        return false;
+    }
+
+    std::vector<std::string> contents;
+    contents.reserve(generation.files.size());
+    for (const auto &file : generation.files) {
+        std::string data;
+        for (const auto &key : file.chunks) {
+            std::ifstream in(chunkPath(key), std::ios::binary);
+            std::string chunk((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            if (!in.is_open() || chunkKey(chunk.data(), chunk.size()) != key) {
+                error = "Damaged backup chunk " + key;
+                return false;
+            }
+            data += chunk;
+        }
+        if (data.size() != file.size) {
+            error = "Damaged backup of " + file.name;
+            return false;
+        }
+        contents.push_back(std::move(data));
+    }
+
+    std::vector<FileWrite> writes;
+    for (std::size_t i = 0; i < generation.files.size(); ++i) {
+        writes.push_back({targetFolder / generation.files[i].name, contents[i].data(), contents[i].size()});
+    }
+    return commitFiles(targetFolder, writes, error);
+}
+
+void BackupStore::prune(const std::string &label, std::size_t keep) {
+    std::vector<std::uint32_t> ids = manifestIds();
+    std::vector<std::uint32_t> matching;
+    std::string manifestLabel;
+    for (std::uint32_t id : ids) {
+        if (readLabel(manifestPath(id), manifestLabel) && manifestLabel == label) {
+            matching.push_back(id);
+        }
+    }
+    if (matching.size() <= keep) {
+        return;
+    }
+
+    // Only chunks of the dropped generations can have lost their last reference.
+    std::error_code ec;
+    matching.resize(matching.size() - keep);
+    std::unordered_set<std::string> candidates;
+    for (std::uint32_t id : matching) {
+        BackupGeneration generation;
+        if (readManifest(manifestPath(id), generation)) {
+            for (const auto &file : generation.files) {
+                candidates.insert(file.chunks.begin(), file.chunks.end());
+            }
+        }
+        std::filesystem::remove(manifestPath(id), ec);
+    }
+
+    for (std::uint32_t id : ids) {
+        if (candidates.empty()) {
+            break;
+        }
+        if (std::binary_search(matching.begin(), matching.end(), id)) {
+            continue;
+        }
+        BackupGeneration generation;
+        if (!readManifest(manifestPath(id), generation)) {
+            return; // cannot tell what it refers to; keep every chunk
+        }
+        for (const auto &file : generation.files) {
+            for (const auto &key : file.chunks) {
+                candidates.erase(key);
+            }
+        }
+    }
+    for (const auto &key : candidates) {
+        std::filesystem::remove(chunkPath(key), ec);
+    }
+}
+
+} // namespace io
@@ -0,0 +1,63 @@
+// Content-addressed backup history: files are split into 4 KB chunks that are stored once by
+// hash, and every backup generation is a small manifest listing the chunks of its files.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace io {
+
+inline constexpr std::size_t kBackupChunkSize = 4096;
+
+struct BackupFile {
+    std::string name;
+    std::uint64_t size = 0;
+    std::vector<std::string> chunks; // hex keys, in file order
+};
+
+struct BackupGeneration {
+    std::uint32_t id = 0;
+    std::string label;
+    std::int64_t time = 0; // seconds since the epoch
+    std::vector<BackupFile> files;
+};
+
+// Layout under the root folder:
+//   chunks/<first two hex digits>/<key>   immutable chunk contents
+//   manifests/<id>.manifest               one text manifest per generation
+//   manifests/next                        the id the next generation gets
+class BackupStore {
+public:
+    explicit BackupStore(std::filesystem::path root);
+
+    const std::filesystem::path &root() const { return storeRoot; }
+
+    // Adds one generation holding `files`; chunks already in the store are not written again.
+    // Returns the new generation id, or 0 with `error` set.
+    std::uint32_t addGeneration(const std::string &label, const std::vector<std::filesystem::path> &files,
+                                std::string &error);
+    // All generations, oldest first.
+    std::vector<BackupGeneration> generations() const;
+    // Writes every file of the generation into `targetFolder`.
+    bool restore(std::uint32_t id, const std::filesystem::path &targetFolder, std::string &error) const;
+    // Keeps the newest `keep` generations of `label`. Chunks of the dropped generations that no
+    // remaining generation refers to are deleted too; nothing else is read when none are dropped.
+    void prune(const std::string &label, std::size_t keep);
+
+    static std::string chunkKey(const void *data, std::size_t size);
+
+private:
+    std::filesystem::path chunkPath(const std::string &key) const;
+    std::filesystem::path manifestPath(std::uint32_t id) const;
+    std::filesystem::path counterPath() const;
+    // Ids of the manifest files, ascending, from their names alone.
+    std::vector<std::uint32_t> manifestIds() const;
+    std::uint32_t nextId() const;
+
+    std::filesystem::path storeRoot;
+};
+
+} // namespace io
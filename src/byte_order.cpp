@@ -0,0 +1,322 @@
+// Byte order of save slots. PC saves are little-endian and Amiga saves big-endian; loadGame
+// converts a slot to native order once so the rest of PM3000 never has to care.
+#include "byte_order.h"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PM3_BYTE_ORDER_SSSE3 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define PM3_BYTE_ORDER_NEON 1
+#endif
+
+namespace byte_order {
+namespace {
+using Manager = gamea::ManagerRecord;
+constexpr std::size_t kBlockSize = 16;
+constexpr int kPlayerCount = static_cast<int>(sizeof(gamec) / sizeof(PlayerRecord));
+
+// `repeat` copies of a run of `count` integers, `stride` bytes apart.
+void addRun(std::vector<SwapField> &fields, std::size_t offset, int width, std::size_t count,
+            std::size_t repeat = 1, std::size_t stride = 0) {
+    for (std::size_t i = 0; i < repeat; ++i) {
+        fields.push_back({static_cast<std::uint32_t>(offset + i * stride), static_cast<std::uint8_t>(width),
+                          static_cast<std::uint16_t>(count)});
+    }
+}
+
+void addManagerFields(std::vector<SwapField> &fields, std::size_t base) {
+    addRun(fields, base + offsetof(Manager, club_idx), 2, 3); // club_idx, division, contract_length
+    addRun(fields, base + offsetof(Manager, seating_history), 4, 46); // seating_history, terrace_history
+    addRun(fields, base + offsetof(Manager, bank_statement), 4, sizeof(Manager::bank_statement) / 4);
+    addRun(fields, base + offsetof(Manager, loan[0].amount), 4, 1, 4, sizeof(Manager::loan[0]));
+    addRun(fields, base + offsetof(Manager, youth_player), 2, 1);
+    addRun(fields, base + offsetof(Manager, scout[0].results), 2, sizeof(Manager::scout[0].results) / 2, 4,
+           sizeof(Manager::scout[0]));
+    addRun(fields, base + offsetof(Manager, number1), 4, 4); // number1-3, money_from_directors
+    addRun(fields, base + offsetof(Manager, news[0].type), 2, 1, 8, sizeof(Manager::news[0]));
+    addRun(fields, base + offsetof(Manager, news[0].amount), 4, 1, 8, sizeof(Manager::news[0]));
+    addRun(fields, base + offsetof(Manager, news[0].ix1), 2, 3, 8, sizeof(Manager::news[0]));
+    addRun(fields, base + offsetof(Manager, minus_one), 4, 1);
+    addRun(fields, base + offsetof(Manager, unknown_player_idx), 2, 2);
+    addRun(fields, base + offsetof(Manager, stadium.ground_facilities), 4, 8); // ground_facilities-car_park
+    addRun(fields, base + offsetof(Manager, stadium.capacity), 2, 4);
+    addRun(fields, base + offsetof(Manager, numb01), 2, 4);
+    addRun(fields, base + offsetof(Manager, player3_idx), 2, 1);
+    addRun(fields, base + offsetof(Manager, player4_idx), 2, 1);
+
+    using MatchClub = std::remove_reference_t<decltype(Manager::match_summary.club[0])>;
+    for (std::size_t c = 0; c < 2; ++c) {
+        std::size_t club = base + offsetof(Manager, match_summary.club) + c * sizeof(MatchClub);
+        addRun(fields, club + offsetof(MatchClub, club_idx), 2, 3); // club_idx, total_goals, first_half_goals
+        addRun(fields, club + offsetof(MatchClub, lineup[0].player_idx), 2, 1, 14, sizeof(MatchClub::lineup[0]));
+        addRun(fields, club + offsetof(MatchClub, goal), 2, sizeof(MatchClub::goal) / 2);
+        addRun(fields, club + offsetof(MatchClub, always_null), 2, 1);
+        addRun(fields, club + offsetof(MatchClub, home_away_data), 2, 1);
+    }
+    addRun(fields, base + offsetof(Manager, match_summary.weather), 2, 1);
+    addRun(fields, base + offsetof(Manager, match_summary.audience), 4, 1);
+
+    addRun(fields, base + offsetof(Manager, league_history[0].year), 2, 10, 20, sizeof(Manager::league_history[0]));
+    addRun(fields, base + offsetof(Manager, titles), 2, sizeof(Manager::titles) / 2);
+    addRun(fields, base + offsetof(Manager, manager_history), 2, sizeof(Manager::manager_history) / 2);
+    addRun(fields, base + offsetof(Manager, previous_clubs[0].year_from), 2, 2, 4,
+           sizeof(Manager::previous_clubs[0]));
+    addRun(fields, base + offsetof(Manager, year_start_cur_club), 2, 3); // and both award counts
+    addRun(fields, base + offsetof(Manager, match_history[0].goals_f), 2, 2, 242, sizeof(Manager::match_history[0]));
+}
+
+std::vector<SwapField> buildGameaFields() {
+    std::vector<SwapField> fields;
+    addRun(fields, offsetof(gamea, club_index), 2, sizeof(gamea::club_index) / 2);
+    addRun(fields, offsetof(gamea, table), 2, sizeof(gamea::table) / 2);
+    addRun(fields, offsetof(gamea, data000), 2, 2);
+    addRun(fields, offsetof(gamea, data002), 4, 1);
+    addRun(fields, offsetof(gamea, top_scorers), 2, 2, 75, sizeof(gamea::TopScorerEntry));
+    addRun(fields, offsetof(gamea, sorted_numbers), 2, sizeof(gamea::sorted_numbers) / 2);
+
+    // Cup results, the charity shield history, some_table and last_results all repeat the same
+    // 8-byte {int16 idx, int16 goals, int32 audience} entry.
+    constexpr std::size_t cupClub = sizeof(gamea::CupEntry) / 2;
+    const std::size_t cupRuns[][2] = {
+            {offsetof(gamea, cuppy), sizeof(gamea::cuppy) / cupClub},
+            {offsetof(gamea, the_charity_shield_history), sizeof(gamea::the_charity_shield_history) / cupClub},
+            {offsetof(gamea, some_table), sizeof(gamea::some_table) / cupClub},
+            {offsetof(gamea, last_results), sizeof(gamea::last_results) / cupClub},
+    };
+    for (const auto &run : cupRuns) {
+        addRun(fields, run[0], 2, 2, run[1], cupClub);
+        addRun(fields, run[0] + 4, 4, 1, run[1], cupClub);
+    }
+
+    addRun(fields, offsetof(gamea, league[0].history[0].year), 2, 2, 100, sizeof(gamea::league[0].history[0]));
+    addRun(fields, offsetof(gamea, cup[0].history[0].year), 2, 3, 120, sizeof(gamea::cup[0].history[0]));
+    addRun(fields, offsetof(gamea, fixture), 2, sizeof(gamea::fixture) / 2);
+    addRun(fields, offsetof(gamea, transfer_market), 2, sizeof(gamea::transfer_market) / 2);
+    addRun(fields, offsetof(gamea, transfer[0].player_idx), 2, 3, 6, sizeof(gamea::transfer[0]));
+    addRun(fields, offsetof(gamea, transfer[0].fee), 4, 1, 6, sizeof(gamea::transfer[0]));
+    addRun(fields, offsetof(gamea, retired_manager_club_idx), 2, 2);
+    addRun(fields, offsetof(gamea, turn), 2, 17); // turn, year, data10x
+    for (std::size_t m = 0; m < 2; ++m) {
+        addManagerFields(fields, offsetof(gamea, manager) + m * sizeof(Manager));
+    }
+    addRun(fields, offsetof(gamea, inc_number1), 2, 3);
+    return fields;
+}
+
+std::vector<SwapField> buildClubFields() {
+    std::vector<SwapField> fields;
+    addRun(fields, offsetof(ClubRecord, bank_account), 4, 1);
+    addRun(fields, offsetof(ClubRecord, seating_avg), 4, 2);
+    addRun(fields, offsetof(ClubRecord, player_index), 2, sizeof(ClubRecord::player_index) / 2);
+    return fields;
+}
+
+std::vector<SwapField> buildPlayerFields() {
+    std::vector<SwapField> fields;
+    addRun(fields, offsetof(PlayerRecord, wage), 2, 2); // wage, ins_cost
+    return fields;
+}
+
+void swapScalar(unsigned char *p, int width) {
+    if (width == 2) {
+        std::swap(p[0], p[1]);
+    } else {
+        std::swap(p[0], p[3]);
+        std::swap(p[1], p[2]);
+    }
+}
+
+// The fields of one record turned into byte shuffles over its 16-byte blocks. Integers that
+// straddle a block boundary, or sit in a trailing partial block, are swapped one by one.
+struct SwapPlan {
+    struct Block {
+        std::uint32_t offset;
+        std::array<std::uint8_t, kBlockSize> shuffle;
+    };
+
+    std::size_t recordSize = 0;
+    std::vector<Block> blocks;
+    std::vector<SwapField> scalar;
+};
+
+SwapPlan buildPlan(const std::vector<SwapField> &fields, std::size_t recordSize) {
+    SwapPlan plan;
+    plan.recordSize = recordSize;
+    std::vector<int> blockIndex(recordSize / kBlockSize, -1);
+    for (const SwapField &field : fields) {
+        for (std::size_t i = 0; i < field.count; ++i) {
+            std::size_t offset = field.offset + i * field.width;
+            std::size_t block = offset / kBlockSize;
+            std::size_t lane = offset % kBlockSize;
+            if (block >= blockIndex.size() || lane + field.width > kBlockSize) {
+                plan.scalar.push_back({static_cast<std::uint32_t>(offset), field.width, 1});
+                continue;
+            }
+            if (blockIndex[block] < 0) {
+                blockIndex[block] = static_cast<int>(plan.blocks.size());
+                SwapPlan::Block entry{static_cast<std::uint32_t>(block * kBlockSize), {}};
+                for (std::size_t b = 0; b < kBlockSize; ++b) {
+                    entry.shuffle[b] = static_cast<std::uint8_t>(b);
+                }
+                plan.blocks.push_back(entry);
+            }
+            auto &shuffle = plan.blocks[blockIndex[block]].shuffle;
+            for (std::size_t b = 0; b < field.width; ++b) {
+                shuffle[lane + b] = static_cast<std::uint8_t>(lane + field.width - 1 - b);
+            }
+        }
+    }
+    return plan;
+}
+
+#if defined(PM3_BYTE_ORDER_SSSE3)
+__attribute__((target("ssse3"))) void shuffleBlocks(const SwapPlan &plan, unsigned char *data, std::size_t records) {
+    for (std::size_t r = 0; r < records; ++r) {
+        unsigned char *record = data + r * plan.recordSize;
+        for (const SwapPlan::Block &block : plan.blocks) {
+            auto *p = reinterpret_cast<__m128i *>(record + block.offset);
+            __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block.shuffle.data()));
+            _mm_storeu_si128(p, _mm_shuffle_epi8(_mm_loadu_si128(p), mask));
+        }
+    }
+}
+
+bool haveShuffle() {
+    static const bool supported = __builtin_cpu_supports("ssse3");
+    return supported;
+}
+#elif defined(PM3_BYTE_ORDER_NEON)
+void shuffleBlocks(const SwapPlan &plan, unsigned char *data, std::size_t records) {
+    for (std::size_t r = 0; r < records; ++r) {
+        unsigned char *record = data + r * plan.recordSize;
+        for (const SwapPlan::Block &block : plan.blocks) {
+            uint8x16_t mask = vld1q_u8(block.shuffle.data());
+            vst1q_u8(record + block.offset, vqtbl1q_u8(vld1q_u8(record + block.offset), mask));
+        }
+    }
+}
+
+bool haveShuffle() {
+    return true;
+}
+#else
+void shuffleBlocks(const SwapPlan &plan, unsigned char *data, std::size_t records) {
+    std::array<unsigned char, kBlockSize> in;
+    for (std::size_t r = 0; r < records; ++r) {
+        unsigned char *record = data + r * plan.recordSize;
+        for (const SwapPlan::Block &block : plan.blocks) {
+            std::memcpy(in.data(), record + block.offset, kBlockSize);
+            for (std::size_t b = 0; b < kBlockSize; ++b) {
+                record[block.offset + b] = in[block.shuffle[b]];
+            }
+        }
+    }
+}
+
+bool haveShuffle() {
+    return false;
+}
+#endif
+
+void apply(const SwapPlan &plan, const std::vector<SwapField> &fields, void *data, std::size_t records) {
+    auto *bytes = static_cast<unsigned char *>(data);
+    if (!haveShuffle()) {
+        for (std::size_t r = 0; r < records; ++r) {
+            for (const SwapField &field : fields) {
+                for (std::size_t i = 0; i < field.count; ++i) {
+                    swapScalar(bytes + r * plan.recordSize + field.offset + i * field.width, field.width);
+                }
+            }
+        }
+        return;
+    }
+    shuffleBlocks(plan, bytes, records);
+    for (std::size_t r = 0; r < records; ++r) {
+        for (const SwapField &field : plan.scalar) {
+            swapScalar(bytes + r * plan.recordSize + field.offset, field.width);
+        }
+    }
+}
+
+const SwapPlan &gameaPlan() {
+    static const SwapPlan plan = buildPlan(gameaFields(), sizeof(gamea));
+    return plan;
+}
+
+const SwapPlan &clubPlan() {
+    static const SwapPlan plan = buildPlan(clubFields(), sizeof(ClubRecord));
+    return plan;
+}
+
+const SwapPlan &playerPlan() {
+    static const SwapPlan plan = buildPlan(playerFields(), sizeof(PlayerRecord));
+    return plan;
+}
+
+bool validPlayerIndex(int16_t idx) {
+    return idx == -1 || (idx >= 0 && idx < kPlayerCount);
+}
+} // namespace
+
+const std::vector<SwapField> &gameaFields() {
+    static const std::vector<SwapField> fields = buildGameaFields();
+    return fields;
+}
+
+const std::vector<SwapField> &clubFields() {
+    static const std::vector<SwapField> fields = buildClubFields();
+    return fields;
+}
+
+const std::vector<SwapField> &playerFields() {
+    static const std::vector<SwapField> fields = buildPlayerFields();
+    return fields;
+}
+
+ByteOrder detect(const gameb &clubs) {
+    int asStored = 0;
+    int swapped = 0;
+    for (const ClubRecord &club : clubs.club) {
+        for (int slot = 0; slot < 24; ++slot) {
+            int16_t idx = club.player_index[slot];
+            auto raw = static_cast<std::uint16_t>(idx);
+            asStored += validPlayerIndex(idx);
+            swapped += validPlayerIndex(static_cast<int16_t>((raw >> 8) | (raw << 8)));
+        }
+    }
+    if (swapped <= asStored) {
+        return kNative;
+    }
+    return kNative == ByteOrder::Little ? ByteOrder::Big : ByteOrder::Little;
+}
+
+void swap(gamea &data) {
+    apply(gameaPlan(), gameaFields(), &data, 1);
+}
+
+void swap(gameb &data) {
+    apply(clubPlan(), clubFields(), data.club, kClubIdxMax);
+}
+
+void swap(gamec &data) {
+    apply(playerPlan(), playerFields(), data.player, kPlayerCount);
+}
+
+ByteOrder toNative(gamea &gameA, gameb &gameB, gamec &gameC) {
+    ByteOrder order = detect(gameB);
+    if (order != kNative) {
+        swap(gameA);
+        swap(gameB);
+        swap(gameC);
+    }
+    return order;
+}
+
+} // namespace byte_order
@@ -0,0 +1,48 @@
+// Byte order of save slots. PC saves are little-endian and Amiga saves big-endian; loadGame
+// converts a slot to native order once so the rest of PM3000 never has to care.
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "pm3_defs.hh"
+
+namespace byte_order {
+
+enum class ByteOrder {
+    Little,
+    Big
+};
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+inline constexpr ByteOrder kNative = ByteOrder::Big;
+#else
+inline constexpr ByteOrder kNative = ByteOrder::Little;
+#endif
+
+// `count` consecutive integers of `width` (2 or 4) bytes starting `offset` bytes into a record.
+struct SwapField {
+    std::uint32_t offset;
+    std::uint8_t width;
+    std::uint16_t count;
+};
+
+// Every multi-byte field of the record, built from offsetof over pm3_defs.hh. Bitfields packed
+// into 16/32-bit words are swapped as whole words; single bytes never need swapping.
+const std::vector<SwapField> &gameaFields();
+const std::vector<SwapField> &clubFields();
+const std::vector<SwapField> &playerFields();
+
+// Guesses the order a slot was written in from the player indices of its clubs, which are either
+// -1 or a valid index into GAMEnC.
+ByteOrder detect(const gameb &clubs);
+
+// Swaps every multi-byte field in place, so applying it twice gives back the input.
+void swap(gamea &data);
+void swap(gameb &data);
+void swap(gamec &data);
+
+// Converts a slot read straight from disk to native order and returns the order it was stored in.
+ByteOrder toNative(gamea &gameA, gameb &gameB, gamec &gameC);
+
+} // namespace byte_order
@@ -0,0 +1,205 @@
+// Columnar binary snapshots of parsed tables, keyed by a hash of the source they came from, so a
+// rerun over unchanged input can map the snapshot instead of parsing the source again.
+#include "column_cache.h"
+
+#include <cstring>
+#include <limits>
+#include <system_error>
+
+#include "save_commit.h"
+
+namespace column_cache {
+namespace {
+// Eight bytes that also tell a snapshot from another byte order.
+constexpr std::uint64_t kMagic = 0x3148434143334d50ULL; // "PM3CACH1" in little-endian order
+
+// Laid out in this order: header, counts, text offsets, numbers, text bytes.
+struct Header {
+    std::uint64_t magic;
+    std::uint64_t keyHigh;
+    std::uint64_t keyLow;
+    std::uint64_t rows;
+    std::uint64_t numberColumns;
+    std::uint64_t textColumns;
+    std::uint64_t countColumns;
+    std::uint64_t textSize;
+};
+
+std::uint64_t rotate(std::uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+std::uint64_t finish(std::uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDULL;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+void append(std::vector<char> &out, const void *data, std::size_t size) {
+    const char *bytes = static_cast<const char *>(data);
+    out.insert(out.end(), bytes, bytes + size);
+}
+} // namespace
+
+Key makeKey(std::string_view content, std::string_view schema) {
+    constexpr std::uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+    constexpr std::uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+    std::uint64_t lanes[4] = {kPrime1, kPrime2, ~kPrime1, ~kPrime2};
+    auto step = [&](std::uint64_t &lane, std::uint64_t word) {
+        lane = rotate(lane + word * kPrime2, 31) * kPrime1;
+    };
+
+    const char *data = content.data();
+    std::size_t size = content.size();
+    std::size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        std::uint64_t words[4];
+        std::memcpy(words, data + i, sizeof(words));
+        for (int lane = 0; lane < 4; ++lane) {
+            step(lanes[lane], words[lane]);
+        }
+    }
+    for (; i < size; ++i) {
+        step(lanes[i % 4], static_cast<unsigned char>(data[i]) + 1);
+    }
+
+    // FNV-1a over the schema, kept apart from the content so the two can never run together.
+    std::uint64_t fnv = 1469598103934665603ULL;
+    for (char c : schema) {
+        fnv = (fnv ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+    }
+
+    Key key;
+    key.high = finish(rotate(lanes[0], 1) + rotate(lanes[1], 7) + rotate(lanes[2], 12) + rotate(lanes[3], 18) +
+                      size);
+    key.low = finish(lanes[0] ^ rotate(lanes[1], 17) ^ rotate(lanes[2], 29) ^ rotate(lanes[3], 41) ^ fnv);
+    key.high ^= finish(fnv + size);
+    return key;
+}
+
+bool write(const std::filesystem::path &path, const Key &key, const Table &table) {
+    std::vector<std::uint32_t> offsets;
+    offsets.reserve(table.texts.size() * (table.rows + 1));
+    std::uint64_t textSize = 0;
+    for (const auto &column : table.texts) {
+        if (column.size() != table.rows) {
+            return false;
+        }
+        offsets.push_back(static_cast<std::uint32_t>(textSize));
+        for (const std::string &value : column) {
+            textSize += value.size();
+            if (textSize > std::numeric_limits<std::uint32_t>::max()) {
+                return false;
+            }
+            offsets.push_back(static_cast<std::uint32_t>(textSize));
+        }
+    }
+    for (const auto &column : table.numbers) {
+        if (column.size() != table.rows) {
+            return false;
+        }
+    }
+
+    Header header{kMagic, key.high, key.low, table.rows, table.numbers.size(), table.texts.size(),
+                  table.counts.size(), textSize};
+    std::vector<char> out;
+    out.reserve(sizeof(header) + table.counts.size() * 8 + offsets.size() * 4 +
+                table.numbers.size() * table.rows * 4 + textSize);
+    append(out, &header, sizeof(header));
+    append(out, table.counts.data(), table.counts.size() * sizeof(std::uint64_t));
+    append(out, offsets.data(), offsets.size() * sizeof(std::uint32_t));
+    for (const auto &column : table.numbers) {
+        append(out, column.data(), column.size() * sizeof(std::int32_t));
+    }
+    for (const auto &column : table.texts) {
+        for (const std::string &value : column) {
+            append(out, value.data(), value.size());
+        }
+    }
+
+    std::filesystem::path temp = path;
+    temp += ".tmp";
+    if (!io::writeFileDurable(temp, out.data(), out.size())) {
+        return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
+
+bool Snapshot::open(const std::filesystem::path &path, const Key &key, std::size_t numberColumns,
+                    std::size_t textColumns, std::size_t countColumns) {
+    rowCount = 0;
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(path, ec)) {
+        return false;
+    }
+    try {
+        file = io::MappedFile(path);
+    } catch (const std::exception &) {
+        return false;
+    }
+
+    Header header{};
+    if (file.size() < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (header.magic != kMagic || header.keyHigh != key.high || header.keyLow != key.low ||
+        header.numberColumns != numberColumns || header.textColumns != textColumns ||
+        header.countColumns != countColumns) {
+        return false;
+    }
+    // Bounded so the size sum below cannot overflow.
+    if (header.rows > std::numeric_limits<std::uint32_t>::max() ||
+        header.textSize > std::numeric_limits<std::uint32_t>::max()) {
+        return false;
+    }
+    std::uint64_t expected = sizeof(header) + countColumns * 8 + textColumns * (header.rows + 1) * 4 +
+                             numberColumns * header.rows * 4 + header.textSize;
+    if (expected != file.size()) {
+        return false;
+    }
+
+    const std::uint8_t *at = file.data() + sizeof(header);
+    counts = reinterpret_cast<const std::uint64_t *>(at);
+    at += countColumns * 8;
+    offsets = reinterpret_cast<const std::uint32_t *>(at);
+    at += textColumns * (header.rows + 1) * 4;
+    numbers = reinterpret_cast<const std::int32_t *>(at);
+    at += numberColumns * header.rows * 4;
+    textBytes = reinterpret_cast<const char *>(at);
+
+    // Offsets must rise through each column and stay inside the text, so text() needs no checks.
+    std::uint32_t previous = 0;
+    for (std::size_t i = 0; i < textColumns * (header.rows + 1); ++i) {
+        if (offsets[i] < previous || offsets[i] > header.textSize) {
+            return false;
+        }
+        previous = offsets[i];
+    }
+    rowCount = static_cast<std::size_t>(header.rows);
+    return true;
+}
+
+std::uint64_t Snapshot::count(std::size_t index) const {
+    return counts[index];
+}
+
+std::int32_t Snapshot::number(std::size_t column, std::size_t row) const {
+    return numbers[column * rowCount + row];
+}
+
+std::string_view Snapshot::text(std::size_t column, std::size_t row) const {
+    const std::uint32_t *columnOffsets = offsets + column * (rowCount + 1);
+    return {textBytes + columnOffsets[row], columnOffsets[row + 1] - columnOffsets[row]};
+}
+
+} // namespace column_cache
@@ -0,0 +1,61 @@
+// Columnar binary snapshots of parsed tables, keyed by a hash of the source they came from, so a
+// rerun over unchanged input can map the snapshot instead of parsing the source again.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "save_view.h"
+
+namespace column_cache {
+
+struct Key {
+    std::uint64_t high = 0;
+    std::uint64_t low = 0;
+
+    bool operator==(const Key &other) const { return high == other.high && low == other.low; }
+    bool operator!=(const Key &other) const { return !(*this == other); }
+};
+
+// 128-bit hash of the source bytes and a schema string naming the writer's version and columns.
+// Reads eight bytes per step on four independent lanes. Not cryptographic.
+Key makeKey(std::string_view content, std::string_view schema);
+
+// A table to write: integer and text columns of `rows` entries each, plus whole-table counts.
+struct Table {
+    std::size_t rows = 0;
+    std::vector<std::vector<std::int32_t>> numbers;
+    std::vector<std::vector<std::string>> texts;
+    std::vector<std::uint64_t> counts;
+};
+
+// Writes the snapshot to a temporary file and renames it over `path`. False on any I/O error or
+// when a column does not hold `rows` entries.
+bool write(const std::filesystem::path &path, const Key &key, const Table &table);
+
+// A snapshot read back in place from a mapped file.
+class Snapshot {
+public:
+    // False when the file is missing, truncated, written by another layout, or under another key.
+    bool open(const std::filesystem::path &path, const Key &key, std::size_t numberColumns,
+              std::size_t textColumns, std::size_t countColumns);
+
+    std::size_t rows() const { return rowCount; }
+    std::uint64_t count(std::size_t index) const;
+    std::int32_t number(std::size_t column, std::size_t row) const;
+    std::string_view text(std::size_t column, std::size_t row) const;
+
+private:
+    io::MappedFile file;
+    std::size_t rowCount = 0;
+    const std::uint64_t *counts = nullptr;
+    const std::uint32_t *offsets = nullptr; // rows + 1 per text column
+    const std::int32_t *numbers = nullptr;  // rows per number column
+    const char *textBytes = nullptr;
+};
+
+} // namespace column_cache
@@ -46,3 +46,7 @@ inline constexpr const char *SHORT_FONT_PATH = "assets/unscii-8.ttf";
 // Prefs/save locations
 inline constexpr const char *PREFS_PATH = "PM3000.PREFS";
 inline constexpr const char *BACKUP_SAVE_PATH = "PM3000";
+inline constexpr int BACKUP_HISTORY_GENERATIONS = 32;
+inline constexpr const char *COMMIT_JOURNAL_PATH = "PM3000.JOURNAL";
+inline constexpr const char *PATCH_UNDO_LOG_PATH = "PM3000.UNDO";
+inline constexpr const char *CHECKSUM_SIDECAR_SUFFIX = ".SUM";
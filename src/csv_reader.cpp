@@ -0,0 +1,314 @@
+// Zero-copy CSV reading over a mapped file: a SIMD scan for the structural characters, rows split
+// into field offsets, chunks of whole rows for parsing on several threads, and column plans
+// resolved once from the header.
+#include "csv_reader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define PM3_CSV_READER_X86 1
+#endif
+
+namespace csv_reader {
+namespace {
+constexpr std::size_t kWindow = 64 * 1024;
+
+// Quote, comma and newline bits of 64 bytes, bit i for byte i.
+struct Masks {
+    std::uint64_t quote;
+    std::uint64_t comma;
+    std::uint64_t newline;
+};
+
+// Bit i set when an odd number of quote bits are set at or below i: the bytes inside quotes
+// (with the opening quote, without the closing one). Shifts rather than a carry-less multiply, so
+// it needs no instruction beyond SSE2.
+std::uint64_t prefixXor(std::uint64_t bits) {
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+// Appends the structural offsets of one 64-byte step at `base` and carries the quote state.
+void emitStructure(const Masks &masks, std::uint32_t base, bool &inQuotes, std::vector<std::uint32_t> &offsets,
+                   std::size_t &count) {
+    std::uint64_t inside = prefixXor(masks.quote) ^ (inQuotes ? ~std::uint64_t{0} : 0);
+    inQuotes = (inside >> 63) != 0;
+    std::uint64_t structural = masks.quote | ((masks.comma | masks.newline) & ~inside);
+    if (offsets.size() < count + 64) {
+        offsets.resize(std::max(offsets.size() * 2, count + 64));
+    }
+    while (structural != 0) {
+        offsets[count++] = base + static_cast<std::uint32_t>(__builtin_ctzll(structural));
+        structural &= structural - 1;
+    }
+}
+
+void scanScalar(std::string_view block, std::size_t first, bool &inQuotes, std::vector<std::uint32_t> &offsets,
+                std::size_t &count) {
+    for (std::size_t i = first; i < block.size(); ++i) {
+        char c = block[i];
+        if (c == '"') {
+            inQuotes = !inQuotes;
+        } else if (inQuotes || (c != ',' && c != '\n')) {
+            continue;
+        }
+        if (offsets.size() <= count) {
+            offsets.resize(std::max(offsets.size() * 2, count + 64));
+        }
+        offsets[count++] = static_cast<std::uint32_t>(i);
+    }
+}
+
+#if defined(PM3_CSV_READER_X86)
+std::size_t scanSse2(std::string_view block, bool &inQuotes, std::vector<std::uint32_t> &offsets,
+                     std::size_t &count) {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i newline = _mm_set1_epi8('\n');
+    std::size_t i = 0;
+    for (; i + 64 <= block.size(); i += 64) {
+        Masks masks{};
+        for (int part = 0; part < 4; ++part) {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block.data() + i + part * 16));
+            int shift = part * 16;
+            masks.quote |= static_cast<std::uint64_t>(
+                                   static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, quote))))
+                           << shift;
+            masks.comma |= static_cast<std::uint64_t>(
+                                   static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, comma))))
+                           << shift;
+            masks.newline |= static_cast<std::uint64_t>(
+                                     static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, newline))))
+                             << shift;
+        }
+        emitStructure(masks, static_cast<std::uint32_t>(i), inQuotes, offsets, count);
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) std::size_t scanAvx2(std::string_view block, bool &inQuotes,
+                                                     std::vector<std::uint32_t> &offsets, std::size_t &count) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    std::size_t i = 0;
+    for (; i + 64 <= block.size(); i += 64) {
+        Masks masks{};
+        for (int part = 0; part < 2; ++part) {
+            __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block.data() + i + part * 32));
+            int shift = part * 32;
+            masks.quote |= static_cast<std::uint64_t>(
+                                   static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, quote))))
+                           << shift;
+            masks.comma |= static_cast<std::uint64_t>(
+                                   static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, comma))))
+                           << shift;
+            masks.newline |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(
+                                     _mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, newline))))
+                             << shift;
+        }
+        emitStructure(masks, static_cast<std::uint32_t>(i), inQuotes, offsets, count);
+    }
+    return i;
+}
+#endif
+} // namespace
+
+bool kernelSupported(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::Scalar:
+            return true;
+#if defined(PM3_CSV_READER_X86)
+        case Kernel::Sse2:
+            return true;
+        case Kernel::Avx2: {
+            static const bool supported = __builtin_cpu_supports("avx2");
+            return supported;
+        }
+#endif
+        default:
+            return false;
+    }
+}
+
+Kernel bestKernel() {
+    if (kernelSupported(Kernel::Avx2)) {
+        return Kernel::Avx2;
+    }
+    return kernelSupported(Kernel::Sse2) ? Kernel::Sse2 : Kernel::Scalar;
+}
+
+void scanStructure(std::string_view block, bool &inQuotes, std::vector<std::uint32_t> &offsets, Kernel kernel) {
+    if (!kernelSupported(kernel)) {
+        kernel = Kernel::Scalar;
+    }
+    std::size_t count = 0;
+    std::size_t done = 0;
+#if defined(PM3_CSV_READER_X86)
+    if (kernel == Kernel::Avx2) {
+        done = scanAvx2(block, inQuotes, offsets, count);
+    } else if (kernel == Kernel::Sse2) {
+        done = scanSse2(block, inQuotes, offsets, count);
+    }
+#endif
+    scanScalar(block, done, inQuotes, offsets, count);
+    offsets.resize(count);
+}
+
+std::string_view Row::raw(std::size_t index) const {
+    if (index >= fields.size()) {
+        return {};
+    }
+    const Field &f = fields[index];
+    return text.substr(f.begin, f.end - f.begin);
+}
+
+std::string_view Row::field(std::size_t index, std::string &scratch) const {
+    std::string_view value = raw(index);
+    if (index >= fields.size() || !fields[index].quoted) {
+        return value;
+    }
+
+    scratch.clear();
+    bool inQuotes = false;
+    for (std::size_t i = 0; i < value.size(); ++i) {
+        char c = value[i];
+        if (c != '"') {
+            scratch.push_back(c);
+        } else if (inQuotes && i + 1 < value.size() && value[i + 1] == '"') {
+            scratch.push_back('"');
+            ++i;
+        } else {
+            inQuotes = !inQuotes;
+        }
+    }
+    return scratch;
+}
+
+std::size_t RowReader::scanWindow() {
+    while (windowEnd != text.size()) {
+        windowBegin = windowEnd;
+        windowEnd = std::min(windowBegin + kWindow, text.size());
+        scanStructure(text.substr(windowBegin, windowEnd - windowBegin), inQuotes, structure, kernel);
+        if (!structure.empty()) {
+            cursor = 1;
+            return windowBegin + structure[0];
+        }
+    }
+    cursor = structure.size();
+    return text.size();
+}
+
+bool RowReader::next(Row &row) {
+    while (position < text.size()) {
+        std::size_t start = position;
+        row.fields.clear();
+
+        // Only quotes and the commas and newlines outside quotes come back from the scan.
+        bool quoted = false;
+        std::size_t fieldStart = start;
+        std::size_t end = text.size();
+        for (std::size_t i = nextStructural(); i < text.size(); i = nextStructural()) {
+            char c = text[i];
+            if (c == '"') {
+                quoted = true;
+            } else if (c == ',') {
+                row.fields.push_back({static_cast<std::uint32_t>(fieldStart - start),
+                                      static_cast<std::uint32_t>(i - start), quoted});
+                fieldStart = i + 1;
+                quoted = false;
+            } else {
+                end = i;
+                break;
+            }
+        }
+        position = end < text.size() ? end + 1 : end;
+
+        std::size_t lineEnd = end;
+        if (lineEnd > fieldStart && text[lineEnd - 1] == '\r') {
+            --lineEnd;
+        }
+        if (lineEnd == start) {
+            continue;
+        }
+        row.fields.push_back({static_cast<std::uint32_t>(fieldStart - start),
+                              static_cast<std::uint32_t>(lineEnd - start), quoted});
+        row.text = text.substr(start, lineEnd - start);
+        return true;
+    }
+    return false;
+}
+
+std::vector<std::string_view> splitChunks(std::string_view text, std::size_t count) {
+    std::vector<std::string_view> chunks;
+    count = std::max<std::size_t>(count, 1);
+    std::size_t begin = 0;
+    bool inQuotes = false; // at `scanned`
+    std::size_t scanned = 0;
+    for (std::size_t piece = 1; piece <= count && begin < text.size(); ++piece) {
+        std::size_t target = piece == count ? text.size() : std::max(text.size() / count * piece, begin);
+        if (target < text.size()) {
+            inQuotes ^= std::count(text.begin() + static_cast<std::ptrdiff_t>(scanned),
+                                   text.begin() + static_cast<std::ptrdiff_t>(target), '"') % 2 != 0;
+            scanned = target;
+            while (scanned < text.size() && (inQuotes || text[scanned] != '\n')) {
+                inQuotes ^= text[scanned] == '"';
+                ++scanned;
+            }
+            target = std::min(scanned + 1, text.size());
+            scanned = target;
+        }
+        chunks.push_back(text.substr(begin, target - begin));
+        begin = target;
+    }
+    return chunks;
+}
+
+void forEachChunk(const std::vector<std::string_view> &chunks, unsigned threads,
+                  const std::function<void(std::size_t, std::string_view)> &parse) {
+    if (chunks.empty()) {
+        return;
+    }
+    threads = threads != 0 ? threads : std::thread::hardware_concurrency();
+    threads = std::clamp(threads, 1u, static_cast<unsigned>(chunks.size()));
+
+    std::atomic<std::size_t> nextChunk{0};
+    auto work = [&] {
+        for (std::size_t index = nextChunk++; index < chunks.size(); index = nextChunk++) {
+            parse(index, chunks[index]);
+        }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (unsigned i = 1; i < threads; ++i) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+std::vector<std::size_t> resolveColumns(const Row &header, const std::vector<std::string_view> &names) {
+    std::vector<std::size_t> columns(names.size(), kMissingColumn);
+    std::string scratch;
+    for (std::size_t column = 0; column < header.size(); ++column) {
+        std::string_view name = header.field(column, scratch);
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            if (columns[i] == kMissingColumn && names[i] == name) {
+                columns[i] = column;
+            }
+        }
+    }
+    return columns;
+}
+
+} // namespace csv_reader
@@ -0,0 +1,100 @@
+// Zero-copy CSV reading over a mapped file: a SIMD scan for the structural characters, rows split
+// into field offsets, chunks of whole rows for parsing on several threads, and column plans
+// resolved once from the header.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace csv_reader {
+
+enum class Kernel {
+    Scalar,
+    Sse2,
+    Avx2,
+};
+
+// The fastest kernel this CPU runs.
+Kernel bestKernel();
+bool kernelSupported(Kernel kernel);
+
+// The structural characters of `block` as offsets into it, in order: every quote, and every comma
+// and newline outside quotes. `inQuotes` is the quote state before the block and is left at the
+// state after it. `offsets` is cleared first, so one buffer can serve every block. Every kernel
+// gives the same offsets; the SIMD ones take 64 bytes per step.
+void scanStructure(std::string_view block, bool &inQuotes, std::vector<std::uint32_t> &offsets,
+                   Kernel kernel = bestKernel());
+
+// One row, as offsets into the text it was read from. Fields keep their quotes until field()
+// takes them out, so a row without quoted fields never copies a byte.
+class Row {
+public:
+    std::size_t size() const { return fields.size(); }
+    std::string_view line() const { return text; }
+
+    // The field as the file has it, quotes and all. Empty past the end of the row.
+    std::string_view raw(std::size_t index) const;
+    // The field's value: a quote switches quoting on or off and "" inside quotes is a quote.
+    // Quoted fields are unescaped into `scratch`, which the result may point into.
+    std::string_view field(std::size_t index, std::string &scratch) const;
+
+private:
+    friend class RowReader;
+
+    struct Field {
+        std::uint32_t begin;
+        std::uint32_t end;
+        bool quoted;
+    };
+
+    std::string_view text;
+    std::vector<Field> fields;
+};
+
+// Reads rows one after another, scanning the text a window at a time. A newline inside quotes
+// belongs to the row, a trailing \r is dropped, and empty rows are skipped.
+class RowReader {
+public:
+    explicit RowReader(std::string_view text, Kernel kernel = bestKernel()) : text(text), kernel(kernel) {}
+
+    bool next(Row &row);
+    // Bytes consumed so far.
+    std::size_t offset() const { return position; }
+
+private:
+    // The offset of the next structural character not read yet, or text.size() at the end.
+    std::size_t nextStructural() {
+        return cursor != structure.size() ? windowBegin + structure[cursor++] : scanWindow();
+    }
+    // Scans windows until one holds a structural character and returns its first.
+    std::size_t scanWindow();
+
+    std::string_view text;
+    Kernel kernel;
+    std::size_t position = 0;
+    std::size_t windowBegin = 0;
+    std::size_t windowEnd = 0;
+    bool inQuotes = false; // at windowEnd
+    std::vector<std::uint32_t> structure;
+    std::size_t cursor = 0;
+};
+
+// `text` cut into at most `count` pieces of whole rows, in order. Cuts are only made at
+// newlines outside quotes, found from the parity of the quotes before each cut.
+std::vector<std::string_view> splitChunks(std::string_view text, std::size_t count);
+
+// Runs `parse(index, chunk)` for every chunk on a pool of threads (0 uses every hardware
+// thread). Each chunk is parsed by one thread.
+void forEachChunk(const std::vector<std::string_view> &chunks, unsigned threads,
+                  const std::function<void(std::size_t, std::string_view)> &parse);
+
+inline constexpr std::size_t kMissingColumn = static_cast<std::size_t>(-1);
+
+// For each name, its column in the header, or kMissingColumn.
+std::vector<std::size_t> resolveColumns(const Row &header, const std::vector<std::string_view> &names);
+
+} // namespace csv_reader
@@ -0,0 +1,175 @@
+// Record-level change tracking for the in-memory save (gameData/clubData/playerData).
+#include "dirty_tracker.h"
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+
+#include "undo_journal.h"
+
+namespace dirty_tracker {
+namespace {
+std::bitset<kGameDataBlocks> gGameBlocks;
+std::bitset<kClubIdxMax> gClubs;
+std::bitset<kPlayerCount> gPlayers;
+std::uint64_t gGeneration = 1;
+// Generation of the last mark per record, and of the last time the whole state was replaced.
+std::array<std::uint64_t, kClubIdxMax> gClubGenerations{};
+std::array<std::uint64_t, kPlayerCount> gPlayerGenerations{};
+std::uint64_t gWholeGeneration = 1;
+
+template <std::size_t N>
+std::vector<ByteRange> toRanges(const std::bitset<N> &bits, std::size_t recordSize, std::size_t totalSize) {
+    std::vector<ByteRange> ranges;
+    for (std::size_t i = 0; i < N; ++i) {
+        if (!bits.test(i)) {
+            continue;
+        }
+        std::size_t offset = i * recordSize;
+        std::size_t size = std::min(recordSize, totalSize - offset);
+        if (!ranges.empty() && ranges.back().offset + ranges.back().size == offset) {
+            ranges.back().size += size;
+        } else {
+            ranges.push_back({offset, size});
+        }
+    }
+    return ranges;
+}
+} // namespace
+
+void markPlayer(int16_t idx) {
+    if (idx >= 0 && idx < kPlayerCount) {
+        undo_journal::capture('C', idx * sizeof(PlayerRecord), sizeof(PlayerRecord));
+        ++gGeneration;
+        gPlayers.set(static_cast<std::size_t>(idx));
+        gPlayerGenerations[idx] = gGeneration;
+    }
+}
+
+void markPlayer(const PlayerRecord &player) {
+    const PlayerRecord *first = playerData.player;
+    if (&player >= first && &player < first + kPlayerCount) {
+        markPlayer(static_cast<int16_t>(&player - first));
+    }
+}
+
+void markClub(int idx) {
+    if (idx >= 0 && idx < kClubIdxMax) {
+        undo_journal::capture('B', idx * sizeof(ClubRecord), sizeof(ClubRecord));
+        ++gGeneration;
+        gClubs.set(static_cast<std::size_t>(idx));
+        gClubGenerations[idx] = gGeneration;
+    }
+}
+
+void markClub(const ClubRecord &club) {
+    const ClubRecord *first = clubData.club;
+    if (&club >= first && &club < first + kClubIdxMax) {
+        markClub(static_cast<int>(&club - first));
+    }
+}
+
+void markGameData(const void *field, std::size_t size) {
+    const auto *base = reinterpret_cast<const uint8_t *>(&gameData);
+    const auto *start = static_cast<const uint8_t *>(field);
+    if (start < base || start >= base + sizeof(gamea) || size == 0) {
+        return;
+    }
+    std::size_t offset = static_cast<std::size_t>(start - base);
+    undo_journal::capture('A', offset, size);
+    markRange('A', offset, size);
+}
+
+void markRange(char gameLetter, std::size_t offset, std::size_t size) {
+    if (size == 0) {
+        return;
+    }
+    ++gGeneration;
+    std::size_t last = offset + size - 1;
+    switch (gameLetter) {
+        case 'A':
+            for (std::size_t block = offset / kGameDataBlockSize;
+                 block <= last / kGameDataBlockSize && block < kGameDataBlocks; ++block) {
+                gGameBlocks.set(block);
+            }
+            break;
+        case 'B':
+            for (std::size_t club = offset / sizeof(ClubRecord);
+                 club <= last / sizeof(ClubRecord) && club < static_cast<std::size_t>(kClubIdxMax); ++club) {
+                gClubs.set(club);
+                gClubGenerations[club] = gGeneration;
+            }
+            break;
+        case 'C':
+            for (std::size_t player = offset / sizeof(PlayerRecord);
+                 player <= last / sizeof(PlayerRecord) && player < static_cast<std::size_t>(kPlayerCount); ++player) {
+                gPlayers.set(player);
+                gPlayerGenerations[player] = gGeneration;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void markAll() {
+    undo_journal::capture('A', 0, sizeof(gamea));
+    undo_journal::capture('B', 0, sizeof(gameb));
+    undo_journal::capture('C', 0, sizeof(gamec));
+    ++gGeneration;
+    gWholeGeneration = gGeneration;
+    gGameBlocks.set();
+    gClubs.set();
+    gPlayers.set();
+}
+
+void clear() {
+    ++gGeneration;
+    gWholeGeneration = gGeneration;
+    gGameBlocks.reset();
+    gClubs.reset();
+    gPlayers.reset();
+}
+
+std::uint64_t generation() {
+    return gGeneration;
+}
+
+std::uint64_t clubGeneration(int idx) {
+    bool valid = idx >= 0 && idx < kClubIdxMax;
+    return valid ? std::max(gClubGenerations[idx], gWholeGeneration) : gGeneration;
+}
+
+std::uint64_t playerGeneration(int16_t idx) {
+    bool valid = idx >= 0 && idx < kPlayerCount;
+    return valid ? std::max(gPlayerGenerations[idx], gWholeGeneration) : gGeneration;
+}
+
+bool any() {
+    return gGameBlocks.any() || gClubs.any() || gPlayers.any();
+}
+
+std::vector<ByteRange> dirtyRanges(char gameLetter) {
+    switch (gameLetter) {
+        case 'A':
+            return toRanges(gGameBlocks, kGameDataBlockSize, sizeof(gamea));
+        case 'B':
+            return toRanges(gClubs, sizeof(ClubRecord), sizeof(gameb));
+        case 'C':
+            return toRanges(gPlayers, sizeof(PlayerRecord), sizeof(gamec));
+        default:
+            return {};
+    }
+}
+
+std::size_t dirtyBytes() {
+    std::size_t total = 0;
+    for (char letter : {'A', 'B', 'C'}) {
+        for (const auto &range : dirtyRanges(letter)) {
+            total += range.size;
+        }
+    }
+    return total;
+}
+
+} // namespace dirty_tracker
@@ -0,0 +1,52 @@
+// Record-level change tracking for the in-memory save (gameData/clubData/playerData).
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "pm3_data.h"
+
+namespace dirty_tracker {
+
+// gamea is one big record, so it is tracked in fixed-size blocks.
+inline constexpr std::size_t kGameDataBlockSize = 256;
+inline constexpr std::size_t kGameDataBlocks = (sizeof(gamea) + kGameDataBlockSize - 1) / kGameDataBlockSize;
+inline constexpr int kPlayerCount = static_cast<int>(sizeof(gamec) / sizeof(PlayerRecord));
+
+struct ByteRange {
+    std::size_t offset;
+    std::size_t size;
+};
+
+// Call these before mutating a record of the global save state. Indices out of range and
+// references to records that are not part of the globals (local copies) are ignored.
+void markPlayer(int16_t idx);
+void markPlayer(const PlayerRecord &player);
+void markClub(int idx);
+void markClub(const ClubRecord &club);
+void markGameData(const void *field, std::size_t size);
+// Marks a byte range of GAMEnA/B/C without recording it for undo (used when undo restores pages).
+void markRange(char gameLetter, std::size_t offset, std::size_t size);
+
+// Everything changed, e.g. the globals were replaced by something other than the loaded slot.
+void markAll();
+// The globals match what is on disk again (after a load or a save).
+void clear();
+
+// Bumped by every mark call and by clear(), so it changes whenever the globals may have. Caches
+// derived from the save compare against it. Marks come before the edit they announce, so nothing
+// should be cached between the two.
+std::uint64_t generation();
+// The generation of the last mark of one record, or of the last clear()/markAll() if that came
+// later. A cache of that record built at generation `g` is still current while this is <= g.
+// Out-of-range indices report generation().
+std::uint64_t clubGeneration(int idx);
+std::uint64_t playerGeneration(int16_t idx);
+
+bool any();
+// Merged, sorted byte ranges of the changed records in GAMEnA/B/C ('A', 'B' or 'C').
+std::vector<ByteRange> dirtyRanges(char gameLetter);
+std::size_t dirtyBytes();
+
+} // namespace dirty_tracker
@@ -0,0 +1,103 @@
+// Change notification for a single folder (inotify on Linux, directory mtime elsewhere).
+#include "folder_watch.h"
+
+#include <system_error>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace io {
+
+FolderWatch::FolderWatch(const std::filesystem::path &folder) : watchedFolder(folder) {
+    std::error_code ec;
+    lastWriteTime = std::filesystem::last_write_time(folder, ec);
+#ifdef __linux__
+    notifyFd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (notifyFd != -1) {
+        const uint32_t mask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_MODIFY | IN_CLOSE_WRITE |
+                              IN_DELETE_SELF | IN_MOVE_SELF;
+        if (::inotify_add_watch(notifyFd, folder.c_str(), mask) == -1) {
+            ::close(notifyFd);
+            notifyFd = -1;
+        }
+    }
+#endif
+}
+
+FolderWatch::~FolderWatch() {
+    release();
+}
+
+FolderWatch::FolderWatch(FolderWatch &&other) noexcept {
+    *this = std::move(other);
+}
+
+FolderWatch &FolderWatch::operator=(FolderWatch &&other) noexcept {
+    if (this != &other) {
+        release();
+        watchedFolder = std::move(other.watchedFolder);
+        notifyFd = std::exchange(other.notifyFd, -1);
+        lastWriteTime = other.lastWriteTime;
+    }
+    return *this;
+}
+
+void FolderWatch::release() {
+#ifdef __linux__
+    if (notifyFd != -1) {
+        ::close(notifyFd);
+    }
+#endif
+    notifyFd = -1;
+}
+
+bool FolderWatch::poll(std::vector<FolderEvent> *events) {
+    if (watchedFolder.empty()) {
+        return false;
+    }
+
+#ifdef __linux__
+    if (notifyFd != -1) {
+        bool changed = false;
+        alignas(struct inotify_event) char buffer[4096];
+        for (;;) {
+            ssize_t length = ::read(notifyFd, buffer, sizeof(buffer));
+            if (length <= 0) {
+                break;
+            }
+            for (ssize_t offset = 0; offset < length;) {
+                const auto *event = reinterpret_cast<const struct inotify_event *>(buffer + offset);
+                offset += static_cast<ssize_t>(sizeof(struct inotify_event) + event->len);
+                if (event->mask & IN_IGNORED) {
+                    continue;
+                }
+                changed = true;
+                if (events != nullptr) {
+                    FolderEvent folderEvent;
+                    folderEvent.name = event->len > 0 ? std::string(event->name) : std::string();
+                    folderEvent.written = (event->mask & IN_CLOSE_WRITE) != 0;
+                    folderEvent.removed = (event->mask & (IN_DELETE | IN_MOVED_FROM)) != 0;
+                    events->push_back(std::move(folderEvent));
+                }
+            }
+        }
+        return changed;
+    }
+#endif
+
+    std::error_code ec;
+    auto writeTime = std::filesystem::last_write_time(watchedFolder, ec);
+    if (writeTime == lastWriteTime) {
+        return false;
+    }
+    lastWriteTime = writeTime;
+    if (events != nullptr) {
+        events->push_back({});
+    }
+    return true;
+}
+
+} // namespace io
@@ -0,0 +1,45 @@
+// Change notification for a single folder (inotify on Linux, directory mtime elsewhere).
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace io {
+
+struct FolderEvent {
+    std::string name;     // entry inside the folder; empty if the folder itself or the queue changed
+    bool written = false; // a writer closed the file (its contents are complete)
+    bool removed = false; // deleted or renamed away
+};
+
+class FolderWatch {
+public:
+    FolderWatch() = default;
+    explicit FolderWatch(const std::filesystem::path &folder);
+    ~FolderWatch();
+
+    FolderWatch(const FolderWatch &) = delete;
+    FolderWatch &operator=(const FolderWatch &) = delete;
+    FolderWatch(FolderWatch &&other) noexcept;
+    FolderWatch &operator=(FolderWatch &&other) noexcept;
+
+    const std::filesystem::path &folder() const { return watchedFolder; }
+    // Descriptor to wait on with poll()/select(), or -1 in the mtime fallback.
+    int fd() const { return notifyFd; }
+
+    // Non-blocking. Returns true if anything in the folder was created, removed, renamed or
+    // written since the last call, and appends what is known about it to `events`. Without
+    // inotify only a change of the folder itself can be reported (one event with an empty name).
+    bool poll(std::vector<FolderEvent> *events = nullptr);
+
+private:
+    void release();
+
+    std::filesystem::path watchedFolder;
+    int notifyFd = -1;
+    std::filesystem::file_time_type lastWriteTime{};
+};
+
+} // namespace io
@@ -6,58 +6,19 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "dirty_tracker.h"
 #include "pm3_data.h"
 #include "io.h"
+#include "player_attributes.h"
+#include "player_identity.h"
+#include "roster_index.h"
 
-static double computeRoleRating(char role, const PlayerRecord &p) {
-    auto clamp = [](double v) { return std::clamp(v, 0.0, 99.0); };
-    double rating = 0.0;
-    switch (role) {
-        case 'G': { // Keeper: handling heavy, heading/control secondary, some tackling/passing
-            rating = 0.50 * p.hn +
-                     0.15 * p.hd +
-                     0.15 * p.cr +
-                     0.10 * p.tk +
-                     0.05 * p.ps +
-                     0.05 * p.sh;
-            break;
-        }
-        case 'D': { // Defender: tackling first, then passing, heading, control; aggression helps slightly
-            rating = 0.40 * p.tk +
-                     0.15 * p.ps +
-                     0.15 * p.hd +
-                     0.15 * p.cr +
-                     0.05 * p.sh +
-                     0.10 * p.aggr;
-            break;
-        }
-        case 'M': { // Midfielder: passing primary, then tackling/shooting, control/heading, aggression minor
-            rating = 0.35 * p.ps +
-                     0.20 * p.tk +
-                     0.15 * p.sh +
-                     0.10 * p.hd +
-                     0.10 * p.cr +
-                     0.10 * p.aggr;
-            break;
-        }
-        default: { // Attacker: shooting primary, then passing/heading, control, minor tackling/aggression
-            rating = 0.35 * p.sh +
-                     0.20 * p.ps +
-                     0.15 * p.hd +
-                     0.10 * p.cr +
-                     0.10 * p.tk +
-                     0.10 * p.aggr;
-            break;
-        }
-    }
-    return clamp(rating);
-}
-
-char determinePlayerType(PlayerRecord &p) {
+char determinePlayerType(const PlayerRecord &p) {
     if (p.hn > p.tk && p.hn > p.ps && p.hn > p.sh) {
         return 'G';
     } else if (p.tk > p.hn && p.tk > p.ps && p.tk > p.sh) {
@@ -69,7 +30,7 @@ char determinePlayerType(PlayerRecord &p) {
     return 'A';
 }
 
-uint8_t determinePlayerRating(PlayerRecord &p) {
+uint8_t determinePlayerRating(const PlayerRecord &p) {
     if (p.hn > p.tk && p.hn > p.ps && p.hn > p.sh) {
         return p.hn;
     } else if (p.tk > p.hn && p.tk > p.ps && p.tk > p.sh) {
@@ -82,22 +43,21 @@ uint8_t determinePlayerRating(PlayerRecord &p) {
 }
 
 char determineValuationRole(const PlayerRecord &p) {
-    double gk = computeRoleRating('G', p);
-    double def = computeRoleRating('D', p);
-    double mid = computeRoleRating('M', p);
-    double att = computeRoleRating('A', p);
+    return player_attributes::valuationRole(player_attributes::roleRating('G', p), player_attributes::roleRating('D', p),
+                                            player_attributes::roleRating('M', p), player_attributes::roleRating('A', p));
+}
 
-    if (gk >= def && gk >= mid && gk >= att) {
-        return 'G';
-    } else if (def >= mid && def >= att) {
-        return 'D';
-    } else if (mid >= att) {
-        return 'M';
-    }
-    return 'A';
+ValuationRating determineValuationRating(const PlayerRecord &p) {
+    char role = determineValuationRole(p);
+    return {role, player_attributes::roleRating(role, p)};
+}
+
+ValuationRating valuationRating(const player_attributes::RoleRatings &ratings, int16_t playerIdx) {
+    char role = ratings.role[playerIdx];
+    return {role, ratings.rating[player_attributes::roleIndex(role)][playerIdx]};
 }
 
-static int normalizedLeagueTier(const ClubRecord &club) {
+int normalizedLeagueTier(const ClubRecord &club) {
     // Handles both 0-based tier (0..4) and legacy hex division codes.
     switch (club.league) {
         case 0:
@@ -120,8 +80,18 @@ static int normalizedLeagueTier(const ClubRecord &club) {
 }
 
 int determinePlayerPrice(const PlayerRecord &player, const ClubRecord &club, int squadSlot) {
-    char valuationRole = determineValuationRole(player);
-    int rating = static_cast<int>(std::lround(computeRoleRating(valuationRole, player)));
+    return determinePlayerPrice(player, club, squadSlot, squadSummary(club));
+}
+
+int determinePlayerPrice(const PlayerRecord &player, const ClubRecord &club, int squadSlot,
+                         const SquadSummary &summary) {
+    return determinePlayerPrice(player, club, squadSlot, summary, determineValuationRating(player));
+}
+
+int determinePlayerPrice(const PlayerRecord &player, const ClubRecord &club, int squadSlot,
+                         const SquadSummary &summary, const ValuationRating &valuation) {
+    char valuationRole = valuation.role;
+    int rating = static_cast<int>(std::lround(valuation.rating));
     int age = player.age;
 
     double ageFactor = 1.0;
@@ -143,7 +113,7 @@ int determinePlayerPrice(const PlayerRecord &player, const ClubRecord &club, int
     double baseValue = static_cast<double>(rating) * static_cast<double>(rating) * 1200.0;
 
     // Importance based on relative quality in the squad.
-    int importance = determinePlayerImportance(player, club);
+    int importance = determinePlayerImportance(player, summary);
     double importanceFactor = 1.0;
     switch (importance) {
         case 4: importanceFactor = 1.6; break;
@@ -198,31 +168,85 @@ int determinePlayerPrice(const PlayerRecord &player, const ClubRecord &club, int
     return static_cast<int>(std::max<double>(value, wageInfluence));
 }
 
-int determinePlayerImportance(const PlayerRecord &player, const ClubRecord &club) {
-    PlayerRecord &mutablePlayer = const_cast<PlayerRecord &>(player);
-    char playerType = determinePlayerType(mutablePlayer);
-    int rating = determinePlayerRating(mutablePlayer);
+int determineAskingPrice(const PlayerRecord &player, const ClubRecord &club, int squadSlot,
+                         const SquadSummary &summary) {
+    return determineAskingPrice(player, club, squadSlot, summary, determineValuationRating(player));
+}
+
+int determineAskingPrice(const PlayerRecord &player, const ClubRecord &club, int squadSlot,
+                         const SquadSummary &summary, const ValuationRating &valuation) {
+    int basePrice = determinePlayerPrice(player, club, squadSlot, summary, valuation);
+    int importance = std::max(determinePlayerImportance(player, summary), 1);
+    return static_cast<int>(basePrice * (1.0 + (importance - 1) * 0.15));
+}
 
-    int bestOverall = 0;
-    int bestInRole = 0;
-    int squadSize = 0;
+SquadSummary summarizeSquad(const ClubRecord &club) {
+    return summarizeSquad(club, playerData);
+}
 
+SquadSummary summarizeSquad(const ClubRecord &club, const gamec &players) {
+    SquadSummary summary;
     for (int slot = 0; slot < 24; ++slot) {
         int16_t idx = club.player_index[slot];
         if (idx == -1) {
             continue;
         }
-        ++squadSize;
+        ++summary.squadSize;
 
-        PlayerRecord &clubPlayer = getPlayer(idx);
+        PlayerRecord clubPlayer = players.player[idx];
         int clubRating = determinePlayerRating(clubPlayer);
-        bestOverall = std::max(bestOverall, clubRating);
+        int role = player_attributes::roleIndex(determinePlayerType(clubPlayer));
+        summary.bestOverall = std::max(summary.bestOverall, clubRating);
+        summary.bestInRole[role] = std::max(summary.bestInRole[role], clubRating);
+        ++summary.roleCounts[role];
+    }
+    return summary;
+}
 
-        if (determinePlayerType(clubPlayer) == playerType) {
-            bestInRole = std::max(bestInRole, clubRating);
-        }
+SquadSummary squadSummary(const ClubRecord &club) {
+    struct CachedSummary {
+        std::uint64_t generation = 0;
+        SquadSummary summary;
+    };
+    static std::array<CachedSummary, kClubIdxMax> cache;
+
+    const ClubRecord *first = clubData.club;
+    if (&club < first || &club >= first + kClubIdxMax) {
+        return summarizeSquad(club);
+    }
+    int clubIdx = static_cast<int>(&club - first);
+    CachedSummary &cached = cache[clubIdx];
+    std::uint64_t generation = dirty_tracker::generation();
+    if (cached.generation == generation) {
+        return cached.summary;
     }
 
+    // Only edits to this club or to one of its players make the summary stale. An unchanged
+    // club record means an unchanged squad, so the players checked are the ones summarized.
+    bool current = cached.generation != 0 && dirty_tracker::clubGeneration(clubIdx) <= cached.generation;
+    for (int slot = 0; slot < 24 && current; ++slot) {
+        int16_t idx = club.player_index[slot];
+        current = idx == -1 || dirty_tracker::playerGeneration(idx) <= cached.generation;
+    }
+    if (!current) {
+        cached.summary = summarizeSquad(club);
+    }
+    cached.generation = generation;
+    return cached.summary;
+}
+
+int determinePlayerImportance(const PlayerRecord &player, const ClubRecord &club) {
+    return determinePlayerImportance(player, squadSummary(club));
+}
+
+int determinePlayerImportance(const PlayerRecord &player, const SquadSummary &summary) {
+    char playerType = determinePlayerType(player);
+    int rating = determinePlayerRating(player);
+
+    int bestOverall = summary.bestOverall;
+    int bestInRole = summary.bestInRole[player_attributes::roleIndex(playerType)];
+    int squadSize = summary.squadSize;
+
     int importance = 1;
     if (rating >= bestOverall - 2) {
         importance = 3;
@@ -244,6 +268,9 @@ int determinePlayerImportance(const PlayerRecord &player, const ClubRecord &club
 void changeClub(int16_t newClubIdx, const std::filesystem::path &gamePath, int player) {
     gamea::ManagerRecord &manager = gameData.manager[player];
     int oldClubIdx = manager.club_idx;
+    dirty_tracker::markGameData(&manager, sizeof(manager));
+    dirty_tracker::markClub(newClubIdx);
+    dirty_tracker::markClub(oldClubIdx);
     manager.club_idx = newClubIdx;
 
     auto fillSafety = [&](int value) {
@@ -405,8 +432,8 @@ void changeClub(int16_t newClubIdx, const std::filesystem::path &gamePath, int p
     std::strncpy(clubData.club[oldClubIdx].manager, defaultClubData.club[oldClubIdx].manager, 16);
 }
 
-std::vector<club_player> findFreePlayers() {
-    std::vector<club_player> freePlayers;
+std::vector<PlayerRow> findFreePlayers() {
+    std::vector<PlayerRow> freePlayers;
 
     for (int clubIdx = 0; clubIdx < 114; ++clubIdx) {
         ClubRecord &club = getClub(clubIdx);
@@ -421,30 +448,31 @@ std::vector<club_player> findFreePlayers() {
                 continue;
             }
 
-            freePlayers.push_back({club, player});
+            freePlayers.push_back({static_cast<int16_t>(clubIdx), playerIdx});
         }
     }
     return freePlayers;
 }
 
-std::vector<club_player> getMyPlayers(int player) {
-    std::vector<club_player> myPlayers;
+std::vector<PlayerRow> getMyPlayers(int player) {
+    std::vector<PlayerRow> myPlayers;
 
-    ClubRecord &club = getClub(gameData.manager[player].club_idx);
+    int16_t clubIdx = gameData.manager[player].club_idx;
+    ClubRecord &club = getClub(clubIdx);
     for (int i = 0; i < 24; ++i) {
         int16_t playerIdx = club.player_index[i];
         if (playerIdx == -1) {
             continue;
         }
 
-        PlayerRecord &p = playerData.player[playerIdx];
-        myPlayers.push_back({club, p});
+        myPlayers.push_back({clubIdx, playerIdx});
     }
     return myPlayers;
 }
 
 void levelAggression() {
     for (int16_t i = 0; i < 3932; ++i) {
+        dirty_tracker::markPlayer(i);
         PlayerRecord &player = getPlayer(i);
         player.aggr = 5;
     }
@@ -452,7 +480,7 @@ void levelAggression() {
 
 namespace game_utils {
 
-OfferResponse assessOffer(const club_player &playerInfo, int offerAmount, int currentGame) {
+OfferResponse assessOffer(const PlayerSelection &selection, int offerAmount, int currentGame) {
     OfferResponse result{false, ""};
 
     if (offerAmount <= 0) {
@@ -465,13 +493,14 @@ OfferResponse assessOffer(const club_player &playerInfo, int offerAmount, int cu
         return result;
     }
 
-    int16_t playerIdx = findPlayerIndex(playerInfo.player);
+    int16_t playerIdx = resolvePlayer(selection);
     if (playerIdx == -1) {
         snprintf(result.message, sizeof(result.message), "Player not found in save");
         return result;
     }
 
-    int fromClubIdx = findClubIndexForPlayer(playerIdx);
+    roster_index::Placement placement = roster_index::find(playerIdx);
+    int fromClubIdx = placement.club;
     if (fromClubIdx == -1) {
         snprintf(result.message, sizeof(result.message), "Unable to locate player's club");
         return result;
@@ -483,21 +512,9 @@ OfferResponse assessOffer(const club_player &playerInfo, int offerAmount, int cu
         return result;
     }
 
-    int squadSlot = -1;
-    const ClubRecord &sourceClub = playerInfo.club;
-    for (int i = 0; i < 24; ++i) {
-        if (sourceClub.player_index[i] == -1) {
-            continue;
-        }
-        if (std::memcmp(&playerData.player[sourceClub.player_index[i]], &playerInfo.player, sizeof(PlayerRecord)) == 0) {
-            squadSlot = i;
-            break;
-        }
-    }
-
-    int basePrice = determinePlayerPrice(playerInfo.player, playerInfo.club, squadSlot);
-    int importance = std::max(determinePlayerImportance(playerInfo.player, playerInfo.club), 1);
-    int askingPrice = static_cast<int>(basePrice * (1.0 + (importance - 1) * 0.15));
+    const PlayerRecord &player = getPlayer(playerIdx);
+    const ClubRecord &sourceClub = getClub(fromClubIdx);
+    int askingPrice = determineAskingPrice(player, sourceClub, placement.slot, squadSummary(sourceClub));
 
     if (offerAmount < askingPrice) {
         std::string priceText = formatCurrency(askingPrice);
@@ -513,25 +530,25 @@ OfferResponse assessOffer(const club_player &playerInfo, int offerAmount, int cu
 
     completeTransfer(playerIdx, fromClubIdx, myClubIdx, offerAmount);
 
-    snprintf(result.message, sizeof(result.message), "Offer accepted - %12.12s signed", playerInfo.player.name);
+    snprintf(result.message, sizeof(result.message), "Offer accepted - %12.12s signed", player.name);
     result.accepted = true;
     return result;
 }
 
-void beginOffer(InputHandler &input, char *footer, size_t footerSize, const club_player &playerInfo, int currentGame) {
+void beginOffer(InputHandler &input, char *footer, size_t footerSize, const PlayerSelection &selection, int currentGame) {
     input.resetKeyPressCallbacks();
-    input.startReadingTextInput([&input, footer, footerSize, playerInfo] {
+    input.startReadingTextInput([&input, footer, footerSize, selection] {
         const char *buffer = input.getTextInput();
         std::string formattedAmount = std::strlen(buffer) ? formatCurrency(std::atoi(buffer)) : "..........";
         snprintf(footer, footerSize, "           Offer amount for %12.12s £%13.13s",
-                 playerInfo.player.name, formattedAmount.c_str());
+                 selection.snapshot.name, formattedAmount.c_str());
     });
 
-    snprintf(footer, footerSize, "           Offer amount for %12.12s £..........", playerInfo.player.name);
+    snprintf(footer, footerSize, "           Offer amount for %12.12s £..........", selection.snapshot.name);
 
-    input.addKeyPressCallback(SDLK_RETURN, [&input, footer, footerSize, playerInfo, currentGame] {
+    input.addKeyPressCallback(SDLK_RETURN, [&input, footer, footerSize, selection, currentGame] {
         int offer = std::atoi(input.getTextInput());
-        auto response = assessOffer(playerInfo, offer, currentGame);
+        auto response = assessOffer(selection, offer, currentGame);
         snprintf(footer, footerSize, "           %.58s", response.message);
         input.resetKeyPressCallbacks();
         input.endReadingTextInput();
@@ -539,26 +556,35 @@ void beginOffer(InputHandler &input, char *footer, size_t footerSize, const club
 }
 
 int16_t findPlayerIndex(const PlayerRecord &player) {
-    for (int16_t idx = 0; idx < 3932; ++idx) {
-        if (std::memcmp(&getPlayer(idx), &player, sizeof(PlayerRecord)) == 0) {
-            return idx;
-        }
-    }
+    const PlayerRecord *first = playerData.player;
+    if (&player >= first && &player < first + 3932) {
+        return static_cast<int16_t>(&player - first);
+    }
+    // Built once per generation rather than per lookup: two hash maps over every record.
+    static std::unique_ptr<player_identity::IdentityMap> identities;
+    static std::uint64_t generation = 0;
+    if (!identities || generation != dirty_tracker::generation()) {
+        identities = std::make_unique<player_identity::IdentityMap>(playerData);
+        generation = dirty_tracker::generation();
+    }
+    return identities->find(player);
+}
 
-    return -1;
+PlayerSelection selectPlayer(const PlayerRow &row) {
+    return {player_identity::handleFor(row.player), getPlayer(row.player)};
 }
 
-int findClubIndexForPlayer(int16_t playerIdx) {
-    for (int clubIdx = 0; clubIdx < 114; ++clubIdx) {
-        ClubRecord &club = getClub(clubIdx);
-        for (int slot = 0; slot < 24; ++slot) {
-            if (club.player_index[slot] == playerIdx) {
-                return clubIdx;
-            }
-        }
+int16_t resolvePlayer(const PlayerSelection &selection) {
+    int16_t idx = player_identity::resolve(selection.handle);
+    if (idx != -1) {
+        return idx;
     }
+    // The save changed under the handle (reload, undo); find the same player again.
+    return findPlayerIndex(selection.snapshot);
+}
 
-    return -1;
+int findClubIndexForPlayer(int16_t playerIdx) {
+    return roster_index::find(playerIdx).club;
 }
 
 int findEmptySlot(ClubRecord &club) {
@@ -573,12 +599,13 @@ int findEmptySlot(ClubRecord &club) {
 void completeTransfer(int16_t playerIdx, int fromClubIdx, int toClubIdx, int offerAmount) {
     ClubRecord &fromClub = getClub(fromClubIdx);
     ClubRecord &toClub = getClub(toClubIdx);
+    dirty_tracker::markClub(fromClubIdx);
+    dirty_tracker::markClub(toClubIdx);
+    dirty_tracker::markPlayer(playerIdx);
 
-    for (int slot = 0; slot < 24; ++slot) {
-        if (fromClub.player_index[slot] == playerIdx) {
-            fromClub.player_index[slot] = -1;
-            break;
-        }
+    roster_index::Placement placement = roster_index::find(playerIdx);
+    if (placement.club == fromClubIdx) {
+        roster_index::setSlot(fromClubIdx, placement.slot, -1);
     }
 
     int destSlot = findEmptySlot(toClub);
@@ -586,8 +613,9 @@ void completeTransfer(int16_t playerIdx, int fromClubIdx, int toClubIdx, int off
     toClub.bank_account -= offerAmount;
 
     if (destSlot != -1) {
-        toClub.player_index[destSlot] = playerIdx;
+        roster_index::setSlot(toClubIdx, destSlot, playerIdx);
     }
+    roster_index::check("a transfer");
 
     PlayerRecord &player = getPlayer(playerIdx);
     player.contract = std::max<uint8_t>(player.contract, static_cast<uint8_t>(2));
@@ -596,7 +624,8 @@ void completeTransfer(int16_t playerIdx, int fromClubIdx, int toClubIdx, int off
 
 void convertPlayerToCoach(struct gamea::ManagerRecord &manager, ClubRecord &club, int8_t clubPlayerIdx, char *footer,
                           size_t footerSize) {
-    PlayerRecord &player = getPlayer(club.player_index[clubPlayerIdx]);
+    int16_t playerIdx = club.player_index[clubPlayerIdx];
+    PlayerRecord &player = getPlayer(playerIdx);
 
     std::unordered_map<char, int> playerTypeToEmployeePosition = {
             {'G', 8}, {'D', 9}, {'M', 10}, {'A', 11}
@@ -606,6 +635,9 @@ void convertPlayerToCoach(struct gamea::ManagerRecord &manager, ClubRecord &club
     int8_t playerRating = determinePlayerRating(player);
 
     struct gamea::ManagerRecord::employee &employee = manager.employee[playerTypeToEmployeePosition[playerType]];
+    dirty_tracker::markGameData(&employee, sizeof(employee));
+    dirty_tracker::markPlayer(player);
+    dirty_tracker::markClub(club);
     strncpy(employee.name, player.name, 12);
     employee.skill = playerRating;
     employee.age = 0;
@@ -635,11 +667,21 @@ void convertPlayerToCoach(struct gamea::ManagerRecord &manager, ClubRecord &club
     player.u23 = 0;
     player.u25 = 0;
 
-    club.player_index[clubPlayerIdx] = -1;
+    // `club` may be a copy (tests, previews); only a clubData element has an index to update.
+    const ClubRecord *first = clubData.club;
+    if (&club >= first && &club < first + kClubIdxMax) {
+        roster_index::setSlot(static_cast<int>(&club - first), clubPlayerIdx, -1);
+    } else {
+        club.player_index[clubPlayerIdx] = -1;
+    }
+    player_identity::retire(playerIdx);
 
-    ClubRecord &new_club = getClub(92 + (std::rand() % (113 - 92 + 1)));
+    int newClubIdx = 92 + (std::rand() % (113 - 92 + 1));
+    dirty_tracker::markClub(newClubIdx);
 
-    new_club.player_index[23] = clubPlayerIdx;
+    // The record goes into slot 23 of the new club; setSlot unplaces whoever held it.
+    roster_index::setSlot(newClubIdx, 23, playerIdx);
+    roster_index::check("converting a player to a coach");
 
     snprintf(footer, footerSize, "CONVERTED TO A COACH");
 }
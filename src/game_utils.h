@@ -1,15 +1,38 @@
 // Domain/gameplay helpers for transfers and club utilities.
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <filesystem>
 #include <string>
 #include <vector>
 
 #include "input.h"
+#include "player_attributes.h"
 #include "pm3_data.h"
 #include "pm3_defs.hh"
 
+// A player picked from a listing for an offer or loan. The record copy is only used to find the
+// player again if the handle goes stale while the user is still typing (hot reload, undo).
+struct PlayerSelection {
+    PlayerHandle handle;
+    PlayerRecord snapshot;
+};
+
+// What valuation needs to know about a squad, per role in G/D/M/A order.
+struct SquadSummary {
+    int squadSize = 0;
+    int bestOverall = 0;
+    std::array<int, 4> bestInRole{};
+    std::array<int, 4> roleCounts{};
+};
+
+// The role a player is valued in and their rating in it.
+struct ValuationRating {
+    char role = 'A';
+    double rating = 0.0;
+};
+
 struct OfferResponse {
     bool accepted;
     char message[75];
@@ -17,21 +40,48 @@ struct OfferResponse {
 
 ClubRecord& getClub(int idx);
 PlayerRecord& getPlayer(int16_t idx);
-char determinePlayerType(PlayerRecord &player);
-uint8_t determinePlayerRating(PlayerRecord &player);
+char determinePlayerType(const PlayerRecord &player);
+uint8_t determinePlayerRating(const PlayerRecord &player);
 char determineValuationRole(const PlayerRecord &player);
+ValuationRating determineValuationRating(const PlayerRecord &player);
+// The same from a rateRoles pass over the player's save (liveRatings() for playerData), which
+// gives bit-identical ratings without rating the player again.
+ValuationRating valuationRating(const player_attributes::RoleRatings &ratings, int16_t playerIdx);
 int determinePlayerPrice(const PlayerRecord &player, const ClubRecord &club, int squadSlot);
+// 0 = Premier League ... 4 = Conference League, for either encoding of ClubRecord::league.
+int normalizedLeagueTier(const ClubRecord &club);
 int determinePlayerImportance(const PlayerRecord &player, const ClubRecord &club);
-std::vector<club_player> findFreePlayers();
-std::vector<club_player> getMyPlayers(int player);
+// Pricing against a summary the caller provides. These read no globals and no caches, so they
+// are safe to call from several threads over a save that is not changing.
+int determinePlayerPrice(const PlayerRecord &player, const ClubRecord &club, int squadSlot,
+                         const SquadSummary &summary);
+int determinePlayerPrice(const PlayerRecord &player, const ClubRecord &club, int squadSlot,
+                         const SquadSummary &summary, const ValuationRating &valuation);
+int determinePlayerImportance(const PlayerRecord &player, const SquadSummary &summary);
+// What the selling club asks for in an offer: the price, raised for important players.
+int determineAskingPrice(const PlayerRecord &player, const ClubRecord &club, int squadSlot,
+                         const SquadSummary &summary);
+int determineAskingPrice(const PlayerRecord &player, const ClubRecord &club, int squadSlot,
+                         const SquadSummary &summary, const ValuationRating &valuation);
+SquadSummary summarizeSquad(const ClubRecord &club);
+SquadSummary summarizeSquad(const ClubRecord &club, const gamec &players);
+// summarizeSquad, cached per club of clubData until that club or one of its players is marked
+// dirty. Copies of a club are summarized afresh.
+SquadSummary squadSummary(const ClubRecord &club);
+std::vector<PlayerRow> findFreePlayers();
+std::vector<PlayerRow> getMyPlayers(int player);
 void levelAggression();
 void changeClub(int16_t newClubIdx, const std::filesystem::path &gamePath, int player=0);
 
 namespace game_utils {
 
-OfferResponse assessOffer(const club_player &playerInfo, int offerAmount, int currentGame);
-void beginOffer(InputHandler &input, char *footer, size_t footerSize, const club_player &playerInfo, int currentGame);
+OfferResponse assessOffer(const PlayerSelection &selection, int offerAmount, int currentGame);
+void beginOffer(InputHandler &input, char *footer, size_t footerSize, const PlayerSelection &selection, int currentGame);
+// O(1) for records inside playerData; copies are matched by identity (see player_identity.h).
 int16_t findPlayerIndex(const PlayerRecord &player);
+PlayerSelection selectPlayer(const PlayerRow &row);
+// The selected player: the handle if still current, else whoever matches the snapshot's identity.
+int16_t resolvePlayer(const PlayerSelection &selection);
 int findClubIndexForPlayer(int16_t playerIdx);
 int findEmptySlot(ClubRecord &club);
 void completeTransfer(int16_t playerIdx, int fromClubIdx, int toClubIdx, int offerAmount);
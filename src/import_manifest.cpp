@@ -0,0 +1,291 @@
+// What an FC import put where: the clubs it filled and, for every FC player it saw at those clubs,
+// the player record it wrote (if any) and a hash of the row. A later import joins a new export
+// against it by player_id and only touches the players that changed.
+#include "import_manifest.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "save_commit.h"
+
+namespace import_manifest {
+namespace {
+constexpr const char *kManifestHeader = "PM3000 FC IMPORT";
+
+std::filesystem::path stagedPath(const std::filesystem::path &path) {
+    std::filesystem::path temp = path;
+    temp += ".tmp";
+    return temp;
+}
+
+int16_t swapIndex(int16_t raw) {
+    uint16_t u = static_cast<uint16_t>(raw);
+    return static_cast<int16_t>((u >> 8) | (u << 8));
+}
+} // namespace
+
+bool read(const std::filesystem::path &path, Manifest &manifest) {
+    std::ifstream in(path);
+    std::string line;
+    if (!in || !std::getline(in, line) || line != kManifestHeader) {
+        return false;
+    }
+
+    manifest = {};
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string kind;
+        fields >> kind;
+        if (kind == "club") {
+            Club club;
+            fields >> club.index >> std::ws;
+            std::getline(fields, club.name);
+            manifest.clubs.push_back(std::move(club));
+        } else if (kind == "player") {
+            Player player;
+            fields >> player.playerId >> player.record >> player.club >> std::hex >> player.hash;
+            if (!fields) {
+                return false;
+            }
+            manifest.players.push_back(player);
+        }
+    }
+    return true;
+}
+
+bool write(const std::filesystem::path &path, const Manifest &manifest, std::string &error) {
+    return stage(path, manifest, error) && commitStaged(path, error);
+}
+
+bool stage(const std::filesystem::path &path, const Manifest &manifest, std::string &error) {
+    std::string text = std::string(kManifestHeader) + "\n";
+    for (const Club &club : manifest.clubs) {
+        text += "club " + std::to_string(club.index) + " " + club.name + "\n";
+    }
+    for (const Player &player : manifest.players) {
+        char line[96];
+        std::snprintf(line, sizeof(line), "player %" PRId32 " %d %d %016" PRIx64 "\n", player.playerId,
+                      static_cast<int>(player.record), static_cast<int>(player.club), player.hash);
+        text += line;
+    }
+
+    std::filesystem::path temp = stagedPath(path);
+    if (!io::writeFileDurable(temp, text.data(), text.size())) {
+        error = "Failed to write " + temp.string();
+        return false;
+    }
+    return true;
+}
+
+bool commitStaged(const std::filesystem::path &path, std::string &error) {
+    std::error_code ec;
+    std::filesystem::rename(stagedPath(path), path, ec);
+    if (ec) {
+        discardStaged(path);
+        error = "Failed to replace " + path.string();
+        return false;
+    }
+    return true;
+}
+
+void discardStaged(const std::filesystem::path &path) {
+    std::error_code ec;
+    std::filesystem::remove(stagedPath(path), ec);
+}
+
+std::vector<Difference> diff(const std::vector<Player> &previous, const std::vector<Row> &rows) {
+    std::unordered_map<int32_t, std::size_t> byId;
+    byId.reserve(previous.size());
+    for (std::size_t i = 0; i < previous.size(); ++i) {
+        byId.emplace(previous[i].playerId, i);
+    }
+
+    std::vector<Difference> changes;
+    std::vector<bool> seen(previous.size(), false);
+    std::unordered_set<int32_t> rowIds;
+    rowIds.reserve(rows.size());
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        const Row &row = rows[i];
+        if (!rowIds.insert(row.playerId).second) {
+            continue;
+        }
+        auto it = byId.find(row.playerId);
+        if (it == byId.end()) {
+            if (row.club >= 0) {
+                changes.push_back({Change::Added, kNone, i});
+            }
+            continue;
+        }
+        const Player &before = previous[it->second];
+        if (row.club < 0) {
+            continue; // left the known clubs: a removal, below
+        }
+        seen[it->second] = true;
+        if (row.club != before.club) {
+            changes.push_back({Change::ClubChanged, it->second, i});
+        } else if (row.hash != before.hash) {
+            changes.push_back({Change::AttributesChanged, it->second, i});
+        }
+    }
+    for (std::size_t i = 0; i < previous.size(); ++i) {
+        if (!seen[i] && byId[previous[i].playerId] == i) {
+            changes.push_back({Change::Removed, i, kNone});
+        }
+    }
+    return changes;
+}
+
+ApplyStats apply(Manifest &manifest, const std::vector<Row> &rows, const std::vector<Difference> &changes,
+                 gameb &clubs, gamec &players, const Hooks &hooks) {
+    constexpr std::size_t kCapacity = std::extent_v<decltype(players.player)>;
+
+    // Where each record sits now; the game may have moved players since the last import.
+    std::vector<int16_t> recordClub(kCapacity, -1);
+    for (int clubIdx = 0; clubIdx < kClubIdxMax; ++clubIdx) {
+        for (int slot = 0; slot < 24; ++slot) {
+            int16_t idx = swapIndex(clubs.club[clubIdx].player_index[slot]);
+            if (idx >= 0 && static_cast<std::size_t>(idx) < kCapacity && recordClub[idx] < 0) {
+                recordClub[idx] = static_cast<int16_t>(clubIdx);
+            }
+        }
+    }
+    std::vector<bool> used(kCapacity, false);
+    for (std::size_t i = 0; i < kCapacity; ++i) {
+        used[i] = recordClub[i] >= 0;
+    }
+    for (const Player &player : manifest.players) {
+        if (player.record >= 0 && static_cast<std::size_t>(player.record) < kCapacity) {
+            used[player.record] = true;
+        }
+    }
+
+    auto leaveSquad = [&](int16_t record) {
+        int clubIdx = recordClub[record];
+        if (clubIdx < 0) {
+            return;
+        }
+        ClubRecord &club = clubs.club[clubIdx];
+        int16_t squad[24];
+        int kept = 0;
+        for (int slot = 0; slot < 24; ++slot) {
+            int16_t idx = swapIndex(club.player_index[slot]);
+            if (idx >= 0 && idx != record) {
+                squad[kept++] = club.player_index[slot];
+            }
+        }
+        for (int slot = 0; slot < 24; ++slot) {
+            club.player_index[slot] = slot < kept ? squad[slot] : int16_t{-1};
+        }
+        recordClub[record] = -1;
+    };
+    auto joinSquad = [&](int16_t clubIdx, int16_t record) {
+        ClubRecord &club = clubs.club[clubIdx];
+        std::size_t filled = 0;
+        while (filled < 24 && club.player_index[filled] != -1) {
+            ++filled;
+        }
+        if (filled >= kSquadSize) {
+            return false;
+        }
+        club.player_index[filled] = swapIndex(record);
+        recordClub[record] = clubIdx;
+        return true;
+    };
+    // A record that no squad holds any more goes back to the pool, blank, so a later player
+    // never starts from the old one's bytes.
+    auto release = [&](int16_t record) {
+        if (recordClub[record] < 0) {
+            players.player[record] = PlayerRecord{};
+            used[record] = false;
+        }
+    };
+    auto place = [&](std::size_t row, int16_t clubIdx) -> int16_t {
+        int16_t record = -1;
+        for (std::size_t i = 0; i < kCapacity && record < 0; ++i) {
+            if (!used[i]) {
+                record = static_cast<int16_t>(i);
+            }
+        }
+        if (record < 0) {
+            return -1;
+        }
+        PlayerRecord built = hooks.build(row, clubs.club[clubIdx], players);
+        if (!joinSquad(clubIdx, record)) {
+            return -1;
+        }
+        used[record] = true;
+        players.player[record] = built;
+        return record;
+    };
+
+    ApplyStats stats;
+    std::vector<bool> removed(manifest.players.size(), false);
+    for (const Difference &difference : changes) {
+        const Row *row = difference.current != kNone ? &rows[difference.current] : nullptr;
+        switch (difference.change) {
+            case Change::Added: {
+                int16_t record = place(difference.current, row->club);
+                stats.benched += record < 0 ? 1 : 0;
+                manifest.players.push_back({row->playerId, record, row->club, row->hash});
+                ++stats.added;
+                break;
+            }
+            case Change::Removed: {
+                Player &player = manifest.players[difference.previous];
+                if (player.record >= 0) {
+                    leaveSquad(player.record);
+                    release(player.record);
+                }
+                removed[difference.previous] = true;
+                ++stats.removed;
+                break;
+            }
+            case Change::AttributesChanged: {
+                Player &player = manifest.players[difference.previous];
+                if (player.record >= 0) {
+                    hooks.refresh(players.player[player.record], difference.current);
+                }
+                player.hash = row->hash;
+                ++stats.attributesChanged;
+                break;
+            }
+            case Change::ClubChanged: {
+                Player &player = manifest.players[difference.previous];
+                if (player.record >= 0) {
+                    leaveSquad(player.record);
+                    if (player.hash != row->hash) {
+                        hooks.refresh(players.player[player.record], difference.current);
+                    }
+                    if (!joinSquad(row->club, player.record)) {
+                        release(player.record);
+                        player.record = -1;
+                    }
+                } else {
+                    player.record = place(difference.current, row->club);
+                }
+                stats.benched += player.record < 0 ? 1 : 0;
+                player.club = row->club;
+                player.hash = row->hash;
+                ++stats.clubChanged;
+                break;
+            }
+        }
+    }
+
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < manifest.players.size(); ++i) {
+        if (i >= removed.size() || !removed[i]) {
+            manifest.players[kept++] = manifest.players[i];
+        }
+    }
+    manifest.players.resize(kept);
+    return stats;
+}
+
+} // namespace import_manifest
@@ -0,0 +1,95 @@
+// What an FC import put where: the clubs it filled and, for every FC player it saw at those clubs,
+// the player record it wrote (if any) and a hash of the row. A later import joins a new export
+// against it by player_id and only touches the players that changed.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "pm3_defs.hh"
+
+namespace import_manifest {
+
+struct Club {
+    int16_t index = -1; // into gameb::club
+    std::string name;   // the export's club name, normalized
+};
+
+struct Player {
+    int32_t playerId = 0;
+    int16_t record = -1; // into gamec::player; -1 when the player did not make the squad
+    int16_t club = -1;
+    uint64_t hash = 0; // of the row's player attributes, club columns excluded
+};
+
+struct Manifest {
+    std::vector<Club> clubs;
+    std::vector<Player> players;
+};
+
+// False when the file is missing or is not a manifest.
+bool read(const std::filesystem::path &path, Manifest &manifest);
+bool write(const std::filesystem::path &path, const Manifest &manifest, std::string &error);
+// write() in two steps, so the manifest can be staged before the save it describes and only
+// replace the old one once that save went through.
+bool stage(const std::filesystem::path &path, const Manifest &manifest, std::string &error);
+bool commitStaged(const std::filesystem::path &path, std::string &error);
+void discardStaged(const std::filesystem::path &path);
+
+// One row of the new export, with its club already resolved through Manifest::clubs (-1 when the
+// club is not one the import filled).
+struct Row {
+    int32_t playerId = 0;
+    int16_t club = -1;
+    uint64_t hash = 0;
+};
+
+enum class Change {
+    Added,             // not in the manifest, at a known club
+    Removed,           // in the manifest, gone from the export or from the known clubs
+    AttributesChanged, // same club, different hash
+    ClubChanged,       // another known club; the hash may have changed too
+};
+
+inline constexpr std::size_t kNone = static_cast<std::size_t>(-1);
+
+struct Difference {
+    Change change;
+    std::size_t previous = kNone; // into Manifest::players
+    std::size_t current = kNone;  // into the rows
+};
+
+// Hash join of `rows` against `previous` on player_id. Unchanged players are left out. Rows come
+// first, in their order, then the removals in manifest order. A player_id repeated in the rows
+// only counts the first time.
+std::vector<Difference> diff(const std::vector<Player> &previous, const std::vector<Row> &rows);
+
+// What only the importer knows: the record of a new player and the refreshed attributes of an
+// existing one, both from the row at the given index.
+struct Hooks {
+    // `club` is the squad the player joins, for telling the name apart from teammates'.
+    std::function<PlayerRecord(std::size_t row, const ClubRecord &club, const gamec &players)> build;
+    std::function<void(PlayerRecord &record, std::size_t row)> refresh;
+};
+
+struct ApplyStats {
+    std::size_t added = 0;
+    std::size_t removed = 0;
+    std::size_t attributesChanged = 0;
+    std::size_t clubChanged = 0;
+    std::size_t benched = 0; // no squad place or no free player record
+};
+
+inline constexpr std::size_t kSquadSize = 16; // as many as a full import places
+
+// Applies `changes` from diff() to the squads and player records, and brings `manifest` in line
+// with `rows`. Squad slots hold byte-swapped player indices, as the FC import writes them, and
+// stay packed from slot 0. Records freed by a removal are cleared before they are used again.
+ApplyStats apply(Manifest &manifest, const std::vector<Row> &rows, const std::vector<Difference> &changes,
+                 gameb &clubs, gamec &players, const Hooks &hooks);
+
+} // namespace import_manifest
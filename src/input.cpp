@@ -70,7 +70,7 @@ void InputHandler::checkKeyPressCallback(SDL_Keycode key) {
     }
 }
 
-void InputHandler::startReadingTextInput(std::function<void(void)> callback) {
+void InputHandler::startReadingTextInput(std::function<void(void)> callback, TextInputMode mode) {
     addKeyPressCallback(SDLK_ESCAPE, [this] {
         resetKeyPressCallbacks();
         endReadingTextInput();
@@ -79,6 +79,7 @@ void InputHandler::startReadingTextInput(std::function<void(void)> callback) {
     textInput[0] = '\0';
     SDL_StartTextInput();
     readingTextInput = true;
+    textInputMode = mode;
     textInputCallback = std::move(callback);
 }
 
@@ -112,15 +113,25 @@ bool InputHandler::handleTextInputEvent(const SDL_Event &event) {
         return true;
     }
 
+    // A name is typed with letter keys, which must not also reach the shortcuts (Q quits).
+    if (textInputMode == TextInputMode::Name && event.type == SDL_KEYDOWN &&
+        event.key.keysym.sym >= SDLK_SPACE && event.key.keysym.sym < 127 &&
+        (event.key.keysym.mod & KMOD_CTRL) == 0) {
+        return true;
+    }
+
     if (event.type == SDL_TEXTINPUT) {
         const char *incomingText = event.text.text;
         size_t incomingLen = strlen(incomingText);
         size_t currentLen = strlen(textInput);
-        bool numeric = std::all_of(incomingText, incomingText + incomingLen, [](unsigned char c) {
-            return std::isdigit(c);
+        bool accepted = std::all_of(incomingText, incomingText + incomingLen, [this](unsigned char c) {
+            if (textInputMode == TextInputMode::Name) {
+                return std::isalnum(c) || c == ' ' || c == '.' || c == '-' || c == '\'';
+            }
+            return std::isdigit(c) != 0;
         });
 
-        if (numeric && (currentLen + incomingLen) < sizeof(textInput)) {
+        if (accepted && (currentLen + incomingLen) < sizeof(textInput)) {
             strcat(textInput, incomingText);
             if (textInputCallback) {
                 textInputCallback();
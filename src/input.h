@@ -9,6 +9,12 @@
 
 #include "gfx.h"
 
+// What startReadingTextInput accepts: digits for amounts, or the characters of a name.
+enum class TextInputMode {
+    Digits,
+    Name,
+};
+
 enum class ClickableAreaType {
     Persistent,
     Transient,
@@ -26,7 +32,7 @@ public:
     void resetKeyPressCallbacks();
     void checkKeyPressCallback(SDL_Keycode key);
 
-    void startReadingTextInput(std::function<void(void)> callback);
+    void startReadingTextInput(std::function<void(void)> callback, TextInputMode mode = TextInputMode::Digits);
     void endReadingTextInput();
     bool isReadingTextInput() const;
     const char *getTextInput() const;
@@ -44,6 +50,7 @@ private:
     std::unordered_map<SDL_Keycode, std::function<void(void)>> keyPressCallbacks;
 
     bool readingTextInput = false;
+    TextInputMode textInputMode = TextInputMode::Digits;
     char textInput[13]{};
     std::function<void(void)> textInputCallback;
 };
@@ -1,6 +1,7 @@
 // IO/persistence helpers for saves, metadata, and prefs.
 #include "io.h"
 
+#include <algorithm>
 #include <array>
 #include <string_view>
 #include <cstdio>
@@ -8,6 +9,7 @@
 #include <fstream>
 #include <iostream>
 #include <iterator>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -15,24 +17,89 @@
 
 #include "nfd.h"
 #include "config/constants.h"
+#include "backup_store.h"
+#include "byte_order.h"
+#include "dirty_tracker.h"
 #include "input.h"
 #include "pm3_data.h"
+#include "player_identity.h"
+#include "pm3_installation.h"
+#include "save_bundle.h"
+#include "save_commit.h"
+#include "save_delta.h"
+#include "save_view.h"
+#include "roster_index.h"
+#include "save_watcher.h"
+#include "slot_cache.h"
+#include "undo_journal.h"
 
 static std::string gPm3LastError;
 static std::vector<uint8_t> gGameaTail;
 static std::size_t gGameaExtraBytes = 0;
 
+// On-disk state of the slot the globals were last loaded from or saved to. Delta saves are only
+// safe while the slot files still match it, i.e. nothing else (PM3 itself) rewrote them.
+struct SlotBaseline {
+    int gameNumber = 0;
+    std::filesystem::path gamePath;
+    std::array<std::filesystem::file_time_type, 3> writeTimes{};
+    std::array<std::uintmax_t, 3> sizes{};
+    std::string checksums; // the GAMEn.SUM the loaded files should have
+};
+static SlotBaseline gSlotBaseline;
+// Order the loaded slot is stored in on disk; the globals always hold it in native order.
+static byte_order::ByteOrder gSlotByteOrder = byte_order::kNative;
+// Slot files written by someone else (PM3 under DOSBox) that are waiting to be reloaded.
+struct HotReloadState {
+    io::SaveWatcher watcher;
+    int gameNumber = 0;
+    std::bitset<3> files;
+    bool heldReported = false;
+};
+static HotReloadState gHotReload;
+// SAVES.DIR and PREFS as they were when last read into savesDir/preferences. PM3 rewrites them in
+// place, which the folder watch does not always notice, so the files themselves are compared.
+struct MetadataStamp {
+    std::filesystem::path savesFolder; // empty until they were read
+    std::array<std::filesystem::file_time_type, 2> writeTimes{};
+    std::array<std::uintmax_t, 2> sizes{};
+
+    bool operator==(const MetadataStamp &other) const {
+        return savesFolder == other.savesFolder && writeTimes == other.writeTimes && sizes == other.sizes;
+    }
+    bool operator!=(const MetadataStamp &other) const { return !(*this == other); }
+};
+static MetadataStamp gMetadataStamp;
+
+// Copies up to sizeof(T) bytes; a short file leaves the rest of `data` as it was, a longer one
+// has its tail ignored. An empty file fails like a missing one.
 template <typename T>
 static bool load_binary_file(const std::filesystem::path &filepath, T &data) {
-    std::ifstream file(filepath, std::ios::binary);
-    if (!file) {
+    io::MappedFile file;
+    try {
+        file = io::MappedFile(filepath);
+    } catch (const std::runtime_error &) {
         gPm3LastError = "Missing file: " + filepath.string();
         return false;
     }
-    file.read(reinterpret_cast<char*>(&data), sizeof(T));
+    if (file.empty()) {
+        gPm3LastError = "Empty file: " + filepath.string();
+        return false;
+    }
+    std::memcpy(&data, file.data(), std::min(file.size(), sizeof(T)));
     return true;
 }
 
+// The GAMEn.SUM text for a slot's three files as they are on disk.
+static std::string slot_checksums(int game_nr, const gamea &game_data, const gameb &club_data, const gamec &player_data) {
+    std::string prefix = std::string{kGameFilePrefix} + std::to_string(game_nr);
+    return io::formatChecksumSidecar({
+            {prefix + 'A', sizeof(gamea), io::checksum(&game_data, sizeof(gamea))},
+            {prefix + 'B', sizeof(gameb), io::checksum(&club_data, sizeof(gameb))},
+            {prefix + 'C', sizeof(gamec), io::checksum(&player_data, sizeof(gamec))},
+    });
+}
+
 template <typename T>
 static void save_binary_file(const std::filesystem::path &filepath, const T &data) {
     std::ofstream file(filepath, std::ios::binary);
@@ -44,6 +111,9 @@ static void save_binary_file(const std::filesystem::path &filepath, const T &dat
 
 namespace io {
 
+// Each file is privately mapped and copied into the structs, which the editor then changes in
+// place. Sizes are not checked here: callers that need exact sizes (loadGame) check them first,
+// and the tools accept slots with a short or padded file as they always have.
 void loadBinaries(int game_nr, const std::filesystem::path &game_path, gamea &game_data, gameb &club_data, gamec &player_data) {
     if (!load_binary_file(constructSaveFilePath(game_path, game_nr, 'A'), game_data) ||
         !load_binary_file(constructSaveFilePath(game_path, game_nr, 'B'), club_data) ||
@@ -55,20 +125,21 @@ void loadBinaries(int game_nr, const std::filesystem::path &game_path, gamea &ga
 void loadDefaultGamedata(const std::filesystem::path &game_path, gamea &game_data) {
     gGameaTail.clear();
     std::filesystem::path path = constructGameFilePath(game_path, std::string{kGameDataFile});
-    std::ifstream file(path, std::ios::binary);
-    if (!file) {
+    MappedFile file;
+    try {
+        file = MappedFile(path);
+    } catch (const std::runtime_error &) {
         gPm3LastError = "Missing file: " + path.string();
         throw std::runtime_error(gPm3LastError);
     }
-    std::vector<char> buf((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-    if (buf.size() < sizeof(gamea)) {
+    if (file.size() < sizeof(gamea)) {
         gPm3LastError = "File too small: " + path.string();
         throw std::runtime_error(gPm3LastError);
     }
-    std::memcpy(&game_data, buf.data(), sizeof(gamea));
-    if (buf.size() > sizeof(gamea)) {
-        gGameaTail.assign(buf.begin() + static_cast<std::ptrdiff_t>(sizeof(gamea)), buf.end());
-        gGameaExtraBytes = buf.size() - sizeof(gamea);
+    std::memcpy(&game_data, file.data(), sizeof(gamea));
+    if (file.size() > sizeof(gamea)) {
+        gGameaTail.assign(file.data() + sizeof(gamea), file.data() + file.size());
+        gGameaExtraBytes = file.size() - sizeof(gamea);
     } else {
         gGameaExtraBytes = 0;
     }
@@ -128,6 +199,14 @@ void saveBinaries(int game_nr, const std::filesystem::path &game_path, gamea &ga
     save_binary_file(constructSaveFilePath(game_path, game_nr, 'A'), game_data);
     save_binary_file(constructSaveFilePath(game_path, game_nr, 'B'), club_data);
     save_binary_file(constructSaveFilePath(game_path, game_nr, 'C'), player_data);
+
+    // The editor only patches a slot in place while its sidecar still matches what it loaded, so a
+    // stale one is never left behind.
+    std::string checksums = slot_checksums(game_nr, game_data, club_data, player_data);
+    std::filesystem::path sidecar = constructChecksumSidecarPath(game_path, game_nr);
+    if (!writeFileDurable(sidecar, checksums.data(), checksums.size())) {
+        throw std::runtime_error("Could not write file: " + sidecar.string());
+    }
 }
 
 void saveDefaultClubdata(const std::filesystem::path &game_path, const gameb &club_data) {
@@ -157,17 +236,21 @@ void updateMetadata(int game_nr, const std::filesystem::path &game_path) {
 }
 
 std::filesystem::path constructSavesFolderPath(const std::filesystem::path& game_path) {
-    Pm3GameType game_type = getPm3GameType(game_path);
-    const char *savesFolder = getSavesFolder(game_type);
-    if (savesFolder == nullptr) {
+    auto installation = resolveInstallation(game_path);
+    if (!installation->valid()) {
         gPm3LastError = "Invalid PM3 folder: could not find PM3 executable in " + game_path.string();
         return {};
     }
 
-    return game_path / savesFolder;
+    return installation->savesFolder;
 }
 
 std::filesystem::path constructSaveFilePath(const std::filesystem::path& game_path, int gameNumber, char gameLetter) {
+    auto installation = resolveInstallation(game_path);
+    if (installation->valid() && gameNumber >= 1 && gameNumber <= kSaveSlotCount && gameLetter >= 'A' &&
+        gameLetter <= 'C') {
+        return installation->slotFiles[gameNumber - 1][gameLetter - 'A'];
+    }
     return constructSavesFolderPath(game_path) / (std::string{kGameFilePrefix} + std::to_string(gameNumber) + gameLetter);
 }
 
@@ -176,18 +259,7 @@ std::filesystem::path constructGameFilePath(const std::filesystem::path &game_pa
 }
 
 Pm3GameType getPm3GameType(const std::filesystem::path &game_path) {
-    std::filesystem::path full_path;
-    full_path = game_path / kExeStandardFilename;
-    if (std::filesystem::exists(full_path)) {
-        return Pm3GameType::Standard;
-    }
-
-    full_path = game_path / kExeDeluxeFilename;
-    if (std::filesystem::exists(full_path)) {
-        return Pm3GameType::Deluxe;
-    }
-
-    return Pm3GameType::Unknown;
+    return resolveInstallation(game_path)->gameType;
 }
 
 const char* getSavesFolder(Pm3GameType game_type) {
@@ -207,6 +279,103 @@ const std::string& pm3LastError() {
 
 namespace {
 const int saveGameSizes[3] = {29554, 139080, 157280};
+constexpr const char *kPm3FilesBackupLabel = "DATA";
+
+constexpr char kGameLetters[3] = {'A', 'B', 'C'};
+
+// The slot as it is written to disk: the globals themselves, or copies converted back to the byte
+// order the slot was loaded in.
+struct DiskSlot {
+    const gamea *gameA = &gameData;
+    const gameb *gameB = &clubData;
+    const gamec *gameC = &playerData;
+    std::unique_ptr<gamea> swappedA;
+    std::unique_ptr<gameb> swappedB;
+    std::unique_ptr<gamec> swappedC;
+};
+
+DiskSlot diskSlot() {
+    DiskSlot slot;
+    if (gSlotByteOrder != byte_order::kNative) {
+        slot.swappedA = std::make_unique<gamea>(gameData);
+        slot.swappedB = std::make_unique<gameb>(clubData);
+        slot.swappedC = std::make_unique<gamec>(playerData);
+        byte_order::swap(*slot.swappedA);
+        byte_order::swap(*slot.swappedB);
+        byte_order::swap(*slot.swappedC);
+        slot.gameA = slot.swappedA.get();
+        slot.gameB = slot.swappedB.get();
+        slot.gameC = slot.swappedC.get();
+    }
+    return slot;
+}
+
+std::string slotChecksums(int gameNumber, const DiskSlot &slot) {
+    return slot_checksums(gameNumber, *slot.gameA, *slot.gameB, *slot.gameC);
+}
+
+bool recordFileBaseline(const std::filesystem::path &gamePath, int gameNumber, int letterIndex) {
+    std::error_code ec;
+    std::filesystem::path path = io::constructSaveFilePath(gamePath, gameNumber, kGameLetters[letterIndex]);
+    gSlotBaseline.writeTimes[letterIndex] = std::filesystem::last_write_time(path, ec);
+    gSlotBaseline.sizes[letterIndex] = std::filesystem::file_size(path, ec);
+    return !ec;
+}
+
+void recordSlotBaseline(const std::filesystem::path &gamePath, int gameNumber) {
+    gSlotBaseline = SlotBaseline{gameNumber, gamePath, {}, {}, {}};
+    for (int i = 0; i < 3; ++i) {
+        if (!recordFileBaseline(gamePath, gameNumber, i)) {
+            gSlotBaseline.gameNumber = 0;
+            break;
+        }
+    }
+    gSlotBaseline.checksums = slotChecksums(gameNumber, diskSlot());
+    dirty_tracker::clear();
+}
+
+bool fileMatchesBaseline(const std::filesystem::path &gamePath, int gameNumber, int letterIndex) {
+    if (gSlotBaseline.gameNumber != gameNumber || gSlotBaseline.gamePath != gamePath) {
+        return false;
+    }
+    std::error_code ec;
+    std::filesystem::path path = io::constructSaveFilePath(gamePath, gameNumber, kGameLetters[letterIndex]);
+    return std::filesystem::last_write_time(path, ec) == gSlotBaseline.writeTimes[letterIndex] &&
+           std::filesystem::file_size(path, ec) == gSlotBaseline.sizes[letterIndex] && !ec;
+}
+
+bool slotMatchesBaseline(const std::filesystem::path &gamePath, int gameNumber) {
+    for (int i = 0; i < 3; ++i) {
+        if (!fileMatchesBaseline(gamePath, gameNumber, i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Reads one slot file that another program rewrote, in native order. Nothing is swapped in yet.
+template <typename T>
+bool readChangedSaveFile(const std::filesystem::path &gamePath, int gameNumber, int letterIndex,
+                         std::unique_ptr<T> &fresh) {
+    fresh = std::make_unique<T>();
+    std::filesystem::path path = io::constructSaveFilePath(gamePath, gameNumber, kGameLetters[letterIndex]);
+    if (!io::readExact(path, fresh.get(), sizeof(T))) {
+        gPm3LastError = "Missing or resized file: " + path.string();
+        return false;
+    }
+    if (gSlotByteOrder != byte_order::kNative) {
+        byte_order::swap(*fresh);
+    }
+    return true;
+}
+
+template <typename T>
+void swapInSaveFile(const std::unique_ptr<T> &fresh, T &current, io::RecordChanges &changes) {
+    if (fresh) {
+        io::diffRecords(current, *fresh, changes);
+        current = *fresh;
+    }
+}
 }
 
 void loadPrefs(Settings &settings) {
@@ -235,12 +404,42 @@ bool checkSaveFileExists(const Settings &settings, int gameNumber, char gameLett
 }
 
 void memoizeSaveFiles(const Settings &settings, std::bitset<8> &saveFiles) {
-    for (int i = 1; i <= 8; i++) {
-        saveFiles.set(i - 1,
-                      checkSaveFileExists(settings, i, 'A') &&
-                      checkSaveFileExists(settings, i, 'B') &&
-                      checkSaveFileExists(settings, i, 'C'));
+    // Slot presence is part of the cached installation, refreshed when the saves folder changes.
+    auto installation = resolveInstallation(settings.gamePath);
+    for (int i = 0; i < kSaveSlotCount; i++) {
+        saveFiles.set(i, installation->presentSlots.test(i));
+    }
+}
+
+static MetadataStamp stampMetadata(const std::filesystem::path &savesFolder) {
+    MetadataStamp stamp{savesFolder, {}, {}};
+    const std::string_view names[] = {kSavesDirFile, kPrefsFile};
+    for (int i = 0; i < 2; ++i) {
+        std::error_code ec;
+        std::filesystem::path path = savesFolder / std::string{names[i]};
+        stamp.writeTimes[i] = std::filesystem::last_write_time(path, ec);
+        stamp.sizes[i] = std::filesystem::file_size(path, ec);
     }
+    return stamp;
+}
+
+// Reads SAVES.DIR and PREFS again unless they are still the files read last time.
+static bool refreshMetadata(const std::filesystem::path &gamePath) {
+    auto installation = resolveInstallation(gamePath);
+    if (!installation->valid()) {
+        gMetadataStamp = {};
+        return loadMetadata(gamePath);
+    }
+    MetadataStamp stamp = stampMetadata(installation->savesFolder);
+    if (stamp == gMetadataStamp) {
+        return true;
+    }
+    if (!loadMetadata(gamePath)) {
+        gMetadataStamp = {};
+        return false;
+    }
+    gMetadataStamp = stamp;
+    return true;
 }
 
 bool ensureMetadataLoaded(const Settings &settings, int currentGame, std::bitset<8> &saveFiles, char *footer,
@@ -254,73 +453,241 @@ bool ensureMetadataLoaded(const Settings &settings, int currentGame, std::bitset
         loadDefaultClubdata(settings.gamePath);
     }
 
-    if (!loadMetadata(settings.gamePath)) {
+    if (!refreshMetadata(settings.gamePath)) {
         snprintf(footer, footerSize, "%.64s", pm3LastError().c_str());
         return false;
     }
 
+    auto installation = resolveInstallation(settings.gamePath);
+    if (installation->valid()) {
+        slotCache().watch(settings.gamePath);
+    }
     return true;
 }
 
+BackupStore backupStore(const std::filesystem::path &game_path) {
+    return BackupStore(game_path / BACKUP_SAVE_PATH);
+}
+
 bool backupSaveFile(const Settings &settings, int gameNumber) {
+    std::vector<std::filesystem::path> files;
     for (char c = 'A'; c <= 'C'; ++c) {
         std::filesystem::path saveGamePath = constructSaveFilePath(settings.gamePath, gameNumber, c);
+        if (std::filesystem::exists(saveGamePath)) {
+            files.push_back(saveGamePath);
+        }
+    }
+    if (files.empty()) {
+        return true;
+    }
 
-        try {
-            if (!std::filesystem::exists(saveGamePath)) {
-                return true;
-            }
+    // Chunks shared with earlier generations (or other slots) are not written again, so this
+    // costs little more than reading the slot.
+    std::string label = std::string{kGameFilePrefix} + std::to_string(gameNumber);
+    BackupStore store = backupStore(settings.gamePath);
+    std::string error;
+    if (store.addGeneration(label, files, error) == 0) {
+        gPm3LastError = error;
+        std::cerr << "Error backing up save: " << error << std::endl;
+        return false;
+    }
+    store.prune(label, BACKUP_HISTORY_GENERATIONS);
+    return true;
+}
 
-            std::filesystem::path backupPath = constructSavesFolderPath(settings.gamePath) / BACKUP_SAVE_PATH;
+bool backupPm3Files(const std::filesystem::path &game_path) {
+    std::vector<std::filesystem::path> files;
+    const std::array<std::string_view, 3> pm3Files = {kGameDataFile, kClubDataFile, kPlayDataFile};
+    for (const auto &fileName : pm3Files) {
+        std::filesystem::path source = constructGameFilePath(game_path, std::string{fileName});
+        if (!std::filesystem::exists(source)) {
+            gPm3LastError = "Missing PM3 file: " + source.string();
+            return false;
+        }
+        files.push_back(source);
+    }
 
-            if (!std::filesystem::exists(backupPath)) {
-                if (!std::filesystem::create_directories(backupPath)) {
-                    std::cerr << "Failed to create backup directory: " << backupPath << std::endl;
-                    return false;
-                }
-            }
+    BackupStore store = backupStore(game_path);
+    std::string error;
+    if (store.addGeneration(kPm3FilesBackupLabel, files, error) == 0) {
+        gPm3LastError = "Error backing up PM3 files: " + error;
+        return false;
+    }
+    store.prune(kPm3FilesBackupLabel, BACKUP_HISTORY_GENERATIONS);
+    return true;
+}
 
-            std::filesystem::path dest = backupPath / saveGamePath.filename();
-            std::filesystem::copy(saveGamePath, dest, std::filesystem::copy_options::overwrite_existing);
-        } catch (const std::filesystem::filesystem_error &e) {
-            std::cerr << "Error copying file: " << e.what() << std::endl;
+bool restoreBackup(const std::filesystem::path &game_path, std::uint32_t generation) {
+    BackupStore store = backupStore(game_path);
+    for (const auto &entry : store.generations()) {
+        if (entry.id != generation) {
+            continue;
+        }
+        std::filesystem::path target = entry.label == kPm3FilesBackupLabel ? game_path
+                                                                            : constructSavesFolderPath(game_path);
+        std::string error;
+        if (target.empty() || !store.restore(generation, target, error)) {
+            gPm3LastError = error.empty() ? gPm3LastError : error;
             return false;
         }
+        return true;
     }
 
+    gPm3LastError = "Unknown backup generation " + std::to_string(generation);
+    return false;
+}
+
+bool exportBundle(const Settings &settings, int gameNumber, const std::filesystem::path &bundlePath, bool compress) {
+    std::filesystem::path savesFolder = constructSavesFolderPath(settings.gamePath);
+    if (savesFolder.empty()) {
+        return false;
+    }
+    try {
+        MappedFile fileA(constructSaveFilePath(settings.gamePath, gameNumber, 'A'));
+        MappedFile fileB(constructSaveFilePath(settings.gamePath, gameNumber, 'B'));
+        MappedFile fileC(constructSaveFilePath(settings.gamePath, gameNumber, 'C'));
+        MappedFile savesFile(savesFolder / std::string{kSavesDirFile});
+        MappedFile prefsFile(savesFolder / std::string{kPrefsFile});
+        if (fileA.size() < sizeof(gamea) || fileB.size() != sizeof(gameb) || fileC.size() != sizeof(gamec) ||
+            savesFile.size() < sizeof(saves)) {
+            gPm3LastError = "Save game " + std::to_string(gameNumber) + " has invalid file sizes";
+            return false;
+        }
+
+        // Every file goes in byte for byte, including anything past the gamea struct.
+        std::vector<std::uint8_t> bundle = buildBundle(static_cast<std::uint32_t>(gameNumber), {
+                {BundleSection::GameA, fileA.data(), sizeof(gamea)},
+                {BundleSection::GameaTail, fileA.data() + sizeof(gamea), fileA.size() - sizeof(gamea)},
+                {BundleSection::GameB, fileB.data(), fileB.size()},
+                {BundleSection::GameC, fileC.data(), fileC.size()},
+                {BundleSection::SavesDir, savesFile.data(), savesFile.size()},
+                {BundleSection::Prefs, prefsFile.data(), prefsFile.size()},
+        }, compress);
+        if (!writeFileDurable(bundlePath, bundle.data(), bundle.size())) {
+            gPm3LastError = "Could not write " + bundlePath.string();
+            return false;
+        }
+    } catch (const std::runtime_error &e) {
+        gPm3LastError = e.what();
+        return false;
+    }
     return true;
 }
 
-bool backupPm3Files(const std::filesystem::path &game_path) {
-    std::filesystem::path backupDir = game_path / BACKUP_SAVE_PATH;
+bool importBundle(const Settings &settings, const std::filesystem::path &bundlePath, int gameNumber) {
+    std::filesystem::path savesFolder = constructSavesFolderPath(settings.gamePath);
+    if (savesFolder.empty()) {
+        return false;
+    }
+    if (gameNumber < 1 || gameNumber > kSaveSlotCount) {
+        gPm3LastError = "Invalid save slot " + std::to_string(gameNumber);
+        return false;
+    }
+
     try {
-        if (!std::filesystem::exists(backupDir)) {
-            if (!std::filesystem::create_directories(backupDir)) {
-                gPm3LastError = "Failed to create backup directory: " + backupDir.string();
-                return false;
-            }
+        SaveBundle bundle(bundlePath);
+        std::vector<std::uint8_t> gameA = bundle.section(BundleSection::GameA);
+        std::vector<std::uint8_t> gameaTail;
+        if (bundle.has(BundleSection::GameaTail)) {
+            gameaTail = bundle.section(BundleSection::GameaTail);
+        }
+        std::vector<std::uint8_t> gameB = bundle.section(BundleSection::GameB);
+        std::vector<std::uint8_t> gameC = bundle.section(BundleSection::GameC);
+        std::vector<std::uint8_t> bundleSavesDir = bundle.section(BundleSection::SavesDir);
+        std::vector<std::uint8_t> bundlePrefs = bundle.section(BundleSection::Prefs);
+        std::uint32_t sourceSlot = bundle.sourceSlot();
+        if (gameA.size() != sizeof(gamea) || gameB.size() != sizeof(gameb) || gameC.size() != sizeof(gamec) ||
+            bundleSavesDir.size() < sizeof(saves) || sourceSlot < 1 || sourceSlot > kSaveSlotCount) {
+            gPm3LastError = "Bundle " + bundlePath.string() + " does not hold a PM3 save game";
+            return false;
         }
 
-        const std::array<std::string_view, 3> pm3Files = {kGameDataFile, kClubDataFile, kPlayDataFile};
-        for (const auto &fileName : pm3Files) {
-            std::filesystem::path source = constructGameFilePath(game_path, std::string{fileName});
-            if (!std::filesystem::exists(source)) {
-                gPm3LastError = "Missing PM3 file: " + source.string();
+        // The other slots listed in this folder's SAVES.DIR stay as they are; only the entry of the
+        // imported slot is taken from the bundle. Without a readable SAVES.DIR the copy read when the
+        // folder was loaded stands in; with neither, writing one would wipe the other slots' entries.
+        saves targetSavesDir{};
+        std::filesystem::path savesDirPath = savesFolder / std::string{kSavesDirFile};
+        std::error_code ec;
+        bool readSavesDir = std::filesystem::file_size(savesDirPath, ec) >= sizeof(saves) && !ec &&
+                            load_binary_file(savesDirPath, targetSavesDir);
+        if (!readSavesDir) {
+            if (gMetadataStamp.savesFolder != savesFolder) {
+                gPm3LastError = "Missing or truncated file: " + savesDirPath.string();
                 return false;
             }
+            targetSavesDir = savesDir;
+        }
+        std::memcpy(&targetSavesDir.game[gameNumber - 1],
+                    bundleSavesDir.data() + (sourceSlot - 1) * sizeof(targetSavesDir.game[0]),
+                    sizeof(targetSavesDir.game[0]));
+
+        if (!backupSaveFile(settings, gameNumber)) {
+            return false;
+        }
 
-            std::filesystem::path dest = backupDir / source.filename();
-            std::filesystem::copy(source, dest, std::filesystem::copy_options::overwrite_existing);
+        std::string prefix = std::string{kGameFilePrefix} + std::to_string(gameNumber);
+        std::uint64_t gameaHash = checksum(gameA.data(), gameA.size());
+        if (!gameaTail.empty()) {
+            std::vector<std::uint8_t> whole = gameA;
+            whole.insert(whole.end(), gameaTail.begin(), gameaTail.end());
+            gameaHash = checksum(whole.data(), whole.size());
         }
-    } catch (const std::filesystem::filesystem_error &e) {
-        gPm3LastError = std::string("Error backing up PM3 files: ") + e.what();
+        std::string checksums = formatChecksumSidecar({
+                {prefix + 'A', gameA.size() + gameaTail.size(), gameaHash},
+                {prefix + 'B', gameB.size(), checksum(gameB.data(), gameB.size())},
+                {prefix + 'C', gameC.size(), checksum(gameC.data(), gameC.size())},
+        });
+        std::vector<FileWrite> writes = {
+                {constructSaveFilePath(settings.gamePath, gameNumber, 'A'), gameA.data(), gameA.size(),
+                 gameaTail.data(), gameaTail.size()},
+                {constructSaveFilePath(settings.gamePath, gameNumber, 'B'), gameB.data(), gameB.size()},
+                {constructSaveFilePath(settings.gamePath, gameNumber, 'C'), gameC.data(), gameC.size()},
+                {savesFolder / std::string{kSavesDirFile}, &targetSavesDir, sizeof(saves)},
+                {savesFolder / std::string{kPrefsFile}, bundlePrefs.data(), bundlePrefs.size()},
+                {constructChecksumSidecarPath(settings.gamePath, gameNumber), checksums.data(), checksums.size()},
+        };
+        std::string error;
+        if (!commitFiles(savesFolder, writes, error)) {
+            gPm3LastError = error;
+            return false;
+        }
+
+        savesDir.game[gameNumber - 1] = targetSavesDir.game[gameNumber - 1];
+        std::memcpy(&preferences, bundlePrefs.data(), std::min(bundlePrefs.size(), sizeof(prefs)));
+
+        // Importing over the loaded slot replaces it like loading it again would; otherwise the next
+        // delta save would patch the old game's edits onto the imported files.
+        if (gSlotBaseline.gameNumber == gameNumber && gSlotBaseline.gamePath == settings.gamePath) {
+            std::memcpy(&gameData, gameA.data(), sizeof(gamea));
+            std::memcpy(&clubData, gameB.data(), sizeof(gameb));
+            std::memcpy(&playerData, gameC.data(), sizeof(gamec));
+            gSlotByteOrder = byte_order::toNative(gameData, clubData, playerData);
+            recordSlotBaseline(settings.gamePath, gameNumber);
+            undo_journal::reset();
+            roster_index::invalidate();
+            player_identity::retireAll();
+        }
+    } catch (const std::runtime_error &e) {
+        gPm3LastError = e.what();
         return false;
     }
-
     return true;
 }
 
 bool loadGame(const Settings &settings, int gameNumber, char *footer, size_t footerSize) {
+    // Prefetched slots were validated like below when the worker parsed them.
+    if (auto cached = slotCache().find(gameNumber)) {
+        gameData = cached->gameA;
+        clubData = cached->gameB;
+        playerData = cached->gameC;
+        gSlotByteOrder = byte_order::toNative(gameData, clubData, playerData);
+        recordSlotBaseline(settings.gamePath, gameNumber);
+        undo_journal::reset();
+        roster_index::invalidate();
+        player_identity::retireAll();
+        return true;
+    }
+
     std::filesystem::path gameaPath = constructSaveFilePath(settings.gamePath, gameNumber, 'A');
     std::filesystem::path gamebPath = constructSaveFilePath(settings.gamePath, gameNumber, 'B');
     std::filesystem::path gamecPath = constructSaveFilePath(settings.gamePath, gameNumber, 'C');
@@ -340,19 +707,208 @@ bool loadGame(const Settings &settings, int gameNumber, char *footer, size_t foo
     }
 
     loadBinaries(gameNumber, settings.gamePath);
+    gSlotByteOrder = byte_order::toNative(gameData, clubData, playerData);
+    recordSlotBaseline(settings.gamePath, gameNumber);
+    undo_journal::reset();
+    roster_index::invalidate();
+    player_identity::retireAll();
+    return true;
+}
+
+bool reloadChangedSaves(const Settings &settings, int currentGame, char *footer, size_t footerSize) {
+    auto installation = resolveInstallation(settings.gamePath);
+    if (!installation->valid()) {
+        return false;
+    }
+    if (gHotReload.watcher.folder() != installation->savesFolder) {
+        gHotReload.watcher = SaveWatcher(installation->savesFolder);
+    }
+    if (gHotReload.gameNumber != currentGame) {
+        gHotReload = HotReloadState{std::move(gHotReload.watcher), currentGame, {}, false};
+    }
+
+    for (const SettledSaveFile &file : gHotReload.watcher.poll()) {
+        if (file.gameNumber == currentGame) {
+            gHotReload.files.set(file.gameLetter - 'A');
+        }
+    }
+    // Our own saves come back as events too; those files still match the baseline.
+    for (int i = 0; i < 3; ++i) {
+        if (gHotReload.files.test(i) && fileMatchesBaseline(settings.gamePath, currentGame, i)) {
+            gHotReload.files.reset(i);
+        }
+    }
+    if (currentGame == 0 || gHotReload.files.none()) {
+        gHotReload.heldReported = false;
+        return false;
+    }
+
+    // Never overwrite edits that have not been saved; the reload waits until they are saved (which
+    // replaces the files on disk, so nothing is reloaded) or the slot is loaded again.
+    if (dirty_tracker::any()) {
+        if (gHotReload.heldReported) {
+            return false;
+        }
+        gHotReload.heldReported = true;
+        snprintf(footer, footerSize, "GAME%d CHANGED ON DISK, KEEPING UNSAVED EDITS", currentGame);
+        return true;
+    }
+
+    // Every changed file is read before any of them replaces the globals, so a failed reload
+    // leaves the slot, its edit history and its baseline as they were.
+    std::unique_ptr<gamea> freshA;
+    std::unique_ptr<gameb> freshB;
+    std::unique_ptr<gamec> freshC;
+    std::bitset<3> files = gHotReload.files;
+    gHotReload.files.reset();
+    gHotReload.heldReported = false;
+    if (!(!files.test(0) || readChangedSaveFile(settings.gamePath, currentGame, 0, freshA)) ||
+        !(!files.test(1) || readChangedSaveFile(settings.gamePath, currentGame, 1, freshB)) ||
+        !(!files.test(2) || readChangedSaveFile(settings.gamePath, currentGame, 2, freshC))) {
+        snprintf(footer, footerSize, "ERROR RELOADING GAME %d", currentGame);
+        return true;
+    }
+
+    RecordChanges changes;
+    swapInSaveFile(freshA, gameData, changes);
+    swapInSaveFile(freshB, clubData, changes);
+    swapInSaveFile(freshC, playerData, changes);
+    for (int i = 0; i < 3; ++i) {
+        if (files.test(i) && !recordFileBaseline(settings.gamePath, currentGame, i)) {
+            gSlotBaseline.gameNumber = 0; // unknown files on disk; the next save commits them whole
+        }
+    }
+    // The history was recorded against the records that were just replaced, and the globals match
+    // the files again.
+    dirty_tracker::clear();
+    undo_journal::reset();
+    roster_index::invalidate();
+    player_identity::retireAll();
+    // The files now differ from what GAMEn.SUM describes, so the next save is a full commit.
+    gSlotBaseline.checksums = slotChecksums(currentGame, diskSlot());
+    snprintf(footer, footerSize, "%s", summarizeChanges(currentGame, changes).c_str());
+    return true;
+}
+
+std::filesystem::path constructChecksumSidecarPath(const std::filesystem::path &gamePath, int gameNumber) {
+    return constructSavesFolderPath(gamePath) /
+           (std::string{kGameFilePrefix} + std::to_string(gameNumber) + CHECKSUM_SIDECAR_SUFFIX);
+}
+
+bool verifySaveGame(const std::filesystem::path &gamePath, int gameNumber) {
+    std::string error;
+    if (!verifyChecksumSidecar(constructChecksumSidecarPath(gamePath, gameNumber), error)) {
+        gPm3LastError = error;
+        return false;
+    }
+    return true;
+}
+
+bool commitGame(int gameNumber, const std::filesystem::path &gamePath) {
+    std::filesystem::path savesFolder = constructSavesFolderPath(gamePath);
+    if (savesFolder.empty()) {
+        return false;
+    }
+
+    DiskSlot slot = diskSlot();
+    std::string checksums = slotChecksums(gameNumber, slot);
+    std::vector<FileWrite> writes = {
+            {constructSaveFilePath(gamePath, gameNumber, 'A'), slot.gameA, sizeof(gamea)},
+            {constructSaveFilePath(gamePath, gameNumber, 'B'), slot.gameB, sizeof(gameb)},
+            {constructSaveFilePath(gamePath, gameNumber, 'C'), slot.gameC, sizeof(gamec)},
+            {savesFolder / std::string{kSavesDirFile}, &savesDir, sizeof(saves)},
+            {savesFolder / std::string{kPrefsFile}, &preferences, sizeof(prefs)},
+            {constructChecksumSidecarPath(gamePath, gameNumber), checksums.data(), checksums.size()},
+    };
+
+    std::string error;
+    if (!commitFiles(savesFolder, writes, error)) {
+        gPm3LastError = error;
+        return false;
+    }
+    return true;
+}
+
+bool patchGame(int gameNumber, const std::filesystem::path &gamePath) {
+    std::filesystem::path savesFolder = constructSavesFolderPath(gamePath);
+    if (savesFolder.empty()) {
+        return false;
+    }
+
+    // The metadata files are tiny and always change, so they are patched whole.
+    DiskSlot slot = diskSlot();
+    std::vector<FilePatch> patches = {
+            {constructSaveFilePath(gamePath, gameNumber, 'A'), slot.gameA, dirty_tracker::dirtyRanges('A')},
+            {constructSaveFilePath(gamePath, gameNumber, 'B'), slot.gameB, dirty_tracker::dirtyRanges('B')},
+            {constructSaveFilePath(gamePath, gameNumber, 'C'), slot.gameC, dirty_tracker::dirtyRanges('C')},
+            {savesFolder / std::string{kSavesDirFile}, &savesDir, {{0, sizeof(saves)}}},
+            {savesFolder / std::string{kPrefsFile}, &preferences, {{0, sizeof(prefs)}}},
+    };
+
+    // The sidecar is patched whole under the same undo log as the data it describes. It must still
+    // describe the files as they were loaded: PM3 rewrites slots without it, and the files are only
+    // patched when they are known to be what was loaded. Otherwise the save takes the full commit.
+    std::filesystem::path sidecarPath = constructChecksumSidecarPath(gamePath, gameNumber);
+    std::ifstream sidecar(sidecarPath, std::ios::binary);
+    std::string onDisk((std::istreambuf_iterator<char>(sidecar)), std::istreambuf_iterator<char>());
+    if (!sidecar.is_open() || gSlotBaseline.gameNumber != gameNumber || gSlotBaseline.gamePath != gamePath ||
+        onDisk != gSlotBaseline.checksums) {
+        return false;
+    }
+    std::string checksums = slotChecksums(gameNumber, slot);
+    patches.push_back({sidecarPath, checksums.data(), {{0, checksums.size()}}});
+
+    std::string error;
+    if (!patchFiles(savesFolder, patches, error)) {
+        gPm3LastError = error;
+        return false;
+    }
     return true;
 }
 
+void recoverInterruptedSave(const Settings &settings) {
+    if (settings.gamePath.empty() || getPm3GameType(settings.gamePath) == Pm3GameType::Unknown) {
+        return;
+    }
+    std::filesystem::path savesFolder = constructSavesFolderPath(settings.gamePath);
+    bool rolledBackCommit = recoverInterruptedCommit(savesFolder);
+    bool rolledBackPatch = recoverInterruptedPatch(savesFolder);
+    if (rolledBackCommit || rolledBackPatch) {
+        std::cerr << "Rolled back an interrupted save in " << savesFolder << std::endl;
+    }
+}
+
 bool saveGame(const Settings &settings, int gameNumber, char *footer, size_t footerSize) {
-    if (backupSaveFile(settings, gameNumber)) {
-        updateMetadata(gameNumber, settings.gamePath);
-        saveBinaries(gameNumber, settings.gamePath);
-        saveMetadata(constructSavesFolderPath(settings.gamePath));
+    if (!backupSaveFile(settings, gameNumber)) {
+        snprintf(footer, footerSize, "ERROR SAVING: COULDN'T BACKUP SAVE GAME %d", gameNumber);
+        return false;
+    }
+
+    // SAVES.DIR is written back whole, so it must start from what PM3 last wrote there, not from
+    // a copy that is older than the other slots' entries. Without it the copy in memory is used.
+    refreshMetadata(settings.gamePath);
+    saves previousSavesDir = savesDir;
+    updateMetadata(gameNumber, settings.gamePath);
+
+    // Saving back to the slot that was loaded only has to write the records that changed, as
+    // long as the files on disk are still the ones we loaded. Anything else is a full commit.
+    constexpr std::size_t slotBytes = sizeof(gamea) + sizeof(gameb) + sizeof(gamec);
+    bool saved = false;
+    if (slotMatchesBaseline(settings.gamePath, gameNumber) && dirty_tracker::dirtyBytes() < slotBytes / 2) {
+        saved = patchGame(gameNumber, settings.gamePath);
+    }
+    if (!saved) {
+        saved = commitGame(gameNumber, settings.gamePath);
+    }
+
+    if (saved) {
+        recordSlotBaseline(settings.gamePath, gameNumber);
         snprintf(footer, footerSize, "GAME %d SAVED", gameNumber);
         return true;
     }
 
-    snprintf(footer, footerSize, "ERROR SAVING: COULDN'T BACKUP SAVE GAME %d", gameNumber);
+    savesDir = previousSavesDir;
+    snprintf(footer, footerSize, "ERROR SAVING GAME %d: %.40s", gameNumber, pm3LastError().c_str());
     return false;
 }
 
@@ -374,6 +930,7 @@ void choosePm3Folder(Settings &settings, std::bitset<8> &saveFiles) {
         settings.gamePath = selectedPath;
         NFD_FreePath(outPath);
         savePrefs(settings);
+        recoverInterruptedSave(settings);
         memoizeSaveFiles(settings, saveFiles);
     } else if (result == NFD_ERROR) {
         std::string errorMessage = NFD_GetError() ? NFD_GetError() : "Unknown NFD error";
@@ -8,6 +8,7 @@
 #include "settings.h"
 #include "pm3_defs.hh"
 #include "pm3_data.h"
+#include "backup_store.h"
 
 class InputHandler;
 
@@ -24,7 +25,14 @@ bool ensureMetadataLoaded(const Settings &settings, int currentGame, std::bitset
 
 bool backupSaveFile(const Settings &settings, int gameNumber);
 bool loadGame(const Settings &settings, int gameNumber, char *footer, size_t footerSize);
+// Reloads files of the current slot that another program rewrote, unless there are unsaved edits.
+// Returns true when it put something in the footer.
+bool reloadChangedSaves(const Settings &settings, int currentGame, char *footer, size_t footerSize);
 bool saveGame(const Settings &settings, int gameNumber, char *footer, size_t footerSize);
+bool commitGame(int gameNumber, const std::filesystem::path &gamePath);
+bool patchGame(int gameNumber, const std::filesystem::path &gamePath);
+bool verifySaveGame(const std::filesystem::path &gamePath, int gameNumber);
+void recoverInterruptedSave(const Settings &settings);
 
 void choosePm3Folder(Settings &settings, std::bitset<8> &saveFiles);
 void loadGameConfirm(InputHandler &input, Settings &settings, int gameNumber, int &currentGame, char *footer,
@@ -37,6 +45,7 @@ void loadDefaultGamedata(const std::filesystem::path &gamePath, gamea &gameDataO
 void loadDefaultClubdata(const std::filesystem::path &gamePath, gameb &clubDataOut=clubData);
 void loadDefaultPlaydata(const std::filesystem::path &gamePath, gamec &playerDataOut=playerData);
 bool loadMetadata(const std::filesystem::path &gamePath, saves &savesDirOut=savesDir, prefs &prefsOut=preferences);
+// Writes the three slot files and refreshes the slot's GAMEn.SUM; throws if a file cannot be written.
 void saveBinaries(int gameNumber, const std::filesystem::path &gamePath, gamea &gameDataOut=gameData, gameb &clubDataOut=clubData, gamec &playerDataOut=playerData);
 void saveDefaultGamedata(const std::filesystem::path &gamePath, const gamea &gameDataOut=gameData);
 std::size_t getGameaExtraBytes();
@@ -45,8 +54,16 @@ void saveDefaultPlaydata(const std::filesystem::path &gamePath, const gamec &pla
 void saveMetadata(const std::filesystem::path &gamePath, saves &savesDirOut=savesDir, prefs &prefsOut=preferences);
 void updateMetadata(int gameNumber, const std::filesystem::path &gamePath);
 bool backupPm3Files(const std::filesystem::path &gamePath);
+BackupStore backupStore(const std::filesystem::path &gamePath);
+bool restoreBackup(const std::filesystem::path &gamePath, std::uint32_t generation);
+// Snapshots a slot into a single .pm3bundle file, and imports one into any slot (backing up what
+// was there first).
+bool exportBundle(const Settings &settings, int gameNumber, const std::filesystem::path &bundlePath,
+                  bool compress = true);
+bool importBundle(const Settings &settings, const std::filesystem::path &bundlePath, int gameNumber);
 std::filesystem::path constructSavesFolderPath(const std::filesystem::path& gamePath);
 std::filesystem::path constructSaveFilePath(const std::filesystem::path& gamePath, int gameNumber, char gameLetter);
+std::filesystem::path constructChecksumSidecarPath(const std::filesystem::path &gamePath, int gameNumber);
 std::filesystem::path constructGameFilePath(const std::filesystem::path &gamePath, const std::string &fileName);
 Pm3GameType getPm3GameType(const std::filesystem::path &gamePath);
 const char* getSavesFolder(Pm3GameType gameType);
@@ -15,6 +15,10 @@
 #include "text.h"
 #include "gfx.h"
 #include "input.h"
+#include "dirty_tracker.h"
+#include "player_identity.h"
+#include "roster_index.h"
+#include "undo_journal.h"
 #include "io.h"
 #include "game_utils.h"
 #include "settings.h"
@@ -32,6 +36,9 @@
 #include "screens/free_players_screen.h"
 #include "screens/my_team_screen.h"
 #include "screens/scout_screen.h"
+#include "screens/player_search_screen.h"
+#include "screens/name_search_screen.h"
+#include "screens/similar_players_screen.h"
 #include "screens/change_team_screen.h"
 #include "screens/telephone_screen.h"
 #include "screens/convert_coach_screen.h"
@@ -46,6 +53,9 @@ typedef enum {
     FREE_PLAYERS_SCREEN,
     MY_TEAM_SCREEN,
     SCOUT_SCREEN,
+    PLAYER_SEARCH_SCREEN,
+    NAME_SEARCH_SCREEN,
+    SIMILAR_PLAYERS_SCREEN,
     CHANGE_TEAM_SCREEN,
     TELEPHONE_SCREEN,
     CONVERT_COACH_SCREEN,
@@ -74,7 +84,9 @@ private:
 
     std::bitset<8> saveFiles{};
 
-    std::vector<club_player> freePlayers{};
+    std::vector<PlayerRow> freePlayers{};
+
+    PlayerSelection similarTo{};
 
     Settings settings{};
 
@@ -103,6 +115,10 @@ private:
 
     void drawCurrentScreen();
 
+    void presentFrame(SDL_Texture *texTarget);
+
+    void undoOrRedo(bool undo);
+
     void toggleWindowed();
 
     void importSwosTeams();
@@ -127,6 +143,7 @@ void Application::initializeSDL() {
 
     io::loadPrefs(settings);
     settings.gameType = io::getPm3GameType(settings.gamePath);
+    io::recoverInterruptedSave(settings);
 
 #if defined linux && SDL_VERSION_ATLEAST(2, 0, 8)
     // Disable compositor bypass
@@ -224,10 +241,10 @@ void Application::initializeScreens() {
             text_utils::writeSubHeader(*textRenderer, text, cb);
         }
     };
-    screenContext.freePlayersRef = [this]() -> std::vector<club_player> & { return freePlayers; };
+    screenContext.freePlayersRef = [this]() -> std::vector<PlayerRow> & { return freePlayers; };
     screenContext.refreshFreePlayers = [this]() { freePlayers = findFreePlayers(); };
-    screenContext.writePlayers = [this](std::vector<club_player> &players, int &line,
-                                        const std::function<void(const club_player &)> &cb) {
+    screenContext.writePlayers = [this](PlayerRowSpan players, int &line,
+                                        const std::function<void(const PlayerRow &)> &cb) {
         if (!textRenderer) {
             return line;
         }
@@ -246,11 +263,27 @@ void Application::initializeScreens() {
     screenContext.startReadingTextInput = [this](std::function<void(void)> cb) {
         input.startReadingTextInput(std::move(cb));
     };
+    screenContext.startReadingNameInput = [this](std::function<void(void)> cb) {
+        input.startReadingTextInput(std::move(cb), TextInputMode::Name);
+    };
+    screenContext.readingTextInput = [this]() { return input.isReadingTextInput(); };
     screenContext.endReadingTextInput = [this]() { input.endReadingTextInput(); };
     screenContext.currentTextInput = [this]() -> const char * { return input.getTextInput(); };
-    screenContext.makeOffer = [this](const club_player &playerInfo) {
-        game_utils::beginOffer(input, footer, sizeof(footer), playerInfo, currentGame);
+    screenContext.makeOffer = [this](const PlayerSelection &selection) {
+        game_utils::beginOffer(input, footer, sizeof(footer), selection, currentGame);
+    };
+    screenContext.openPlayerSearch = [this]() { changeScreen(PLAYER_SEARCH_SCREEN); };
+    screenContext.openNameSearch = [this]() { changeScreen(NAME_SEARCH_SCREEN); };
+    screenContext.scoutClub = [this](int clubIdx) {
+        changeScreen(SCOUT_SCREEN);
+        selectedDivision = clubIdx < roster_index::kIndexedClubs ? normalizedLeagueTier(getClub(clubIdx)) : 0;
+        selectedClub = clubIdx;
+    };
+    screenContext.showSimilarPlayers = [this](const PlayerSelection &selection) {
+        similarTo = selection;
+        changeScreen(SIMILAR_PLAYERS_SCREEN);
     };
+    screenContext.similarPlayersTarget = [this]() -> const PlayerSelection & { return similarTo; };
     screenContext.writeDivisionsMenu = [this](const char *heading, bool attach) {
         ui::writeDivisionsMenu(screenContext, selectedDivision, selectedClub, heading, attach);
     };
@@ -289,6 +322,9 @@ void Application::initializeScreens() {
     screens[FREE_PLAYERS_SCREEN] = std::make_unique<FreePlayersScreen>(screenContext);
     screens[MY_TEAM_SCREEN] = std::make_unique<MyTeamScreen>(screenContext);
     screens[SCOUT_SCREEN] = std::make_unique<ScoutScreen>(screenContext);
+    screens[PLAYER_SEARCH_SCREEN] = std::make_unique<PlayerSearchScreen>(screenContext);
+    screens[NAME_SEARCH_SCREEN] = std::make_unique<NameSearchScreen>(screenContext);
+    screens[SIMILAR_PLAYERS_SCREEN] = std::make_unique<SimilarPlayersScreen>(screenContext);
     screens[CHANGE_TEAM_SCREEN] = std::make_unique<ChangeTeamScreen>(screenContext);
     screens[TELEPHONE_SCREEN] = std::make_unique<TelephoneScreen>(screenContext);
     screens[CONVERT_COACH_SCREEN] = std::make_unique<ConvertCoachScreen>(screenContext);
@@ -353,11 +389,23 @@ void Application::run() {
                 } else {
                     gfx.setRightClickCursor();
                 }
+                // Each click or key press is one undo step.
+                undo_journal::beginStep();
                 input.checkClickableArea(event.button.x, event.button.y);
             } else if (event.type == SDL_MOUSEBUTTONUP) {
                 gfx.setStandardCursor();
             } else if (event.type == SDL_KEYDOWN) {
+                undo_journal::beginStep();
+                bool ctrl = (event.key.keysym.mod & KMOD_CTRL) != 0;
                 switch (event.key.keysym.sym) {
+                    case SDLK_z:
+                    case SDLK_y:
+                        if (ctrl) {
+                            undoOrRedo(event.key.keysym.sym == SDLK_z);
+                        } else {
+                            input.checkKeyPressCallback(event.key.keysym.sym);
+                        }
+                        break;
                     case SDLK_f:
                         toggleWindowed();
                         break;
@@ -369,20 +417,43 @@ void Application::run() {
                 }
             }
 
-            SDL_SetRenderTarget(renderer, texTarget);
-            SDL_RenderClear(renderer);
-
-            Application::drawCurrentScreen();
-
-            SDL_SetRenderTarget(renderer, nullptr);
-            SDL_RenderClear(renderer);
-            SDL_RenderCopyEx(renderer, texTarget, nullptr, nullptr, 0, nullptr, SDL_FLIP_NONE);
-            SDL_RenderPresent(renderer);
+            presentFrame(texTarget);
+        }
+        // Pick up saves PM3 wrote from DOSBox while we are running.
+        if (currentGame != 0 && io::reloadChangedSaves(settings, currentGame, footer, sizeof(footer))) {
+            presentFrame(texTarget);
         }
         SDL_Delay(16);
     }
 }
 
+void Application::undoOrRedo(bool undo) {
+    if (currentGame == 0) {
+        return;
+    }
+    if (undo ? undo_journal::undo() : undo_journal::redo()) {
+        roster_index::invalidate();
+        player_identity::retireAll();
+        snprintf(footer, sizeof(footer), undo ? "UNDONE" : "REDONE");
+    } else {
+        snprintf(footer, sizeof(footer), undo ? "NOTHING TO UNDO" : "NOTHING TO REDO");
+    }
+}
+
+void Application::presentFrame(SDL_Texture *texTarget) {
+    SDL_Renderer *renderer = gfx.getRenderer();
+
+    SDL_SetRenderTarget(renderer, texTarget);
+    SDL_RenderClear(renderer);
+
+    Application::drawCurrentScreen();
+
+    SDL_SetRenderTarget(renderer, nullptr);
+    SDL_RenderClear(renderer);
+    SDL_RenderCopyEx(renderer, texTarget, nullptr, nullptr, 0, nullptr, SDL_FLIP_NONE);
+    SDL_RenderPresent(renderer);
+}
+
 [[noreturn]] void Application::exitError(const std::string &errorMessage) {
     std::cout << "An error occurred: " << errorMessage << std::endl;
     exit(1);
@@ -397,6 +468,7 @@ void Application::changeScreen(screen newScreen) {
     if (newScreen != currentScreen) {
         input.resetTransientClickableAreas();
         input.resetKeyPressCallbacks();
+        input.endReadingTextInput();
         if (textRenderer) {
             text_utils::resetTextBlocks(*textRenderer);
         }
@@ -455,6 +527,10 @@ void Application::importSwosTeams() {
         return;
     }
 
+    // The globals no longer hold the loaded slot, so a later save must rewrite it whole.
+    dirty_tracker::markAll();
+    roster_index::invalidate();
+    player_identity::retireAll();
     try {
         io::loadDefaultGamedata(settings.gamePath, gameData);
         io::loadDefaultClubdata(settings.gamePath, clubData);
@@ -0,0 +1,233 @@
+// Find-as-you-type lookup of players and clubs by name: a trie for prefixes and a trigram index
+// for names typed with a mistake or two.
+#include "name_index.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <memory>
+
+#include "dirty_tracker.h"
+
+namespace name_index {
+namespace {
+std::uint32_t packTrigram(char a, char b, char c) {
+    return (static_cast<std::uint32_t>(static_cast<unsigned char>(a)) << 16) |
+           (static_cast<std::uint32_t>(static_cast<unsigned char>(b)) << 8) |
+           static_cast<unsigned char>(c);
+}
+
+// Trigrams of each word, padded at the start only so a prefix shares the trigrams of the word.
+template <typename Callback>
+void forEachTrigram(std::string_view text, Callback callback) {
+    std::size_t start = 0;
+    while (start < text.size()) {
+        std::size_t end = text.find(' ', start);
+        if (end == std::string_view::npos) {
+            end = text.size();
+        }
+        char previous2 = ' ';
+        char previous1 = ' ';
+        for (std::size_t i = start; i < end; ++i) {
+            callback(packTrigram(previous2, previous1, text[i]));
+            previous2 = previous1;
+            previous1 = text[i];
+        }
+        start = end + 1;
+    }
+}
+
+// The name from each word on, shortest suffix last.
+template <typename Callback>
+void forEachWordStart(std::string_view name, Callback callback) {
+    for (std::size_t i = 0; i < name.size(); ++i) {
+        if (i == 0 || name[i - 1] == ' ') {
+            callback(name.substr(i));
+        }
+    }
+}
+} // namespace
+
+std::string normalize(const char *name, std::size_t size) {
+    std::string result;
+    std::size_t length = strnlen(name, size);
+    for (std::size_t i = 0; i < length; ++i) {
+        auto c = static_cast<unsigned char>(name[i]);
+        if (std::isalnum(c)) {
+            result += static_cast<char>(std::toupper(c));
+        } else if (!result.empty() && result.back() != ' ') {
+            result += ' ';
+        }
+    }
+    if (!result.empty() && result.back() == ' ') {
+        result.pop_back();
+    }
+    return result;
+}
+
+int prefixDistance(std::string_view query, std::string_view text) {
+    // Rows over the query; the last row's minimum is the distance to the closest prefix.
+    std::vector<int> row(text.size() + 1);
+    for (std::size_t j = 0; j <= text.size(); ++j) {
+        row[j] = static_cast<int>(j);
+    }
+    for (std::size_t i = 1; i <= query.size(); ++i) {
+        int diagonal = row[0];
+        row[0] = static_cast<int>(i);
+        for (std::size_t j = 1; j <= text.size(); ++j) {
+            int above = row[j];
+            row[j] = std::min({above + 1, row[j - 1] + 1, diagonal + (query[i - 1] == text[j - 1] ? 0 : 1)});
+            diagonal = above;
+        }
+    }
+    return *std::min_element(row.begin(), row.end());
+}
+
+Index::Index(const gamec &players, const gameb &clubs) {
+    for (int16_t idx = 0; idx < static_cast<int16_t>(std::size(players.player)); ++idx) {
+        add(Kind::Player, idx, players.player[idx].name, sizeof(players.player[idx].name));
+    }
+    for (int16_t idx = 0; idx < static_cast<int16_t>(std::size(clubs.club)); ++idx) {
+        add(Kind::Club, idx, clubs.club[idx].name, sizeof(clubs.club[idx].name));
+    }
+
+    std::sort(keys.begin(), keys.end(), [](const Key &a, const Key &b) {
+        return a.text != b.text ? a.text < b.text : a.entry < b.entry;
+    });
+    nodes.push_back({0, 0, 0, 0, static_cast<std::uint32_t>(keys.size())});
+    addChildren(0, 0);
+
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+}
+
+void Index::add(Kind kind, int16_t index, const char *name, std::size_t size) {
+    std::string normalized = normalize(name, size);
+    if (normalized.empty()) {
+        return;
+    }
+    auto entry = static_cast<std::uint32_t>(entries.size());
+    forEachWordStart(normalized, [&](std::string_view suffix) { keys.push_back({std::string(suffix), entry}); });
+    forEachTrigram(normalized, [&](std::uint32_t trigram) { trigrams.emplace_back(trigram, entry); });
+    entries.push_back({kind, index, std::move(normalized)});
+}
+
+void Index::addChildren(std::uint32_t node, std::size_t depth) {
+    std::uint32_t begin = nodes[node].begin;
+    std::uint32_t end = nodes[node].end;
+    // Keys that end here sort before their extensions.
+    while (begin < end && keys[begin].text.size() <= depth) {
+        ++begin;
+    }
+
+    std::uint32_t previous = 0;
+    while (begin < end) {
+        char label = keys[begin].text[depth];
+        std::uint32_t groupEnd = begin;
+        while (groupEnd < end && keys[groupEnd].text[depth] == label) {
+            ++groupEnd;
+        }
+
+        auto child = static_cast<std::uint32_t>(nodes.size());
+        nodes.push_back({label, 0, 0, begin, groupEnd});
+        if (previous != 0) {
+            nodes[previous].nextSibling = child;
+        } else {
+            nodes[node].firstChild = child;
+        }
+        previous = child;
+        addChildren(child, depth + 1);
+        begin = groupEnd;
+    }
+}
+
+const Index::Node *Index::findPrefix(std::string_view prefix) const {
+    std::uint32_t node = 0;
+    for (char c : prefix) {
+        std::uint32_t child = nodes[node].firstChild;
+        while (child != 0 && nodes[child].label != c) {
+            child = nodes[child].nextSibling;
+        }
+        if (child == 0) {
+            return nullptr;
+        }
+        node = child;
+    }
+    return &nodes[node];
+}
+
+std::vector<Match> Index::find(std::string_view query, std::size_t limit) const {
+    std::vector<Match> matches;
+    std::string normalized = normalize(query.data(), query.size());
+    if (normalized.empty() || limit == 0) {
+        return matches;
+    }
+
+    std::vector<bool> seen(entries.size());
+    if (const Node *node = findPrefix(normalized)) {
+        for (std::uint32_t i = node->begin; i < node->end && matches.size() < limit; ++i) {
+            std::uint32_t entry = keys[i].entry;
+            if (!seen[entry]) {
+                seen[entry] = true;
+                matches.push_back({entries[entry].kind, entries[entry].index, 0});
+            }
+        }
+    }
+    if (matches.size() >= limit || normalized.size() < 3) {
+        return matches;
+    }
+
+    // Each edit spoils at most three trigrams, so candidates must share the rest.
+    int maxEdits = normalized.size() < 5 ? 1 : 2;
+    std::vector<std::uint32_t> queryTrigrams;
+    forEachTrigram(normalized, [&](std::uint32_t trigram) { queryTrigrams.push_back(trigram); });
+    std::sort(queryTrigrams.begin(), queryTrigrams.end());
+    queryTrigrams.erase(std::unique(queryTrigrams.begin(), queryTrigrams.end()), queryTrigrams.end());
+    int needed = std::max(1, static_cast<int>(queryTrigrams.size()) - 3 * maxEdits);
+
+    std::vector<std::uint8_t> shared(entries.size());
+    std::vector<std::uint32_t> candidates;
+    for (std::uint32_t trigram : queryTrigrams) {
+        auto [first, last] = std::equal_range(trigrams.begin(), trigrams.end(), std::make_pair(trigram, 0u),
+                                              [](const auto &a, const auto &b) { return a.first < b.first; });
+        for (auto it = first; it != last; ++it) {
+            if (!seen[it->second] && ++shared[it->second] == needed) {
+                candidates.push_back(it->second);
+            }
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+    std::vector<Match> fuzzy;
+    for (std::uint32_t entry : candidates) {
+        int best = maxEdits + 1;
+        forEachWordStart(entries[entry].name, [&](std::string_view suffix) {
+            best = std::min(best, prefixDistance(normalized, suffix));
+        });
+        if (best <= maxEdits) {
+            fuzzy.push_back({entries[entry].kind, entries[entry].index, best});
+        }
+    }
+    std::stable_sort(fuzzy.begin(), fuzzy.end(), [](const Match &a, const Match &b) {
+        return a.distance < b.distance;
+    });
+    for (const Match &match : fuzzy) {
+        if (matches.size() >= limit) {
+            break;
+        }
+        matches.push_back(match);
+    }
+    return matches;
+}
+
+const Index &live() {
+    static std::unique_ptr<Index> index;
+    static std::uint64_t generation = 0;
+    if (!index || generation != dirty_tracker::generation()) {
+        index = std::make_unique<Index>(playerData, clubData);
+        generation = dirty_tracker::generation();
+    }
+    return *index;
+}
+
+} // namespace name_index
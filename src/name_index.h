@@ -0,0 +1,79 @@
+// Find-as-you-type lookup of players and clubs by name: a trie for prefixes and a trigram index
+// for names typed with a mistake or two.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "pm3_data.h"
+
+namespace name_index {
+
+enum class Kind : std::uint8_t {
+    Player,
+    Club,
+};
+
+struct Match {
+    Kind kind;
+    int16_t index;  // into gamec::player or gameb::club
+    int distance;   // 0 for a prefix of a word in the name, else the edits to get one
+};
+
+// Upper case, with anything but letters and digits turned into single spaces. Names in the saves
+// are fixed-size fields, so the size bounds the read.
+std::string normalize(const char *name, std::size_t size);
+
+// Edits needed to turn `query` into some prefix of `text`.
+int prefixDistance(std::string_view query, std::string_view text);
+
+class Index {
+public:
+    Index(const gamec &players, const gameb &clubs);
+
+    // Names with a word starting with the query first, alphabetically from that word; then, for
+    // queries of three or more characters, names with a word one edit away (two from five
+    // characters on), closest first. Players come before clubs among equals. At most `limit`.
+    std::vector<Match> find(std::string_view query, std::size_t limit) const;
+
+private:
+    struct Entry {
+        Kind kind;
+        int16_t index;
+        std::string name;
+    };
+
+    // One key per word of a name: the name from that word on.
+    struct Key {
+        std::string text;
+        std::uint32_t entry;
+    };
+
+    // Every node covers the keys [begin, end) that share its prefix, as the keys are sorted.
+    struct Node {
+        char label = 0;
+        std::uint32_t firstChild = 0;
+        std::uint32_t nextSibling = 0;
+        std::uint32_t begin = 0;
+        std::uint32_t end = 0;
+    };
+
+    void add(Kind kind, int16_t index, const char *name, std::size_t size);
+    void addChildren(std::uint32_t node, std::size_t depth);
+    const Node *findPrefix(std::string_view prefix) const;
+
+    std::vector<Entry> entries;
+    std::vector<Key> keys;
+    std::vector<Node> nodes;
+    // (trigram, entry) pairs, sorted, for equal_range lookups.
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> trigrams;
+};
+
+// The index over playerData and clubData, rebuilt whenever dirty_tracker::generation() moves on.
+const Index &live();
+
+} // namespace name_index
@@ -0,0 +1,269 @@
+// Structure-of-arrays copy of the player attributes used for ratings, with SIMD kernels that rate
+// every player for every role in one pass.
+#include "player_attributes.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "dirty_tracker.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define PM3_PLAYER_ATTRIBUTES_X86 1
+#endif
+
+namespace player_attributes {
+namespace {
+enum Attribute {
+    Hn,
+    Tk,
+    Ps,
+    Sh,
+    Hd,
+    Cr,
+    Aggr,
+    kAttributeCount
+};
+
+struct Term {
+    Attribute attribute;
+    double weight;
+};
+
+// Terms in the order they are summed, per role in G/D/M/A order.
+constexpr Term kRoleTerms[4][6] = {
+        // Keeper: handling heavy, heading/control secondary, some tackling/passing
+        {{Hn, 0.50}, {Hd, 0.15}, {Cr, 0.15}, {Tk, 0.10}, {Ps, 0.05}, {Sh, 0.05}},
+        // Defender: tackling first, then passing, heading, control; aggression helps slightly
+        {{Tk, 0.40}, {Ps, 0.15}, {Hd, 0.15}, {Cr, 0.15}, {Sh, 0.05}, {Aggr, 0.10}},
+        // Midfielder: passing primary, then tackling/shooting, control/heading, aggression minor
+        {{Ps, 0.35}, {Tk, 0.20}, {Sh, 0.15}, {Hd, 0.10}, {Cr, 0.10}, {Aggr, 0.10}},
+        // Attacker: shooting primary, then passing/heading, control, minor tackling/aggression
+        {{Sh, 0.35}, {Ps, 0.20}, {Hd, 0.15}, {Cr, 0.10}, {Tk, 0.10}, {Aggr, 0.10}},
+};
+
+using ColumnPointers = std::array<const std::uint8_t *, kAttributeCount>;
+
+ColumnPointers columnPointers(const Columns &columns) {
+    return {columns.hn.data(), columns.tk.data(), columns.ps.data(), columns.sh.data(),
+            columns.hd.data(), columns.cr.data(), columns.aggr.data()};
+}
+
+double clampRating(double rating) {
+    return std::clamp(rating, 0.0, 99.0);
+}
+
+// G if it is at least every other rating, else D if at least M and A, else M if at least A.
+char roleFromComparisons(bool gd, bool gm, bool ga, bool dm, bool da, bool ma) {
+    if (gd && gm && ga) {
+        return 'G';
+    } else if (dm && da) {
+        return 'D';
+    } else if (ma) {
+        return 'M';
+    }
+    return 'A';
+}
+
+void rateScalar(const ColumnPointers &columns, RoleRatings &out, std::size_t first, std::size_t last) {
+    for (std::size_t i = first; i < last; ++i) {
+        for (int role = 0; role < 4; ++role) {
+            double rating = 0.0;
+            for (const Term &term : kRoleTerms[role]) {
+                rating += term.weight * columns[term.attribute][i];
+            }
+            out.rating[role][i] = clampRating(rating);
+        }
+        out.role[i] = valuationRole(out.rating[0][i], out.rating[1][i], out.rating[2][i], out.rating[3][i]);
+    }
+}
+
+#if defined(PM3_PLAYER_ATTRIBUTES_X86)
+// SSE2 is part of x86-64, so this needs no runtime check.
+std::size_t rateSse2(const ColumnPointers &columns, RoleRatings &out, std::size_t count) {
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d top = _mm_set1_pd(99.0);
+    std::size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128d values[kAttributeCount];
+        for (int a = 0; a < kAttributeCount; ++a) {
+            values[a] = _mm_cvtepi32_pd(_mm_set_epi32(0, 0, columns[a][i + 1], columns[a][i]));
+        }
+        __m128d ratings[4];
+        for (int role = 0; role < 4; ++role) {
+            __m128d sum = zero;
+            for (const Term &term : kRoleTerms[role]) {
+                sum = _mm_add_pd(sum, _mm_mul_pd(_mm_set1_pd(term.weight), values[term.attribute]));
+            }
+            ratings[role] = _mm_min_pd(_mm_max_pd(sum, zero), top);
+            _mm_storeu_pd(out.rating[role].data() + i, ratings[role]);
+        }
+
+        int gd = _mm_movemask_pd(_mm_cmpge_pd(ratings[0], ratings[1]));
+        int gm = _mm_movemask_pd(_mm_cmpge_pd(ratings[0], ratings[2]));
+        int ga = _mm_movemask_pd(_mm_cmpge_pd(ratings[0], ratings[3]));
+        int dm = _mm_movemask_pd(_mm_cmpge_pd(ratings[1], ratings[2]));
+        int da = _mm_movemask_pd(_mm_cmpge_pd(ratings[1], ratings[3]));
+        int ma = _mm_movemask_pd(_mm_cmpge_pd(ratings[2], ratings[3]));
+        for (int lane = 0; lane < 2; ++lane) {
+            int bit = 1 << lane;
+            out.role[i + lane] = roleFromComparisons(gd & bit, gm & bit, ga & bit, dm & bit, da & bit, ma & bit);
+        }
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) __m256d loadColumn(const std::uint8_t *column, std::size_t i) {
+    std::int32_t packed;
+    std::memcpy(&packed, column + i, sizeof(packed));
+    return _mm256_cvtepi32_pd(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed)));
+}
+
+__attribute__((target("avx2"))) std::size_t rateAvx2(const ColumnPointers &columns, RoleRatings &out,
+                                                     std::size_t count) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d top = _mm256_set1_pd(99.0);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d values[kAttributeCount];
+        for (int a = 0; a < kAttributeCount; ++a) {
+            values[a] = loadColumn(columns[a], i);
+        }
+        __m256d ratings[4];
+        for (int role = 0; role < 4; ++role) {
+            __m256d sum = zero;
+            for (const Term &term : kRoleTerms[role]) {
+                sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(term.weight), values[term.attribute]));
+            }
+            ratings[role] = _mm256_min_pd(_mm256_max_pd(sum, zero), top);
+            _mm256_storeu_pd(out.rating[role].data() + i, ratings[role]);
+        }
+
+        int gd = _mm256_movemask_pd(_mm256_cmp_pd(ratings[0], ratings[1], _CMP_GE_OQ));
+        int gm = _mm256_movemask_pd(_mm256_cmp_pd(ratings[0], ratings[2], _CMP_GE_OQ));
+        int ga = _mm256_movemask_pd(_mm256_cmp_pd(ratings[0], ratings[3], _CMP_GE_OQ));
+        int dm = _mm256_movemask_pd(_mm256_cmp_pd(ratings[1], ratings[2], _CMP_GE_OQ));
+        int da = _mm256_movemask_pd(_mm256_cmp_pd(ratings[1], ratings[3], _CMP_GE_OQ));
+        int ma = _mm256_movemask_pd(_mm256_cmp_pd(ratings[2], ratings[3], _CMP_GE_OQ));
+        for (int lane = 0; lane < 4; ++lane) {
+            int bit = 1 << lane;
+            out.role[i + lane] = roleFromComparisons(gd & bit, gm & bit, ga & bit, dm & bit, da & bit, ma & bit);
+        }
+    }
+    return i;
+}
+#endif
+} // namespace
+
+Columns extract(const gamec &players) {
+    constexpr std::size_t count = sizeof(gamec) / sizeof(PlayerRecord);
+    Columns columns;
+    for (auto *column : {&columns.hn, &columns.tk, &columns.ps, &columns.sh, &columns.hd, &columns.cr, &columns.ft,
+                         &columns.aggr, &columns.age}) {
+        column->resize(count);
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        const PlayerRecord &player = players.player[i];
+        columns.hn[i] = player.hn;
+        columns.tk[i] = player.tk;
+        columns.ps[i] = player.ps;
+        columns.sh[i] = player.sh;
+        columns.hd[i] = player.hd;
+        columns.cr[i] = player.cr;
+        columns.ft[i] = player.ft;
+        columns.aggr[i] = player.aggr;
+        columns.age[i] = player.age;
+    }
+    return columns;
+}
+
+const Columns &live() {
+    static Columns columns;
+    static std::uint64_t generation = 0;
+    if (generation != dirty_tracker::generation()) {
+        columns = extract(playerData);
+        generation = dirty_tracker::generation();
+    }
+    return columns;
+}
+
+bool kernelSupported(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::Scalar:
+            return true;
+#if defined(PM3_PLAYER_ATTRIBUTES_X86)
+        case Kernel::Sse2:
+            return true;
+        case Kernel::Avx2: {
+            static const bool supported = __builtin_cpu_supports("avx2");
+            return supported;
+        }
+#endif
+        default:
+            return false;
+    }
+}
+
+Kernel bestKernel() {
+    if (kernelSupported(Kernel::Avx2)) {
+        return Kernel::Avx2;
+    }
+    return kernelSupported(Kernel::Sse2) ? Kernel::Sse2 : Kernel::Scalar;
+}
+
+void rateRoles(const Columns &columns, RoleRatings &out, Kernel kernel) {
+    std::size_t count = columns.size();
+    for (auto &ratings : out.rating) {
+        ratings.resize(count);
+    }
+    out.role.resize(count);
+    if (!kernelSupported(kernel)) {
+        kernel = Kernel::Scalar;
+    }
+
+    ColumnPointers pointers = columnPointers(columns);
+    std::size_t done = 0;
+#if defined(PM3_PLAYER_ATTRIBUTES_X86)
+    if (kernel == Kernel::Avx2) {
+        done = rateAvx2(pointers, out, count);
+    } else if (kernel == Kernel::Sse2) {
+        done = rateSse2(pointers, out, count);
+    }
+#endif
+    rateScalar(pointers, out, done, count);
+}
+
+const RoleRatings &liveRatings() {
+    static RoleRatings ratings;
+    static std::uint64_t generation = 0;
+    if (generation != dirty_tracker::generation()) {
+        rateRoles(live(), ratings);
+        generation = dirty_tracker::generation();
+    }
+    return ratings;
+}
+
+int roleIndex(char role) {
+    switch (role) {
+        case 'G': return 0;
+        case 'D': return 1;
+        case 'M': return 2;
+        default: return 3;
+    }
+}
+
+double roleRating(char role, const PlayerRecord &player) {
+    const std::uint8_t values[kAttributeCount] = {player.hn, player.tk, player.ps, player.sh,
+                                                   player.hd, player.cr, player.aggr};
+    double rating = 0.0;
+    for (const Term &term : kRoleTerms[roleIndex(role)]) {
+        rating += term.weight * values[term.attribute];
+    }
+    return clampRating(rating);
+}
+
+char valuationRole(double gk, double def, double mid, double att) {
+    return roleFromComparisons(gk >= def, gk >= mid, gk >= att, def >= mid, def >= att, mid >= att);
+}
+
+} // namespace player_attributes
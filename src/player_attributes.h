@@ -0,0 +1,55 @@
+// Structure-of-arrays copy of the player attributes used for ratings, with SIMD kernels that rate
+// every player for every role in one pass.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "pm3_data.h"
+
+namespace player_attributes {
+
+// One column per attribute, indexed like gamec.
+struct Columns {
+    std::vector<std::uint8_t> hn, tk, ps, sh, hd, cr, ft, aggr, age;
+
+    std::size_t size() const { return hn.size(); }
+};
+
+Columns extract(const gamec &players);
+
+// Columns for playerData, extracted again whenever dirty_tracker::generation() has moved on.
+const Columns &live();
+
+// Role ratings in G/D/M/A order (see roleIndex) and the valuation role for each player.
+struct RoleRatings {
+    std::array<std::vector<double>, 4> rating;
+    std::vector<char> role;
+};
+
+enum class Kernel {
+    Scalar,
+    Sse2,
+    Avx2,
+};
+
+// The fastest kernel this CPU runs.
+Kernel bestKernel();
+bool kernelSupported(Kernel kernel);
+
+// Every kernel gives bit-identical results to roleRating/valuationRole: the weighted sums are
+// evaluated term by term in the same order, without fused multiply-adds.
+void rateRoles(const Columns &columns, RoleRatings &out, Kernel kernel = bestKernel());
+
+// rateRoles over live(), cached per generation.
+const RoleRatings &liveRatings();
+
+int roleIndex(char role);
+// The weighted role rating of one player, clamped to 0-99. The scalar reference for the kernels.
+double roleRating(char role, const PlayerRecord &player);
+// The role with the highest rating; ties go to the earlier of G, D, M, A.
+char valuationRole(double gk, double def, double mid, double att);
+
+} // namespace player_attributes
@@ -0,0 +1,133 @@
+// Player handles for the loaded save, and identity keys for finding the same player again in
+// another save or season.
+#include "player_identity.h"
+
+#include <array>
+#include <cstring>
+
+namespace player_identity {
+namespace {
+constexpr int kPlayers = static_cast<int>(sizeof(gamec) / sizeof(PlayerRecord));
+
+// Starts at 1 so a default-constructed handle never resolves.
+std::array<std::uint32_t, kPlayers> makeGenerations() {
+    std::array<std::uint32_t, kPlayers> generations{};
+    generations.fill(1);
+    return generations;
+}
+
+std::array<std::uint32_t, kPlayers> gGenerations = makeGenerations();
+
+class Fnv {
+public:
+    void add(const void *data, std::size_t size) {
+        const auto *bytes = static_cast<const std::uint8_t *>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+        }
+    }
+
+    void add(std::uint8_t value) { add(&value, 1); }
+
+    std::uint64_t value() const { return hash; }
+
+private:
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+};
+
+void addName(Fnv &fnv, const PlayerRecord &player) {
+    fnv.add(player.name, strnlen(player.name, sizeof(player.name)));
+}
+
+bool sameName(const PlayerRecord &a, const PlayerRecord &b) {
+    return strncmp(a.name, b.name, sizeof(a.name)) == 0 && a.foot == b.foot;
+}
+
+bool sameIdentity(const PlayerRecord &a, const PlayerRecord &b) {
+    return sameName(a, b) && a.age == b.age && a.hn == b.hn && a.tk == b.tk && a.ps == b.ps && a.sh == b.sh &&
+           a.hd == b.hd && a.cr == b.cr;
+}
+} // namespace
+
+PlayerHandle handleFor(int16_t index) {
+    if (index < 0 || index >= kPlayers) {
+        return {};
+    }
+    return {index, gGenerations[index]};
+}
+
+int16_t resolve(const PlayerHandle &handle) {
+    if (handle.index < 0 || handle.index >= kPlayers || gGenerations[handle.index] != handle.generation) {
+        return -1;
+    }
+    return handle.index;
+}
+
+void retire(int16_t index) {
+    if (index >= 0 && index < kPlayers) {
+        ++gGenerations[index];
+    }
+}
+
+void retireAll() {
+    for (auto &generation : gGenerations) {
+        ++generation;
+    }
+}
+
+std::uint64_t identityKey(const PlayerRecord &player) {
+    Fnv fnv;
+    addName(fnv, player);
+    fnv.add(static_cast<std::uint8_t>(player.age));
+    fnv.add(static_cast<std::uint8_t>(player.foot));
+    for (std::uint8_t skill : {player.hn, player.tk, player.ps, player.sh, player.hd, player.cr}) {
+        fnv.add(skill);
+    }
+    return fnv.value();
+}
+
+std::uint64_t nameKey(const PlayerRecord &player) {
+    Fnv fnv;
+    addName(fnv, player);
+    fnv.add(static_cast<std::uint8_t>(player.foot));
+    return fnv.value();
+}
+
+IdentityMap::IdentityMap(const gamec &players) : players(players) {
+    exact.reserve(kPlayers);
+    byName.reserve(kPlayers);
+    for (int16_t idx = 0; idx < kPlayers; ++idx) {
+        const PlayerRecord &player = players.player[idx];
+        exact.emplace(identityKey(player), idx);
+        byName.emplace(nameKey(player), idx);
+    }
+}
+
+int16_t IdentityMap::find(const PlayerRecord &player) const {
+    // Identical records are possible (unused slots); the lowest index wins, as with a scan.
+    int16_t exactMatch = -1;
+    auto [first, last] = exact.equal_range(identityKey(player));
+    for (auto it = first; it != last; ++it) {
+        if (sameIdentity(players.player[it->second], player) && (exactMatch == -1 || it->second < exactMatch)) {
+            exactMatch = it->second;
+        }
+    }
+    if (exactMatch != -1) {
+        return exactMatch;
+    }
+
+    int16_t match = -1;
+    auto [nameFirst, nameLast] = byName.equal_range(nameKey(player));
+    for (auto it = nameFirst; it != nameLast; ++it) {
+        if (!sameName(players.player[it->second], player)) {
+            continue;
+        }
+        if (match != -1) {
+            return -1; // ambiguous
+        }
+        match = it->second;
+    }
+    return match;
+}
+
+} // namespace player_identity
@@ -0,0 +1,45 @@
+// Player handles for the loaded save, and identity keys for finding the same player again in
+// another save or season.
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "pm3_data.h"
+
+namespace player_identity {
+
+// Handle to the player at `index` as the record stands now.
+PlayerHandle handleFor(int16_t index);
+
+// The handle's index, or -1 if it is out of range or the record has been retired since.
+int16_t resolve(const PlayerHandle &handle);
+
+// The record at `index` now holds a different player (e.g. a youth player after a coach conversion).
+void retire(int16_t index);
+
+// playerData was replaced (load, reload from disk, undo, import); every handle goes stale.
+void retireAll();
+
+// Hash of name, age, foot and skill ratings: equal keys mean the same player at the same point.
+std::uint64_t identityKey(const PlayerRecord &player);
+// Hash of name and foot only, which survive ageing and training between seasons.
+std::uint64_t nameKey(const PlayerRecord &player);
+
+// Looks players of one gamec up by identity. Build it once per lookup batch; it does not follow
+// later edits to the records.
+class IdentityMap {
+public:
+    explicit IdentityMap(const gamec &players);
+
+    // The exact identity match if there is one, else the only player with the same name and foot,
+    // else -1.
+    int16_t find(const PlayerRecord &player) const;
+
+private:
+    std::unordered_multimap<std::uint64_t, int16_t> exact;
+    std::unordered_multimap<std::uint64_t, int16_t> byName;
+    const gamec &players;
+};
+
+} // namespace player_identity
@@ -0,0 +1,154 @@
+// Multi-criteria player search over bitmap indexes of the squad players, so a query is a handful
+// of word-wise ANDs instead of a pass over every record.
+#include "player_search.h"
+
+#include <algorithm>
+#include <bitset>
+#include <memory>
+
+#include "dirty_tracker.h"
+#include "game_utils.h"
+#include "player_attributes.h"
+#include "roster_index.h"
+
+namespace player_search {
+
+std::size_t Bitmap::count() const {
+    std::size_t total = 0;
+    for (std::uint64_t word : words) {
+        total += std::bitset<64>(word).count();
+    }
+    return total;
+}
+
+Bitmap &Bitmap::operator&=(const Bitmap &other) {
+    for (std::size_t i = 0; i < kWords; ++i) {
+        words[i] &= other.words[i];
+    }
+    return *this;
+}
+
+Bitmap &Bitmap::operator|=(const Bitmap &other) {
+    for (std::size_t i = 0; i < kWords; ++i) {
+        words[i] |= other.words[i];
+    }
+    return *this;
+}
+
+Bitmap &Bitmap::andNot(const Bitmap &other) {
+    for (std::size_t i = 0; i < kWords; ++i) {
+        words[i] &= ~other.words[i];
+    }
+    return *this;
+}
+
+std::vector<int16_t> Bitmap::indices() const {
+    std::vector<int16_t> result;
+    for (std::size_t i = 0; i < kWords; ++i) {
+        for (std::uint64_t word = words[i]; word != 0; word &= word - 1) {
+            int bit = 0;
+            while (((word >> bit) & 1) == 0) {
+                ++bit;
+            }
+            result.push_back(static_cast<int16_t>(i * 64 + bit));
+        }
+    }
+    return result;
+}
+
+void Index::Levels::add(int idx, int value) {
+    value = std::clamp(value, 0, static_cast<int>(atLeast.size()) - 2);
+    for (int level = 0; level <= value; ++level) {
+        atLeast[level].set(idx);
+    }
+}
+
+Bitmap Index::Levels::range(int min, int max) const {
+    int top = static_cast<int>(atLeast.size()) - 1;
+    min = std::clamp(min, 0, top);
+    max = std::clamp(max, -1, top - 1);
+    if (min > max) {
+        return {};
+    }
+    Bitmap result = atLeast[min];
+    return result.andNot(atLeast[max + 1]);
+}
+
+Index::Index(const gamec &players, const gameb &clubs) {
+    clubOf.fill(-1);
+    for (int clubIdx = 0; clubIdx < roster_index::kIndexedClubs; ++clubIdx) {
+        const ClubRecord &club = clubs.club[clubIdx];
+        int division = normalizedLeagueTier(club);
+        for (int slot = 0; slot < roster_index::kSquadSlots; ++slot) {
+            int16_t idx = club.player_index[slot];
+            if (idx < 0 || idx >= kPlayers || clubOf[idx] != -1) {
+                continue;
+            }
+            clubOf[idx] = static_cast<int16_t>(clubIdx);
+            placed.set(idx);
+
+            PlayerRecord player = players.player[idx];
+            roles[player_attributes::roleIndex(determinePlayerType(player))].set(idx);
+            feet[player.foot].set(idx);
+            if (player.period > 0) {
+                periodTypes[player.period_type].set(idx);
+            }
+            ages.add(idx, player.age);
+            ratings.add(idx, determinePlayerRating(player));
+            contracts.add(idx, player.contract);
+            divisions.add(idx, division);
+        }
+    }
+}
+
+Bitmap Index::match(const Query &query) const {
+    Bitmap result = placed;
+    if (!query.roles.empty()) {
+        Bitmap anyRole;
+        static constexpr char kRoles[] = {'G', 'D', 'M', 'A'};
+        for (int i = 0; i < 4; ++i) {
+            if (query.roles.find(kRoles[i]) != std::string::npos) {
+                anyRole |= roles[i];
+            }
+        }
+        result &= anyRole;
+    }
+    if (query.foot >= 0) {
+        result &= query.foot < static_cast<int>(feet.size()) ? feet[query.foot] : Bitmap{};
+    }
+    result &= ages.range(query.minAge, query.maxAge);
+    result &= ratings.range(query.minRating, query.maxRating);
+    result &= contracts.range(query.minContract, query.maxContract);
+    result &= divisions.range(query.minDivision, query.maxDivision);
+    for (std::size_t type = 0; type < periodTypes.size(); ++type) {
+        if ((query.excludedPeriodTypes >> type) & 1) {
+            result.andNot(periodTypes[type]);
+        }
+    }
+    return result;
+}
+
+std::vector<PlayerRow> Index::rows(const Bitmap &matches) const {
+    std::vector<PlayerRow> result;
+    for (int16_t idx : matches.indices()) {
+        result.push_back({clubOf[idx], idx});
+    }
+    return result;
+}
+
+const Index &live() {
+    static std::unique_ptr<Index> index;
+    static std::uint64_t generation = 0;
+    if (!index || generation != dirty_tracker::generation()) {
+        index = std::make_unique<Index>(playerData, clubData);
+        generation = dirty_tracker::generation();
+    }
+    return *index;
+}
+
+std::vector<PlayerRow> search(const Query &query) {
+    const Index &index = live();
+    return index.rows(index.match(query));
+}
+
+} // namespace player_search
@@ -0,0 +1,94 @@
+// Multi-criteria player search over bitmap indexes of the squad players, so a query is a handful
+// of word-wise ANDs instead of a pass over every record.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "pm3_data.h"
+#include "pm3_defs.hh"
+
+namespace player_search {
+
+inline constexpr int kPlayers = static_cast<int>(sizeof(gamec) / sizeof(PlayerRecord));
+
+// period_type values (see periodTypes) for which a player with a non-zero period is injured.
+inline constexpr std::uint32_t kInjuryPeriodTypes = ((1u << 18) - 1) & ~3u;
+inline constexpr std::uint32_t kAllPeriodTypes = 0xffffffffu;
+
+// One bit per player index. At 3932 players a plain bitmap is 62 words, so there is nothing to
+// gain from compressing it.
+class Bitmap {
+public:
+    static constexpr std::size_t kWords = (kPlayers + 63) / 64;
+
+    void set(int idx) { words[idx / 64] |= std::uint64_t{1} << (idx % 64); }
+    bool test(int idx) const { return (words[idx / 64] >> (idx % 64)) & 1; }
+    std::size_t count() const;
+
+    Bitmap &operator&=(const Bitmap &other);
+    Bitmap &operator|=(const Bitmap &other);
+    Bitmap &andNot(const Bitmap &other);
+
+    // Set player indices in ascending order.
+    std::vector<int16_t> indices() const;
+
+    std::array<std::uint64_t, kWords> words{};
+};
+
+// Every range is inclusive and clamped to what the field can hold. The defaults match everyone.
+struct Query {
+    std::string roles;       // any of G, D, M, A (as determinePlayerType); empty matches every role
+    int minAge = 0;
+    int maxAge = 63;
+    int minRating = 0;       // determinePlayerRating
+    int maxRating = 99;
+    int minContract = 0;     // seasons left
+    int maxContract = 7;
+    int foot = -1;           // index into footShortLabels, -1 for any
+    int minDivision = 0;     // 0 = Premier League ... 4 = Conference League
+    int maxDivision = 4;
+    // Drops players whose period is running with one of these period types (bit n = type n).
+    std::uint32_t excludedPeriodTypes = 0;
+};
+
+class Index {
+public:
+    // Indexes the players in the squads of the league clubs. A player listed twice counts for the
+    // first club, in club then slot order.
+    Index(const gamec &players, const gameb &clubs);
+
+    Bitmap match(const Query &query) const;
+    // The rows for a match in player index order, ready for writePlayers.
+    std::vector<PlayerRow> rows(const Bitmap &matches) const;
+
+private:
+    // atLeast[v] holds the players whose value is v or more; a range is one AND NOT.
+    struct Levels {
+        std::vector<Bitmap> atLeast;
+
+        explicit Levels(int count) : atLeast(static_cast<std::size_t>(count) + 1) {}
+        void add(int idx, int value);
+        Bitmap range(int min, int max) const;
+    };
+
+    Bitmap placed;
+    std::array<Bitmap, 4> roles;
+    std::array<Bitmap, 4> feet;
+    std::array<Bitmap, 32> periodTypes;
+    Levels ages{64};
+    Levels ratings{100};
+    Levels contracts{8};
+    Levels divisions{5};
+    std::array<int16_t, kPlayers> clubOf{};
+};
+
+// The index over playerData and clubData, rebuilt whenever dirty_tracker::generation() moves on.
+const Index &live();
+
+std::vector<PlayerRow> search(const Query &query);
+
+} // namespace player_search
@@ -793,9 +793,41 @@ struct prefs {
     } __attribute__ ((packed)) audio;
 } __attribute__ ((packed));
 
-struct club_player {
-    ClubRecord club;
-    PlayerRecord player;
+// A player in the loaded gamec. The generation changes when the record at that index stops being
+// the same player (another save is loaded, the player is turned into a coach), so a stale handle is
+// noticed instead of quietly pointing at someone else. See player_identity.h.
+struct PlayerHandle {
+    int16_t index = -1;
+    uint32_t generation = 0;
+};
+
+// One row of a player listing: indices into clubData and playerData, read live when drawn, so a
+// listing never shows a record as it was before an edit.
+struct PlayerRow {
+    int16_t club;
+    int16_t player;
+};
+
+// A page of a listing, pointing into the vector that owns the rows.
+struct PlayerRowSpan {
+    const PlayerRow *first = nullptr;
+    std::size_t count = 0;
+
+    PlayerRowSpan() = default;
+    PlayerRowSpan(const std::vector<PlayerRow> &rows) : first(rows.data()), count(rows.size()) {}
+    PlayerRowSpan(const PlayerRow *first, std::size_t count) : first(first), count(count) {}
+
+    const PlayerRow *begin() const { return first; }
+    const PlayerRow *end() const { return first + count; }
+    bool empty() const { return count == 0; }
+    std::size_t size() const { return count; }
+
+    // Rows [offset, offset + length), clipped to the span.
+    PlayerRowSpan subspan(std::size_t offset, std::size_t length) const {
+        offset = offset < count ? offset : count;
+        length = length < count - offset ? length : count - offset;
+        return {first + offset, length};
+    }
 };
 
 #endif // PM3000_PM3_DEFS_HH
@@ -0,0 +1,93 @@
+// Resolved description of a PM3 folder: game type, saves folder and slot file paths.
+#include "pm3_installation.h"
+
+#include <mutex>
+#include <string>
+#include <system_error>
+
+#include "folder_watch.h"
+
+namespace io {
+namespace {
+struct InstallationCache {
+    std::mutex mutex;
+    std::shared_ptr<const Pm3Installation> current;
+    FolderWatch gameFolderWatch;
+    FolderWatch savesFolderWatch;
+};
+
+InstallationCache &cache() {
+    static InstallationCache instance;
+    return instance;
+}
+
+void detectGameType(Pm3Installation &installation) {
+    std::error_code ec;
+    if (std::filesystem::exists(installation.gamePath / kExeStandardFilename, ec)) {
+        installation.gameType = Pm3GameType::Standard;
+        installation.savesFolder = installation.gamePath / kStandardSavesPath;
+    } else if (std::filesystem::exists(installation.gamePath / kExeDeluxeFilename, ec)) {
+        installation.gameType = Pm3GameType::Deluxe;
+        installation.savesFolder = installation.gamePath / kDeluxeSavesPath;
+    }
+}
+
+void findSlots(Pm3Installation &installation) {
+    std::error_code ec;
+    for (int slot = 0; slot < kSaveSlotCount; ++slot) {
+        bool present = true;
+        for (int letter = 0; letter < 3; ++letter) {
+            auto &path = installation.slotFiles[slot][letter];
+            path = installation.savesFolder /
+                   (std::string{kGameFilePrefix} + std::to_string(slot + 1) + static_cast<char>('A' + letter));
+            present = present && std::filesystem::exists(path, ec);
+        }
+        installation.presentSlots.set(slot, present);
+    }
+}
+} // namespace
+
+std::shared_ptr<const Pm3Installation> resolveInstallation(const std::filesystem::path &gamePath) {
+    InstallationCache &state = cache();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    bool stale = !state.current || state.current->gamePath != gamePath;
+    if (!stale) {
+        // Poll both watches so neither keeps stale events queued.
+        bool gameFolderChanged = state.gameFolderWatch.poll();
+        bool savesFolderChanged = state.savesFolderWatch.poll();
+        stale = gameFolderChanged || savesFolderChanged;
+    }
+    if (!stale) {
+        return state.current;
+    }
+
+    // Each watch is armed before the folder it covers is examined, so no change is missed.
+    if (!state.current || state.current->gamePath != gamePath) {
+        state.gameFolderWatch = gamePath.empty() ? FolderWatch() : FolderWatch(gamePath);
+    }
+    auto installation = std::make_shared<Pm3Installation>();
+    installation->gamePath = gamePath;
+    detectGameType(*installation);
+    if (installation->valid()) {
+        if (state.savesFolderWatch.folder() != installation->savesFolder) {
+            state.savesFolderWatch = FolderWatch(installation->savesFolder);
+        }
+        findSlots(*installation);
+    } else {
+        state.savesFolderWatch = FolderWatch();
+    }
+
+    state.current = std::move(installation);
+    return state.current;
+}
+
+void invalidateInstallation() {
+    InstallationCache &state = cache();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.current.reset();
+    state.gameFolderWatch = FolderWatch();
+    state.savesFolderWatch = FolderWatch();
+}
+
+} // namespace io
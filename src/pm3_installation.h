@@ -0,0 +1,32 @@
+// Resolved description of a PM3 folder: game type, saves folder and slot file paths.
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <filesystem>
+#include <memory>
+
+#include "pm3_defs.hh"
+
+namespace io {
+
+inline constexpr int kSaveSlotCount = 8;
+
+struct Pm3Installation {
+    std::filesystem::path gamePath;
+    Pm3GameType gameType = Pm3GameType::Unknown;
+    std::filesystem::path savesFolder;
+    // slotFiles[gameNumber - 1][letter - 'A'] for GAMEnA/B/C.
+    std::array<std::array<std::filesystem::path, 3>, kSaveSlotCount> slotFiles;
+    // Slots whose three files all exist.
+    std::bitset<kSaveSlotCount> presentSlots;
+
+    bool valid() const { return gameType != Pm3GameType::Unknown; }
+};
+
+// Stats the folder once and caches the result. Later calls for the same folder are served from
+// the cache until a watch on the PM3 and saves folders reports a change. Thread-safe.
+std::shared_ptr<const Pm3Installation> resolveInstallation(const std::filesystem::path &gamePath);
+void invalidateInstallation();
+
+} // namespace io
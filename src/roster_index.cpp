@@ -0,0 +1,134 @@
+// Reverse index from player to the club squad slot that holds them, so lookups do not walk every
+// club's player_index table.
+#include "roster_index.h"
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+
+namespace roster_index {
+namespace {
+constexpr int kPlayers = static_cast<int>(sizeof(gamec) / sizeof(PlayerRecord));
+
+std::array<Placement, kPlayers> gPlacements;
+// How many indexed slots list each player; above one only in squads that list someone twice.
+std::array<std::uint16_t, kPlayers> gSlotCounts;
+bool gBuilt = false;
+
+bool validPlayer(int16_t idx) {
+    return idx >= 0 && idx < kPlayers;
+}
+
+bool before(const Placement &a, const Placement &b) {
+    return b.club == -1 || a.club < b.club || (a.club == b.club && a.slot < b.slot);
+}
+
+std::array<Placement, kPlayers> scan() {
+    std::array<Placement, kPlayers> placements{};
+    for (int clubIdx = 0; clubIdx < kIndexedClubs; ++clubIdx) {
+        const ClubRecord &club = clubData.club[clubIdx];
+        for (int slot = 0; slot < kSquadSlots; ++slot) {
+            int16_t idx = club.player_index[slot];
+            if (validPlayer(idx) && placements[idx].club == -1) {
+                placements[idx] = {clubIdx, slot};
+            }
+        }
+    }
+    return placements;
+}
+
+// The next slot after `from` still holding the player; only needed when a squad lists someone twice.
+Placement nextPlacement(int16_t idx, Placement from) {
+    for (int clubIdx = from.club; clubIdx < kIndexedClubs; ++clubIdx) {
+        const ClubRecord &club = clubData.club[clubIdx];
+        for (int slot = clubIdx == from.club ? from.slot + 1 : 0; slot < kSquadSlots; ++slot) {
+            if (club.player_index[slot] == idx) {
+                return {clubIdx, slot};
+            }
+        }
+    }
+    return {};
+}
+
+void rebuild() {
+    gPlacements = scan();
+    gSlotCounts.fill(0);
+    for (int clubIdx = 0; clubIdx < kIndexedClubs; ++clubIdx) {
+        for (int slot = 0; slot < kSquadSlots; ++slot) {
+            int16_t idx = clubData.club[clubIdx].player_index[slot];
+            if (validPlayer(idx)) {
+                ++gSlotCounts[idx];
+            }
+        }
+    }
+    gBuilt = true;
+}
+
+void ensureBuilt() {
+    if (!gBuilt) {
+        rebuild();
+    }
+}
+} // namespace
+
+void invalidate() {
+    gBuilt = false;
+}
+
+Placement find(int16_t playerIdx) {
+    if (!validPlayer(playerIdx)) {
+        return {};
+    }
+    ensureBuilt();
+    return gPlacements[playerIdx];
+}
+
+void setSlot(int clubIdx, int slot, int16_t playerIdx) {
+    if (clubIdx < 0 || clubIdx >= kClubIdxMax || slot < 0 || slot >= kSquadSlots) {
+        return;
+    }
+    ensureBuilt();
+
+    ClubRecord &club = clubData.club[clubIdx];
+    int16_t entry = club.player_index[slot];
+    Placement here{clubIdx, slot};
+    if (clubIdx < kIndexedClubs) {
+        if (validPlayer(entry)) {
+            --gSlotCounts[entry];
+            if (gPlacements[entry].club == clubIdx && gPlacements[entry].slot == slot) {
+                gPlacements[entry] = gSlotCounts[entry] > 0 ? nextPlacement(entry, here) : Placement{};
+            }
+        }
+        if (validPlayer(playerIdx)) {
+            ++gSlotCounts[playerIdx];
+            if (before(here, gPlacements[playerIdx])) {
+                gPlacements[playerIdx] = here;
+            }
+        }
+    }
+    club.player_index[slot] = playerIdx;
+}
+
+bool verify() {
+    if (!gBuilt) {
+        return true;
+    }
+    auto expected = scan();
+    for (int idx = 0; idx < kPlayers; ++idx) {
+        if (expected[idx].club != gPlacements[idx].club || expected[idx].slot != gPlacements[idx].slot) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#ifndef NDEBUG
+void check(const char *operation) {
+    if (!verify()) {
+        std::cerr << "roster index out of step after " << operation << "\n";
+        rebuild();
+    }
+}
+#endif
+
+} // namespace roster_index
@@ -0,0 +1,42 @@
+// Reverse index from player to the club squad slot that holds them, so lookups do not walk every
+// club's player_index table.
+#pragma once
+
+#include <cstdint>
+
+#include "pm3_data.h"
+
+namespace roster_index {
+
+// Only the league clubs are indexed, matching the squads the transfer screens search.
+inline constexpr int kIndexedClubs = 114;
+inline constexpr int kSquadSlots = 24;
+
+struct Placement {
+    int club = -1;
+    int slot = -1;
+};
+
+// Drops the index; it is rebuilt from clubData on the next lookup. Call after clubData is
+// replaced wholesale (load, reload from disk, undo, imports).
+void invalidate();
+
+// The first squad slot (in club, then slot order) holding the player, or club -1 if none does.
+Placement find(int16_t playerIdx);
+
+// Writes `playerIdx` (-1 to empty it) into a squad slot and updates the index to match. Roster
+// edits go through this so the index never needs a rebuild.
+void setSlot(int clubIdx, int slot, int16_t playerIdx);
+
+// Compares the index against a full scan of clubData.
+bool verify();
+
+// Debug builds verify the index once a whole roster operation (a transfer, a loan) is done, report
+// the operation if it is out of step and rebuild it. Release builds skip the scan.
+#ifndef NDEBUG
+void check(const char *operation);
+#else
+inline void check(const char *) {}
+#endif
+
+} // namespace roster_index
@@ -0,0 +1,237 @@
+// Single-file .pm3bundle snapshot of a save slot: GAMEnA/B/C, SAVES.DIR and PREFS in one file so a
+// career can be moved between machines.
+#include "save_bundle.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "save_delta.h"
+
+namespace io {
+namespace {
+constexpr char kBundleMagic[8] = {'P', 'M', '3', 'B', 'N', 'D', 'L', '1'};
+constexpr std::size_t kEntrySize = 4 + 4 + 8 + 8 + 8 + 8;
+constexpr std::size_t kMaxRun = 128;
+
+void putU32(std::vector<std::uint8_t> &out, std::uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+    }
+}
+
+void putU64(std::vector<std::uint8_t> &out, std::uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+    }
+}
+
+void patchU64(std::vector<std::uint8_t> &out, std::size_t at, std::uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        out[at + i] = static_cast<std::uint8_t>(value >> (8 * i));
+    }
+}
+
+// The most raw bytes a section can hold. GAMEnA never carries more than another gamea's worth
+// after the struct.
+std::uint64_t maxRawSize(BundleSection section) {
+    switch (section) {
+        case BundleSection::GameA:
+        case BundleSection::GameaTail:
+            return sizeof(gamea);
+        case BundleSection::GameB:
+            return sizeof(gameb);
+        case BundleSection::GameC:
+            return sizeof(gamec);
+        case BundleSection::SavesDir:
+            return sizeof(saves);
+        case BundleSection::Prefs:
+            return sizeof(prefs);
+    }
+    return sizeof(gamec);
+}
+
+std::uint64_t getLE(const std::uint8_t *p, int bytes) {
+    std::uint64_t value = 0;
+    for (int i = bytes - 1; i >= 0; --i) {
+        value = (value << 8) | p[i];
+    }
+    return value;
+}
+} // namespace
+
+std::vector<std::uint8_t> encodeRle(const std::uint8_t *data, std::size_t size) {
+    std::vector<std::uint8_t> out;
+    out.reserve(size / 2);
+    std::size_t i = 0;
+    while (i < size) {
+        std::size_t run = 1;
+        while (i + run < size && run < kMaxRun && data[i + run] == data[i]) {
+            ++run;
+        }
+        if (run >= 2) {
+            out.push_back(static_cast<std::uint8_t>(257 - run));
+            out.push_back(data[i]);
+            i += run;
+            continue;
+        }
+
+        // Literals run until the next pair of equal bytes.
+        std::size_t start = i;
+        while (i < size && i - start < kMaxRun && (i + 1 >= size || data[i + 1] != data[i])) {
+            ++i;
+        }
+        out.push_back(static_cast<std::uint8_t>(i - start - 1));
+        out.insert(out.end(), data + start, data + i);
+    }
+    return out;
+}
+
+bool decodeRle(const std::uint8_t *data, std::size_t size, std::size_t rawSize, std::vector<std::uint8_t> &out) {
+    out.clear();
+    // A two-byte run packet is the most any input expands to; larger claims are rejected before
+    // anything is allocated for them.
+    if (rawSize > size / 2 * kMaxRun) {
+        return false;
+    }
+    out.reserve(rawSize);
+    std::size_t i = 0;
+    while (i < size) {
+        std::uint8_t control = data[i++];
+        if (control < 128) {
+            std::size_t count = control + 1u;
+            if (i + count > size || out.size() + count > rawSize) {
+                return false;
+            }
+            out.insert(out.end(), data + i, data + i + count);
+            i += count;
+        } else if (control > 128) {
+            std::size_t count = 257u - control;
+            if (i >= size || out.size() + count > rawSize) {
+                return false;
+            }
+            out.insert(out.end(), count, data[i++]);
+        } else {
+            return false;
+        }
+    }
+    return out.size() == rawSize;
+}
+
+std::vector<std::uint8_t> buildBundle(std::uint32_t sourceSlot, const std::vector<BundleInput> &sections,
+                                      bool compress) {
+    std::vector<std::uint8_t> out(kBundleMagic, kBundleMagic + sizeof(kBundleMagic));
+    putU32(out, sourceSlot);
+    putU32(out, static_cast<std::uint32_t>(sections.size()));
+
+    std::vector<std::vector<std::uint8_t>> payloads;
+    std::vector<std::size_t> offsetFields;
+    for (const BundleInput &input : sections) {
+        const auto *bytes = static_cast<const std::uint8_t *>(input.data);
+        BundleEncoding encoding = BundleEncoding::Raw;
+        std::vector<std::uint8_t> payload;
+        if (compress) {
+            payload = encodeRle(bytes, input.size);
+            encoding = payload.size() < input.size ? BundleEncoding::Rle : BundleEncoding::Raw;
+        }
+        if (encoding == BundleEncoding::Raw) {
+            payload.assign(bytes, bytes + input.size);
+        }
+
+        putU32(out, static_cast<std::uint32_t>(input.section));
+        putU32(out, static_cast<std::uint32_t>(encoding));
+        offsetFields.push_back(out.size());
+        putU64(out, 0);
+        putU64(out, payload.size());
+        putU64(out, input.size);
+        putU64(out, checksum(bytes, input.size));
+        payloads.push_back(std::move(payload));
+    }
+
+    // The payload offsets are known once the header size is; the header checksum covers them.
+    std::size_t offset = out.size() + 8;
+    for (std::size_t i = 0; i < payloads.size(); ++i) {
+        patchU64(out, offsetFields[i], offset);
+        offset += payloads[i].size();
+    }
+    putU64(out, checksum(out.data(), out.size()));
+    for (const auto &payload : payloads) {
+        out.insert(out.end(), payload.begin(), payload.end());
+    }
+    return out;
+}
+
+SaveBundle::SaveBundle(const std::filesystem::path &path) : file(path) {
+    const std::uint8_t *data = file.data();
+    std::size_t size = file.size();
+    auto invalid = [&path](const char *why) {
+        return std::runtime_error("Invalid bundle " + path.string() + ": " + why);
+    };
+
+    if (size < sizeof(kBundleMagic) + 8 + 8 || std::memcmp(data, kBundleMagic, sizeof(kBundleMagic)) != 0) {
+        throw invalid("not a PM3000 bundle");
+    }
+    slot = static_cast<std::uint32_t>(getLE(data + 8, 4));
+    std::uint64_t count = getLE(data + 12, 4);
+    std::size_t headerSize = 16 + count * kEntrySize;
+    if (count > 64 || headerSize + 8 > size) {
+        throw invalid("truncated header");
+    }
+    if (getLE(data + headerSize, 8) != checksum(data, headerSize)) {
+        throw invalid("header checksum mismatch");
+    }
+
+    for (std::uint64_t i = 0; i < count; ++i) {
+        const std::uint8_t *p = data + 16 + i * kEntrySize;
+        Entry entry{static_cast<BundleSection>(getLE(p, 4)), static_cast<BundleEncoding>(getLE(p + 4, 4)),
+                    getLE(p + 8, 8), getLE(p + 16, 8), getLE(p + 24, 8), getLE(p + 32, 8)};
+        if (entry.offset > size || entry.storedSize > size - entry.offset) {
+            throw invalid("section out of range");
+        }
+        if (entry.encoding != BundleEncoding::Raw && entry.encoding != BundleEncoding::Rle) {
+            throw invalid("unknown section encoding");
+        }
+        entries.push_back(entry);
+    }
+}
+
+const SaveBundle::Entry *SaveBundle::find(BundleSection section) const {
+    for (const Entry &entry : entries) {
+        if (entry.section == section) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+bool SaveBundle::has(BundleSection section) const {
+    return find(section) != nullptr;
+}
+
+std::vector<std::uint8_t> SaveBundle::section(BundleSection section) const {
+    const Entry *entry = find(section);
+    if (entry == nullptr) {
+        throw std::runtime_error("Bundle " + file.path().string() + " has no section " +
+                                 std::to_string(static_cast<std::uint32_t>(section)));
+    }
+
+    if (entry->rawSize > maxRawSize(section)) {
+        throw std::runtime_error("Oversized bundle section in " + file.path().string());
+    }
+    const std::uint8_t *stored = file.data() + entry->offset;
+    std::vector<std::uint8_t> raw;
+    if (entry->encoding == BundleEncoding::Raw) {
+        if (entry->storedSize != entry->rawSize) {
+            throw std::runtime_error("Corrupt bundle section in " + file.path().string());
+        }
+        raw.assign(stored, stored + entry->storedSize);
+    } else if (!decodeRle(stored, entry->storedSize, entry->rawSize, raw)) {
+        throw std::runtime_error("Corrupt bundle section in " + file.path().string());
+    }
+    if (checksum(raw.data(), raw.size()) != entry->checksum) {
+        throw std::runtime_error("Bundle section checksum mismatch in " + file.path().string());
+    }
+    return raw;
+}
+
+} // namespace io
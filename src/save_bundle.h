@@ -0,0 +1,79 @@
+// Single-file .pm3bundle snapshot of a save slot: GAMEnA/B/C, SAVES.DIR and PREFS in one file so a
+// career can be moved between machines.
+//
+// Layout (all integers little-endian):
+//   "PM3BNDL1", u32 source slot, u32 section count,
+//   per section: u32 id, u32 encoding, u64 offset, u64 stored size, u64 raw size, u64 checksum,
+//   u64 checksum of everything above, then the section payloads.
+// Section checksums are FNV-1a over the raw (decoded) bytes.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+#include "save_view.h"
+
+namespace io {
+
+inline constexpr std::string_view kBundleExtension = ".pm3bundle";
+
+enum class BundleSection : std::uint32_t {
+    GameA = 1,
+    GameB = 2,
+    GameC = 3,
+    SavesDir = 4,
+    Prefs = 5,
+    GameaTail = 6, // bytes after the gamea struct in GAMEnA, kept so the file round-trips exactly
+};
+
+enum class BundleEncoding : std::uint32_t {
+    Raw = 0,
+    Rle = 1, // PackBits runs; PM3 records are full of zero and space padding
+};
+
+struct BundleInput {
+    BundleSection section;
+    const void *data = nullptr;
+    std::size_t size = 0;
+};
+
+// Serializes the sections. With `compress`, each section is RLE-encoded when that makes it smaller.
+std::vector<std::uint8_t> buildBundle(std::uint32_t sourceSlot, const std::vector<BundleInput> &sections,
+                                      bool compress);
+
+// PackBits encoding used for Rle sections. decodeRle returns false on malformed input, if the
+// output would not be exactly `rawSize` bytes, or if `size` bytes could not expand to that many.
+std::vector<std::uint8_t> encodeRle(const std::uint8_t *data, std::size_t size);
+bool decodeRle(const std::uint8_t *data, std::size_t size, std::size_t rawSize, std::vector<std::uint8_t> &out);
+
+// A bundle read through a single mapping. The header is validated on open; sections are checked
+// against their checksums when read. Throws std::runtime_error on anything malformed.
+class SaveBundle {
+public:
+    explicit SaveBundle(const std::filesystem::path &path);
+
+    std::uint32_t sourceSlot() const { return slot; }
+    bool has(BundleSection section) const;
+    std::vector<std::uint8_t> section(BundleSection section) const;
+
+private:
+    struct Entry {
+        BundleSection section;
+        BundleEncoding encoding;
+        std::uint64_t offset;
+        std::uint64_t storedSize;
+        std::uint64_t rawSize;
+        std::uint64_t checksum;
+    };
+
+    const Entry *find(BundleSection section) const;
+
+    MappedFile file;
+    std::uint32_t slot = 0;
+    std::vector<Entry> entries;
+};
+
+} // namespace io
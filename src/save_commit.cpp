@@ -0,0 +1,232 @@
+// Crash-safe batch commit of several files in one folder (save slot + metadata).
+#include "save_commit.h"
+
+#include <fstream>
+#include <system_error>
+#include <thread>
+
+#include "config/constants.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace io {
+namespace {
+constexpr const char *kNewSuffix = ".pm3new";
+constexpr const char *kOldSuffix = ".pm3old";
+constexpr const char *kJournalHeader = "PM3000 COMMIT";
+
+struct JournalEntry {
+    std::string name;
+    bool existed = false;
+};
+
+std::filesystem::path withSuffix(const std::filesystem::path &path, const char *suffix) {
+    std::filesystem::path result = path;
+    result += suffix;
+    return result;
+}
+
+bool hasSuffix(const std::filesystem::path &path, const char *suffix) {
+    std::string name = path.filename().string();
+    std::string ending(suffix);
+    return name.size() > ending.size() && name.compare(name.size() - ending.size(), ending.size(), ending) == 0;
+}
+
+bool writeJournal(const std::filesystem::path &journalPath, const std::vector<JournalEntry> &entries) {
+    std::string text = std::string(kJournalHeader) + "\n";
+    for (const auto &entry : entries) {
+        text += (entry.existed ? "1 " : "0 ") + entry.name + "\n";
+    }
+    return writeFileDurable(journalPath, text.data(), text.size(), nullptr, 0);
+}
+
+bool readJournal(const std::filesystem::path &journalPath, std::vector<JournalEntry> &entries) {
+    std::ifstream in(journalPath);
+    std::string line;
+    if (!in || !std::getline(in, line) || line != kJournalHeader) {
+        return false;
+    }
+    while (std::getline(in, line)) {
+        if (line.size() < 3 || line[1] != ' ') {
+            continue;
+        }
+        entries.push_back({line.substr(2), line[0] == '1'});
+    }
+    return true;
+}
+
+void rollback(const std::filesystem::path &folder, const std::vector<JournalEntry> &entries) {
+    std::error_code ec;
+    for (const auto &entry : entries) {
+        std::filesystem::path target = folder / entry.name;
+        std::filesystem::path old = withSuffix(target, kOldSuffix);
+        if (entry.existed) {
+            if (std::filesystem::exists(old, ec)) {
+                std::filesystem::rename(old, target, ec);
+            }
+        } else {
+            std::filesystem::remove(target, ec);
+        }
+        std::filesystem::remove(withSuffix(target, kNewSuffix), ec);
+    }
+    syncFolder(folder);
+}
+} // namespace
+
+bool writeFileDurable(const std::filesystem::path &path, const void *data, std::size_t size, const void *tail,
+                      std::size_t tailSize) {
+#ifdef _WIN32
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+    out.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+    if (tail != nullptr && tailSize > 0) {
+        out.write(static_cast<const char *>(tail), static_cast<std::streamsize>(tailSize));
+    }
+    out.flush();
+    return static_cast<bool>(out);
+#else
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) {
+        return false;
+    }
+
+    auto writeAll = [fd](const void *buffer, std::size_t length) {
+        const char *cursor = static_cast<const char *>(buffer);
+        while (length > 0) {
+            ssize_t written = ::write(fd, cursor, length);
+            if (written <= 0) {
+                return false;
+            }
+            cursor += written;
+            length -= static_cast<std::size_t>(written);
+        }
+        return true;
+    };
+
+    bool ok = writeAll(data, size);
+    if (ok && tail != nullptr && tailSize > 0) {
+        ok = writeAll(tail, tailSize);
+    }
+    ok = ok && ::fsync(fd) == 0;
+    ok = (::close(fd) == 0) && ok;
+    return ok;
+#endif
+}
+
+void syncFolder(const std::filesystem::path &folder) {
+#ifndef _WIN32
+    int fd = ::open(folder.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd != -1) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+#else
+    (void) folder;
+#endif
+}
+
+bool recoverInterruptedCommit(const std::filesystem::path &folder) {
+    std::error_code ec;
+    if (folder.empty() || !std::filesystem::is_directory(folder, ec)) {
+        return false;
+    }
+
+    bool repaired = false;
+    std::filesystem::path journalPath = folder / COMMIT_JOURNAL_PATH;
+    if (std::filesystem::exists(journalPath, ec)) {
+        std::vector<JournalEntry> entries;
+        if (readJournal(journalPath, entries)) {
+            rollback(folder, entries);
+        }
+        std::filesystem::remove(journalPath, ec);
+        syncFolder(folder);
+        repaired = true;
+    }
+
+    // Without a journal, temp files belong to a commit that never started swapping and old
+    // files to one that already passed its commit point; both are safe to drop.
+    for (const auto &entry : std::filesystem::directory_iterator(folder, ec)) {
+        const auto &path = entry.path();
+        if (hasSuffix(path, kNewSuffix) || hasSuffix(path, kOldSuffix)) {
+            std::error_code removeEc;
+            std::filesystem::remove(path, removeEc);
+            repaired = true;
+        }
+    }
+
+    return repaired;
+}
+
+bool commitFiles(const std::filesystem::path &folder, const std::vector<FileWrite> &writes, std::string &error) {
+    std::error_code ec;
+    recoverInterruptedCommit(folder);
+
+    std::vector<char> written(writes.size(), 0);
+    std::vector<std::thread> workers;
+    workers.reserve(writes.size());
+    for (std::size_t i = 0; i < writes.size(); ++i) {
+        workers.emplace_back([&writes, &written, i] {
+            const FileWrite &write = writes[i];
+            written[i] = writeFileDurable(withSuffix(write.target, kNewSuffix), write.data, write.size, write.tail,
+                                      write.tailSize);
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    std::vector<JournalEntry> entries;
+    for (std::size_t i = 0; i < writes.size(); ++i) {
+        entries.push_back({writes[i].target.filename().string(), std::filesystem::exists(writes[i].target, ec)});
+        if (!written[i] && error.empty()) {
+            error = "Could not write " + writes[i].target.string();
+        }
+    }
+
+    std::filesystem::path journalPath = folder / COMMIT_JOURNAL_PATH;
+    if (error.empty() && !writeJournal(journalPath, entries)) {
+        error = "Could not write " + journalPath.string();
+    }
+    if (!error.empty()) {
+        for (const auto &write : writes) {
+            std::filesystem::remove(withSuffix(write.target, kNewSuffix), ec);
+        }
+        std::filesystem::remove(journalPath, ec);
+        return false;
+    }
+    syncFolder(folder);
+
+    for (const auto &write : writes) {
+        std::filesystem::path newPath = withSuffix(write.target, kNewSuffix);
+        if (std::filesystem::exists(write.target, ec)) {
+            std::filesystem::rename(write.target, withSuffix(write.target, kOldSuffix), ec);
+        }
+        if (!ec) {
+            std::filesystem::rename(newPath, write.target, ec);
+        }
+        if (ec) {
+            error = "Could not replace " + write.target.string() + ": " + ec.message();
+            rollback(folder, entries);
+            std::filesystem::remove(journalPath, ec);
+            syncFolder(folder);
+            return false;
+        }
+    }
+    syncFolder(folder);
+
+    std::filesystem::remove(journalPath, ec);
+    syncFolder(folder);
+
+    for (const auto &write : writes) {
+        std::filesystem::remove(withSuffix(write.target, kOldSuffix), ec);
+    }
+
+    return true;
+}
+
+} // namespace io
@@ -0,0 +1,37 @@
+// Crash-safe batch commit of several files in one folder (save slot + metadata).
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace io {
+
+struct FileWrite {
+    std::filesystem::path target;
+    const void *data = nullptr;
+    std::size_t size = 0;
+    const void *tail = nullptr; // optional trailing bytes appended after data
+    std::size_t tailSize = 0;
+};
+
+// Writes (and on POSIX fsyncs) a whole file, replacing any existing contents.
+bool writeFileDurable(const std::filesystem::path &path, const void *data, std::size_t size,
+                      const void *tail = nullptr, std::size_t tailSize = 0);
+// Makes renames and removals inside `folder` durable (no-op where unsupported).
+void syncFolder(const std::filesystem::path &folder);
+
+// Commits all writes or none of them:
+//   1. every file is written to "<target>.pm3new" and fsynced (one thread per file),
+//   2. a journal naming the targets is written to the folder,
+//   3. each existing target is moved aside to "<target>.pm3old" and the new file renamed in,
+//   4. the journal is removed (the commit point) and the ".pm3old" files are deleted.
+// All targets must live in `folder`. On failure the folder is rolled back and `error` is set.
+bool commitFiles(const std::filesystem::path &folder, const std::vector<FileWrite> &writes, std::string &error);
+
+// Rolls back a commit that was interrupted before its commit point and clears leftovers of one
+// that was interrupted after it. Returns true if the folder needed any repair.
+bool recoverInterruptedCommit(const std::filesystem::path &folder);
+
+} // namespace io
@@ -0,0 +1,313 @@
+// In-place partial writes of save files, guarded by an undo log, plus checksum sidecars.
+#include "save_delta.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <system_error>
+
+#include "config/constants.h"
+#include "save_commit.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace io {
+namespace {
+constexpr char kUndoMagic[8] = {'P', 'M', '3', 'U', 'N', 'D', 'O', '1'};
+constexpr char kUndoTrailer[4] = {'E', 'N', 'D', '!'};
+constexpr const char *kSidecarHeader = "PM3000 SUM";
+
+struct Chunk {
+    std::uint64_t offset;
+    const char *bytes;
+    std::uint64_t size;
+};
+
+struct UndoEntry {
+    std::string name;
+    std::vector<Chunk> chunks;
+};
+
+bool readRanges(const std::filesystem::path &path, const std::vector<dirty_tracker::ByteRange> &ranges,
+                std::vector<char> &out) {
+#ifdef _WIN32
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    for (const auto &range : ranges) {
+        std::size_t start = out.size();
+        out.resize(start + range.size);
+        in.seekg(static_cast<std::streamoff>(range.offset));
+        if (!in.read(out.data() + start, static_cast<std::streamsize>(range.size))) {
+            return false;
+        }
+    }
+    return true;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+    bool ok = true;
+    for (const auto &range : ranges) {
+        std::size_t start = out.size();
+        out.resize(start + range.size);
+        std::size_t done = 0;
+        while (ok && done < range.size) {
+            ssize_t got = ::pread(fd, out.data() + start + done, range.size - done,
+                                  static_cast<off_t>(range.offset + done));
+            ok = got > 0;
+            done += ok ? static_cast<std::size_t>(got) : 0;
+        }
+    }
+    ::close(fd);
+    return ok;
+#endif
+}
+
+bool writeChunks(const std::filesystem::path &path, const std::vector<Chunk> &chunks) {
+#ifdef _WIN32
+    std::fstream out(path, std::ios::binary | std::ios::in | std::ios::out);
+    if (!out) {
+        return false;
+    }
+    for (const auto &chunk : chunks) {
+        out.seekp(static_cast<std::streamoff>(chunk.offset));
+        out.write(chunk.bytes, static_cast<std::streamsize>(chunk.size));
+    }
+    out.flush();
+    return static_cast<bool>(out);
+#else
+    int fd = ::open(path.c_str(), O_WRONLY);
+    if (fd == -1) {
+        return false;
+    }
+    bool ok = true;
+    for (const auto &chunk : chunks) {
+        std::uint64_t done = 0;
+        while (ok && done < chunk.size) {
+            ssize_t written = ::pwrite(fd, chunk.bytes + done, static_cast<std::size_t>(chunk.size - done),
+                                       static_cast<off_t>(chunk.offset + done));
+            ok = written > 0;
+            done += ok ? static_cast<std::uint64_t>(written) : 0;
+        }
+    }
+    ok = ok && ::fsync(fd) == 0;
+    ok = (::close(fd) == 0) && ok;
+    return ok;
+#endif
+}
+
+template <typename T>
+void append(std::vector<char> &buffer, const T &value) {
+    const char *bytes = reinterpret_cast<const char *>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+bool take(const std::vector<char> &buffer, std::size_t &cursor, std::size_t end, T &value) {
+    if (end - cursor < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&value, buffer.data() + cursor, sizeof(T));
+    cursor += sizeof(T);
+    return true;
+}
+
+// The returned entries point into `log`.
+bool parseUndoLog(const std::vector<char> &log, std::vector<UndoEntry> &entries) {
+    const std::size_t trailerSize = sizeof(kUndoTrailer) + sizeof(std::uint64_t);
+    if (log.size() < sizeof(kUndoMagic) + trailerSize ||
+        std::memcmp(log.data(), kUndoMagic, sizeof(kUndoMagic)) != 0) {
+        return false;
+    }
+    std::size_t end = log.size() - trailerSize;
+    std::uint64_t expected = 0;
+    std::memcpy(&expected, log.data() + end + sizeof(kUndoTrailer), sizeof(expected));
+    if (std::memcmp(log.data() + end, kUndoTrailer, sizeof(kUndoTrailer)) != 0 ||
+        checksum(log.data(), end) != expected) {
+        return false;
+    }
+
+    std::size_t cursor = sizeof(kUndoMagic);
+    while (cursor < end) {
+        std::uint16_t nameSize = 0;
+        std::uint32_t chunkCount = 0;
+        if (!take(log, cursor, end, nameSize) || end - cursor < nameSize) {
+            return false;
+        }
+        UndoEntry entry{std::string(log.data() + cursor, nameSize), {}};
+        cursor += nameSize;
+        if (!take(log, cursor, end, chunkCount)) {
+            return false;
+        }
+        for (std::uint32_t i = 0; i < chunkCount; ++i) {
+            Chunk chunk{0, nullptr, 0};
+            if (!take(log, cursor, end, chunk.offset) || !take(log, cursor, end, chunk.size) ||
+                end - cursor < chunk.size) {
+                return false;
+            }
+            chunk.bytes = log.data() + cursor;
+            cursor += static_cast<std::size_t>(chunk.size);
+            entry.chunks.push_back(chunk);
+        }
+        entries.push_back(std::move(entry));
+    }
+    return true;
+}
+
+bool restore(const std::filesystem::path &folder, const std::vector<UndoEntry> &entries) {
+    bool ok = true;
+    for (const auto &entry : entries) {
+        ok = writeChunks(folder / entry.name, entry.chunks) && ok;
+    }
+    return ok;
+}
+} // namespace
+
+std::uint64_t checksum(const void *data, std::size_t size) {
+    // FNV-1a, 64 bit.
+    const auto *bytes = static_cast<const unsigned char *>(data);
+    std::uint64_t hash = 1469598103934665603ULL;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool recoverInterruptedPatch(const std::filesystem::path &folder) {
+    std::error_code ec;
+    std::filesystem::path logPath = folder / PATCH_UNDO_LOG_PATH;
+    if (folder.empty() || !std::filesystem::exists(logPath, ec)) {
+        return false;
+    }
+
+    std::ifstream in(logPath, std::ios::binary);
+    std::vector<char> log((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+
+    // A log that does not parse was never completed, so no file was touched yet. A log whose
+    // restore failed is kept for the next attempt.
+    std::vector<UndoEntry> entries;
+    if (parseUndoLog(log, entries) && !restore(folder, entries)) {
+        return true;
+    }
+    std::filesystem::remove(logPath, ec);
+    syncFolder(folder);
+    return true;
+}
+
+bool writePatchUndoLog(const std::filesystem::path &folder, const std::vector<FilePatch> &patches,
+                       std::string &error) {
+    std::error_code ec;
+    std::vector<char> log(kUndoMagic, kUndoMagic + sizeof(kUndoMagic));
+    for (const auto &patch : patches) {
+        std::uintmax_t fileSize = std::filesystem::file_size(patch.target, ec);
+        std::vector<char> previous;
+        bool inBounds = !ec;
+        for (const auto &range : patch.ranges) {
+            inBounds = inBounds && range.offset + range.size <= fileSize;
+        }
+        if (!inBounds || !readRanges(patch.target, patch.ranges, previous)) {
+            error = "Could not read " + patch.target.string();
+            return false;
+        }
+
+        std::string name = patch.target.filename().string();
+        append(log, static_cast<std::uint16_t>(name.size()));
+        log.insert(log.end(), name.begin(), name.end());
+        append(log, static_cast<std::uint32_t>(patch.ranges.size()));
+        std::size_t cursor = 0;
+        for (const auto &range : patch.ranges) {
+            append(log, static_cast<std::uint64_t>(range.offset));
+            append(log, static_cast<std::uint64_t>(range.size));
+            log.insert(log.end(), previous.begin() + static_cast<std::ptrdiff_t>(cursor),
+                       previous.begin() + static_cast<std::ptrdiff_t>(cursor + range.size));
+            cursor += range.size;
+        }
+    }
+    std::uint64_t logHash = checksum(log.data(), log.size());
+    log.insert(log.end(), kUndoTrailer, kUndoTrailer + sizeof(kUndoTrailer));
+    append(log, logHash);
+
+    std::filesystem::path logPath = folder / PATCH_UNDO_LOG_PATH;
+    if (!writeFileDurable(logPath, log.data(), log.size())) {
+        std::filesystem::remove(logPath, ec);
+        error = "Could not write " + logPath.string();
+        return false;
+    }
+    syncFolder(folder);
+    return true;
+}
+
+bool patchFiles(const std::filesystem::path &folder, const std::vector<FilePatch> &patches, std::string &error) {
+    recoverInterruptedPatch(folder);
+    if (!writePatchUndoLog(folder, patches, error)) {
+        return false;
+    }
+
+    for (const auto &patch : patches) {
+        std::vector<Chunk> chunks;
+        for (const auto &range : patch.ranges) {
+            chunks.push_back({range.offset, static_cast<const char *>(patch.data) + range.offset, range.size});
+        }
+        if (!writeChunks(patch.target, chunks)) {
+            error = "Could not write " + patch.target.string();
+            recoverInterruptedPatch(folder);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(folder / PATCH_UNDO_LOG_PATH, ec);
+    syncFolder(folder);
+    return true;
+}
+
+std::string formatChecksumSidecar(const std::vector<FileChecksum> &checksums) {
+    std::string text = std::string(kSidecarHeader) + "\n";
+    char line[128];
+    for (const auto &sum : checksums) {
+        std::snprintf(line, sizeof(line), " %" PRIu64 " %016" PRIx64 "\n", sum.size, sum.hash);
+        text += sum.name + line;
+    }
+    return text;
+}
+
+bool verifyChecksumSidecar(const std::filesystem::path &sidecar, std::string &error) {
+    std::ifstream in(sidecar);
+    std::string line;
+    if (!in || !std::getline(in, line) || line != kSidecarHeader) {
+        error = "Missing checksums: " + sidecar.string();
+        return false;
+    }
+
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        FileChecksum expected;
+        std::string hashText;
+        if (!(fields >> expected.name >> expected.size >> hashText)) {
+            continue;
+        }
+        expected.hash = std::stoull(hashText, nullptr, 16);
+
+        std::filesystem::path path = sidecar.parent_path() / expected.name;
+        std::ifstream file(path, std::ios::binary);
+        std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (!file.is_open() || bytes.size() != expected.size || checksum(bytes.data(), bytes.size()) != expected.hash) {
+            error = "Checksum mismatch: " + path.string();
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace io
@@ -0,0 +1,46 @@
+// In-place partial writes of save files, guarded by an undo log, plus checksum sidecars.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "dirty_tracker.h"
+
+namespace io {
+
+struct FilePatch {
+    std::filesystem::path target;
+    const void *data = nullptr; // full new image of the file; only `ranges` of it are written
+    std::vector<dirty_tracker::ByteRange> ranges;
+};
+
+// Overwrites only the given ranges of existing files:
+//   1. the current bytes of every range are read and written to an undo log in `folder`,
+//   2. the new bytes are pwritten and each file is fsynced,
+//   3. the undo log is removed (the commit point).
+// All targets must live in `folder`. On failure the previous bytes are restored and `error` is set.
+bool patchFiles(const std::filesystem::path &folder, const std::vector<FilePatch> &patches, std::string &error);
+
+// Step 1 of patchFiles on its own: records the current bytes of every range in the undo log.
+bool writePatchUndoLog(const std::filesystem::path &folder, const std::vector<FilePatch> &patches,
+                       std::string &error);
+
+// Restores the previous bytes of a patch that was interrupted before its commit point.
+// Returns true if the folder needed any repair.
+bool recoverInterruptedPatch(const std::filesystem::path &folder);
+
+struct FileChecksum {
+    std::string name; // file name, relative to the sidecar's folder
+    std::uint64_t size = 0;
+    std::uint64_t hash = 0;
+};
+
+std::uint64_t checksum(const void *data, std::size_t size);
+std::string formatChecksumSidecar(const std::vector<FileChecksum> &checksums);
+// Re-reads every file listed in the sidecar. False (with `error` set) if any is missing or differs.
+bool verifyChecksumSidecar(const std::filesystem::path &sidecar, std::string &error);
+
+} // namespace io
@@ -0,0 +1,140 @@
+// Memory-mapped views over PM3 save files (GAMEnA/B/C) and other binary data files.
+#include "save_view.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace io {
+
+MappedFile::MappedFile(const std::filesystem::path &path) : filePath(path) {
+#ifdef _WIN32
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Missing file: " + path.string());
+    }
+    fallback.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    bytes = fallback.data();
+    length = fallback.size();
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw std::runtime_error("Missing file: " + path.string());
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Could not stat file: " + path.string());
+    }
+
+    length = static_cast<std::size_t>(st.st_size);
+    if (length > 0) {
+        void *mapped = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            ::close(fd);
+            length = 0;
+            throw std::runtime_error("Could not map file: " + path.string());
+        }
+        bytes = static_cast<uint8_t *>(mapped);
+    }
+    ::close(fd);
+#endif
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+        release();
+        filePath = std::move(other.filePath);
+#ifdef _WIN32
+        fallback = std::move(other.fallback);
+#endif
+        bytes = std::exchange(other.bytes, nullptr);
+        length = std::exchange(other.length, 0);
+    }
+    return *this;
+}
+
+void MappedFile::release() {
+#ifndef _WIN32
+    if (bytes != nullptr) {
+        ::munmap(bytes, length);
+    }
+#else
+    fallback.clear();
+#endif
+    bytes = nullptr;
+    length = 0;
+}
+
+bool readExact(const std::filesystem::path &path, void *out, std::size_t size) {
+#ifdef _WIN32
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file || static_cast<std::size_t>(file.tellg()) != size) {
+        return false;
+    }
+    file.seekg(0);
+    return static_cast<bool>(file.read(static_cast<char *>(out), static_cast<std::streamsize>(size)));
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+    struct stat st{};
+    bool ok = ::fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) == size;
+    std::size_t done = 0;
+    while (ok && done < size) {
+        ssize_t got = ::pread(fd, static_cast<char *>(out) + done, size - done, static_cast<off_t>(done));
+        ok = got > 0;
+        done += ok ? static_cast<std::size_t>(got) : 0;
+    }
+    // A short read ends the loop above; a file that grew or shrank after it is caught here.
+    ok = ok && ::fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) == size;
+    ::close(fd);
+    return ok;
+#endif
+}
+
+namespace {
+template <typename T>
+MappedFile mapExact(const std::filesystem::path &path) {
+    MappedFile file(path);
+    if (file.size() != sizeof(T)) {
+        throw std::runtime_error("Invalid file size: " + path.string());
+    }
+    return file;
+}
+} // namespace
+
+SaveView::SaveView(const std::filesystem::path &gameaPath, const std::filesystem::path &gamebPath,
+                   const std::filesystem::path &gamecPath)
+        : fileA(mapExact<gamea>(gameaPath)),
+          fileB(mapExact<gameb>(gamebPath)),
+          fileC(mapExact<gamec>(gamecPath)) {}
+
+void SaveView::copyTo(gamea &gameDataOut, gameb &clubDataOut, gamec &playerDataOut) const {
+    std::memcpy(&gameDataOut, fileA.data(), sizeof(gamea));
+    std::memcpy(&clubDataOut, fileB.data(), sizeof(gameb));
+    std::memcpy(&playerDataOut, fileC.data(), sizeof(gamec));
+}
+
+} // namespace io
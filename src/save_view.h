@@ -0,0 +1,74 @@
+// Memory-mapped views over PM3 save files (GAMEnA/B/C) and other binary data files.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include "pm3_defs.hh"
+
+namespace io {
+
+// Private (copy-on-write) mapping of a whole file. Reads are served straight from the page cache;
+// the first write to a page gives this mapping its own copy and never reaches the file on disk.
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::filesystem::path &path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    const uint8_t *data() const { return bytes; }
+    uint8_t *mutableData() { return bytes; }
+    std::size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+    const std::filesystem::path &path() const { return filePath; }
+
+private:
+    void release();
+
+    std::filesystem::path filePath;
+    uint8_t *bytes = nullptr;
+    std::size_t length = 0;
+#ifdef _WIN32
+    std::vector<uint8_t> fallback;
+#endif
+};
+
+// Reads a file that must be exactly `size` bytes into caller-owned memory with pread. A file that
+// is missing, another size, or shortened by another process while being read gives false; a
+// mapping would fault (SIGBUS) on the truncated pages instead.
+bool readExact(const std::filesystem::path &path, void *out, std::size_t size);
+
+// Typed view over the three files of a save slot. Sizes are validated up front, so the
+// accessors can hand out references into the mappings without further checks. Only for files no
+// other program is rewriting (exported copies, backups): a truncated file faults on access. Live
+// slots are copied out instead (loadBinaries, readExact).
+class SaveView {
+public:
+    SaveView(const std::filesystem::path &gameaPath, const std::filesystem::path &gamebPath,
+             const std::filesystem::path &gamecPath);
+
+    const gamea &gameA() const { return *reinterpret_cast<const gamea *>(fileA.data()); }
+    const gameb &gameB() const { return *reinterpret_cast<const gameb *>(fileB.data()); }
+    const gamec &gameC() const { return *reinterpret_cast<const gamec *>(fileC.data()); }
+
+    // Editable access; only the pages actually written are duplicated.
+    gamea &editGameA() { return *reinterpret_cast<gamea *>(fileA.mutableData()); }
+    ClubRecord &editClub(int idx) { return reinterpret_cast<gameb *>(fileB.mutableData())->club[idx]; }
+    PlayerRecord &editPlayer(int16_t idx) { return reinterpret_cast<gamec *>(fileC.mutableData())->player[idx]; }
+
+    void copyTo(gamea &gameDataOut, gameb &clubDataOut, gamec &playerDataOut) const;
+
+private:
+    MappedFile fileA;
+    MappedFile fileB;
+    MappedFile fileC;
+};
+
+} // namespace io
@@ -0,0 +1,144 @@
+// Hot reload of save slots written by another program (PM3 under DOSBox): spots finished writes
+// to GAMEnA/B/C and describes what changed record by record.
+#include "save_watcher.h"
+
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <system_error>
+
+namespace io {
+
+bool parseSaveFileName(const std::string &name, int &gameNumber, char &gameLetter) {
+    if (name.size() != kGameFilePrefix.size() + 2 || name.compare(0, kGameFilePrefix.size(), kGameFilePrefix) != 0) {
+        return false;
+    }
+    char digit = name[kGameFilePrefix.size()];
+    char letter = static_cast<char>(std::toupper(static_cast<unsigned char>(name.back())));
+    if (digit < '1' || digit > '8' || letter < 'A' || letter > 'C') {
+        return false;
+    }
+    gameNumber = digit - '0';
+    gameLetter = letter;
+    return true;
+}
+
+std::uintmax_t expectedSaveFileSize(char gameLetter) {
+    switch (gameLetter) {
+        case 'A':
+            return sizeof(gamea);
+        case 'B':
+            return sizeof(gameb);
+        case 'C':
+            return sizeof(gamec);
+        default:
+            return 0;
+    }
+}
+
+SaveWatcher::SaveWatcher(const std::filesystem::path &savesFolder, std::chrono::milliseconds quietPeriod)
+    : watch(savesFolder), quietPeriod(quietPeriod) {}
+
+void SaveWatcher::markPending(const std::string &name, Clock::time_point now) {
+    int gameNumber = 0;
+    char gameLetter = 0;
+    if (!parseSaveFileName(name, gameNumber, gameLetter)) {
+        return;
+    }
+    std::error_code ec;
+    std::filesystem::path path = folder() / name;
+    PendingFile &file = pending[name];
+    file.size = std::filesystem::file_size(path, ec);
+    file.writeTime = std::filesystem::last_write_time(path, ec);
+    file.lastChange = now;
+}
+
+std::vector<SettledSaveFile> SaveWatcher::poll(Clock::time_point now) {
+    std::vector<SettledSaveFile> settled;
+    if (folder().empty()) {
+        return settled;
+    }
+
+    std::vector<FolderEvent> events;
+    watch.poll(&events);
+    for (const FolderEvent &event : events) {
+        if (!event.name.empty()) {
+            markPending(event.name, now);
+            continue;
+        }
+        // No names from the mtime fallback (or an overflowed queue): any slot may have changed.
+        std::error_code ec;
+        for (const auto &entry : std::filesystem::directory_iterator(folder(), ec)) {
+            markPending(entry.path().filename().string(), now);
+        }
+    }
+
+    for (auto it = pending.begin(); it != pending.end();) {
+        std::error_code ec;
+        std::filesystem::path path = folder() / it->first;
+        std::uintmax_t size = std::filesystem::file_size(path, ec);
+        auto writeTime = std::filesystem::last_write_time(path, ec);
+        if (ec) {
+            it = pending.erase(it);
+            continue;
+        }
+
+        PendingFile &file = it->second;
+        if (size != file.size || writeTime != file.writeTime) {
+            file.size = size;
+            file.writeTime = writeTime;
+            file.lastChange = now;
+            ++it;
+            continue;
+        }
+
+        int gameNumber = 0;
+        char gameLetter = 0;
+        parseSaveFileName(it->first, gameNumber, gameLetter);
+        if (now - file.lastChange < quietPeriod || size != expectedSaveFileSize(gameLetter)) {
+            ++it;
+            continue;
+        }
+        settled.push_back({gameNumber, gameLetter, path, writeTime});
+        it = pending.erase(it);
+    }
+    return settled;
+}
+
+void diffRecords(const gamea &before, const gamea &after, RecordChanges &changes) {
+    const auto *lhs = reinterpret_cast<const unsigned char *>(&before);
+    const auto *rhs = reinterpret_cast<const unsigned char *>(&after);
+    for (std::size_t i = 0; i < sizeof(gamea); ++i) {
+        changes.gameDataBytes += lhs[i] != rhs[i];
+    }
+}
+
+void diffRecords(const gameb &before, const gameb &after, RecordChanges &changes) {
+    for (int i = 0; i < kClubIdxMax; ++i) {
+        if (std::memcmp(&before.club[i], &after.club[i], sizeof(ClubRecord)) != 0) {
+            changes.clubs.push_back(i);
+        }
+    }
+}
+
+void diffRecords(const gamec &before, const gamec &after, RecordChanges &changes) {
+    constexpr int playerCount = static_cast<int>(sizeof(gamec) / sizeof(PlayerRecord));
+    for (int i = 0; i < playerCount; ++i) {
+        if (std::memcmp(&before.player[i], &after.player[i], sizeof(PlayerRecord)) != 0) {
+            changes.players.push_back(i);
+        }
+    }
+}
+
+std::string summarizeChanges(int gameNumber, const RecordChanges &changes) {
+    char line[96];
+    if (changes.empty()) {
+        snprintf(line, sizeof(line), "GAME%d RELOADED: NO RECORDS CHANGED", gameNumber);
+    } else {
+        snprintf(line, sizeof(line), "GAME%d RELOADED: %zu CLUBS, %zu PLAYERS, %zu BYTES GAME DATA", gameNumber,
+                 changes.clubs.size(), changes.players.size(), changes.gameDataBytes);
+    }
+    return line;
+}
+
+} // namespace io
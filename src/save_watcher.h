@@ -0,0 +1,77 @@
+// Hot reload of save slots written by another program (PM3 under DOSBox): spots finished writes
+// to GAMEnA/B/C and describes what changed record by record.
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "folder_watch.h"
+#include "pm3_data.h"
+
+namespace io {
+
+// DOSBox writes a save in several chunks; a file counts as finished once it has its full size and
+// has not been touched for this long.
+inline constexpr std::chrono::milliseconds kSaveQuietPeriod{750};
+
+struct SettledSaveFile {
+    int gameNumber = 0;
+    char gameLetter = 0;
+    std::filesystem::path path;
+    std::filesystem::file_time_type writeTime;
+};
+
+// Splits "GAME3B" into 3 and 'B'; false for anything that is not a slot file.
+bool parseSaveFileName(const std::string &name, int &gameNumber, char &gameLetter);
+std::uintmax_t expectedSaveFileSize(char gameLetter);
+
+class SaveWatcher {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    SaveWatcher() = default;
+    explicit SaveWatcher(const std::filesystem::path &savesFolder,
+                         std::chrono::milliseconds quietPeriod = kSaveQuietPeriod);
+
+    const std::filesystem::path &folder() const { return watch.folder(); }
+
+    // Slot files that changed since the last call and have since settled. Files still being
+    // written stay pending and are reported by a later call.
+    std::vector<SettledSaveFile> poll(Clock::time_point now = Clock::now());
+
+private:
+    struct PendingFile {
+        std::uintmax_t size = 0;
+        std::filesystem::file_time_type writeTime;
+        Clock::time_point lastChange;
+    };
+
+    void markPending(const std::string &name, Clock::time_point now);
+
+    FolderWatch watch;
+    std::chrono::milliseconds quietPeriod{kSaveQuietPeriod};
+    std::map<std::string, PendingFile> pending;
+};
+
+// Records that differ between the in-memory slot and a file reloaded from disk.
+struct RecordChanges {
+    std::size_t gameDataBytes = 0;
+    std::vector<int> clubs;
+    std::vector<int> players;
+
+    bool empty() const { return gameDataBytes == 0 && clubs.empty() && players.empty(); }
+};
+
+void diffRecords(const gamea &before, const gamea &after, RecordChanges &changes);
+void diffRecords(const gameb &before, const gameb &after, RecordChanges &changes);
+void diffRecords(const gamec &before, const gamec &after, RecordChanges &changes);
+
+// One footer line, e.g. "GAME2 RELOADED: 3 CLUBS, 41 PLAYERS, 96 BYTES GAME DATA".
+std::string summarizeChanges(int gameNumber, const RecordChanges &changes);
+
+} // namespace io
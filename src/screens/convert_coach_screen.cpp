@@ -4,6 +4,7 @@
 #include <functional>
 #include <string>
 
+#include "dirty_tracker.h"
 #include "text.h"
 #include "game_utils.h"
 
@@ -45,6 +46,7 @@ void queueConvertCoachFax(int16_t playerIdx) {
         slot = 0;
     }
 
+    dirty_tracker::markGameData(&news[slot], sizeof(news[slot]));
     news[slot].type = 20;
     news[slot].amount = 0;
     news[slot].ix1 = 0;
@@ -36,11 +36,6 @@ void FreePlayersScreen::draw(bool attachClickCallbacks) {
 
     context.setPagination(currentPage, totalPages);
 
-    int start = (currentPage - 1) * pageSize;
-    long unsigned int end = pageSize * currentPage;
-    end = end < players.size() ? end : players.size();
-
-    std::vector<club_player> displayPlayers(players.begin() + start, players.begin() + end);
-
-    context.writePlayers(displayPlayers, textLine, nullptr);
+    std::size_t start = static_cast<std::size_t>((currentPage - 1) * pageSize);
+    context.writePlayers(PlayerRowSpan(players).subspan(start, pageSize), textLine, nullptr);
 }
@@ -1,11 +1,12 @@
 #include "my_team_screen.h"
 
+#include "game_utils.h"
 #include "text.h"
 
-void MyTeamScreen::draw([[maybe_unused]] bool attachClickCallbacks) {
+void MyTeamScreen::draw(bool attachClickCallbacks) {
     context.writeHeader("TEAM SQUAD", 1, nullptr);
 
-    std::vector<club_player> myPlayers = getMyPlayers(0);
+    std::vector<PlayerRow> myPlayers = getMyPlayers(0);
 
     if (myPlayers.empty()) {
         context.writeText("No players found", 8, Colors::TEXT_1, TEXT_TYPE_SMALL, nullptr, 0);
@@ -14,7 +15,12 @@ void MyTeamScreen::draw([[maybe_unused]] bool attachClickCallbacks) {
 
     int textLine = 4;
 
-    textLine = context.writePlayers(myPlayers, textLine, std::function<void(const club_player &)>{});
+    // Clicking a player looks for others like them, e.g. to replace one who is leaving.
+    textLine = context.writePlayers(myPlayers, textLine, attachClickCallbacks && context.showSimilarPlayers
+                                                         ? [this](const PlayerRow &row) {
+                                                             context.showSimilarPlayers(game_utils::selectPlayer(row));
+                                                         }
+                                                         : std::function<void(const PlayerRow &)>{});
 
     for (int i = textLine; i <= 27; i++) {
         char playerRow[69] = "................ . ............ .. .. .. .. .. .. .. . . . .. .....";
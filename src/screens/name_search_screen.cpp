@@ -0,0 +1,91 @@
+#include "name_search_screen.h"
+
+#include <cstdio>
+#include <vector>
+
+#include "config/constants.h"
+#include "game_utils.h"
+#include "name_index.h"
+#include "roster_index.h"
+#include "text.h"
+
+namespace {
+constexpr int kFirstResultLine = 5;
+constexpr int kMaxResults = 11;
+
+// The club whose squad shows the match, or -1 for a player without one.
+int clubFor(const name_index::Match &match) {
+    if (match.kind == name_index::Kind::Club) {
+        return match.index;
+    }
+    return roster_index::find(match.index).club;
+}
+} // namespace
+
+void NameSearchScreen::draw(bool attachClickCallbacks) {
+    context.writeHeader("FIND", 1, nullptr);
+    context.writeSubHeader("TYPE A PLAYER OR CLUB NAME", 2, nullptr);
+
+    // Typing starts as soon as the screen is entered.
+    if (attachClickCallbacks && !context.readingTextInput()) {
+        startTyping();
+    }
+
+    const char *typed = context.currentTextInput();
+    char text[70];
+    snprintf(text, sizeof(text), "NAME: %s_", context.readingTextInput() ? typed : "");
+    context.writeText(text, 3, Colors::TEXT_1, TEXT_TYPE_SMALL, nullptr, 0);
+
+    std::vector<name_index::Match> matches = name_index::live().find(typed, kMaxResults);
+    if (attachClickCallbacks) {
+        int firstClub = matches.empty() ? -1 : clubFor(matches.front());
+        context.addKeyPressCallback(SDLK_RETURN, [this, firstClub] {
+            if (firstClub >= 0) {
+                context.scoutClub(firstClub);
+            }
+        });
+    }
+
+    if (matches.empty()) {
+        if (typed[0] != '\0') {
+            context.writeText("No names match", kFirstResultLine, Colors::TEXT_1, TEXT_TYPE_SMALL, nullptr, 0);
+        }
+        return;
+    }
+
+    int line = kFirstResultLine;
+    for (const name_index::Match &match : matches) {
+        int clubIdx = clubFor(match);
+        if (match.kind == name_index::Kind::Club) {
+            ClubRecord &club = getClub(match.index);
+            const char *division = match.index < roster_index::kIndexedClubs
+                                   ? divisionNames[normalizedLeagueTier(club)] : "";
+            snprintf(text, sizeof(text), "%-16.16s   %s", club.name, division);
+        } else {
+            PlayerRecord &player = getPlayer(match.index);
+            snprintf(text, sizeof(text), "%-12.12s %c   %-16.16s", player.name, determinePlayerType(player),
+                     clubIdx >= 0 ? getClub(clubIdx).name : "NO CLUB");
+        }
+
+        std::function<void(void)> callback;
+        if (attachClickCallbacks && clubIdx >= 0) {
+            callback = [this, clubIdx] { context.scoutClub(clubIdx); };
+        }
+        context.writeText(text, line, context.defaultTextColor(line), TEXT_TYPE_SMALL, callback, 0);
+        ++line;
+    }
+}
+
+void NameSearchScreen::startTyping() {
+    // Every keystroke changes the results, so their click areas are laid out again.
+    auto relayout = [this] {
+        context.resetClickableAreas();
+        context.setClickableAreasConfigured(false);
+    };
+    context.startReadingNameInput(relayout);
+    // Escape clears the name rather than leaving the screen without a way to type.
+    context.addKeyPressCallback(SDLK_ESCAPE, [this, relayout] {
+        startTyping();
+        relayout();
+    });
+}
@@ -0,0 +1,15 @@
+// Find a player or club by name.
+#pragma once
+
+#include "screen.h"
+
+class NameSearchScreen : public Screen {
+public:
+    explicit NameSearchScreen(const ScreenContext &ctx) : context(ctx) {}
+    void draw(bool attachClickCallbacks) override;
+
+private:
+    void startTyping();
+
+    ScreenContext context;
+};
@@ -0,0 +1,143 @@
+#include "player_search_screen.h"
+
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+
+#include "config/constants.h"
+#include "player_search.h"
+#include "text.h"
+
+namespace {
+struct Criterion {
+    const char *name;
+    int optionCount;
+    const char *(*label)(int choice);
+    void (*apply)(int choice, player_search::Query &query);
+};
+
+constexpr const char *kRoleLabels[] = {"ANY", "GOALKEEPERS", "DEFENDERS", "MIDFIELDERS", "ATTACKERS"};
+constexpr const char *kRoleCodes[] = {"", "G", "D", "M", "A"};
+constexpr const char *kAgeLabels[] = {"ANY", "16-20", "21-23", "24-28", "29-32", "33+"};
+constexpr int kAgeBands[][2] = {{0, 63}, {16, 20}, {21, 23}, {24, 28}, {29, 32}, {33, 63}};
+constexpr const char *kRatingLabels[] = {"ANY", "50+", "60+", "70+", "80+", "90+"};
+constexpr int kMinRatings[] = {0, 50, 60, 70, 80, 90};
+constexpr const char *kContractLabels[] = {"ANY", "ENDING", "1 YEAR OR LESS", "2 YEARS OR LESS"};
+constexpr const char *kStatusLabels[] = {"ANY", "NOT INJURED", "AVAILABLE"};
+constexpr std::uint32_t kStatusExclusions[] = {0, player_search::kInjuryPeriodTypes, player_search::kAllPeriodTypes};
+
+const Criterion kCriteria[] = {
+        {"ROLE", static_cast<int>(std::size(kRoleLabels)),
+         [](int choice) { return kRoleLabels[choice]; },
+         [](int choice, player_search::Query &query) { query.roles = kRoleCodes[choice]; }},
+        {"AGE", static_cast<int>(std::size(kAgeLabels)),
+         [](int choice) { return kAgeLabels[choice]; },
+         [](int choice, player_search::Query &query) {
+             query.minAge = kAgeBands[choice][0];
+             query.maxAge = kAgeBands[choice][1];
+         }},
+        {"RATING", static_cast<int>(std::size(kRatingLabels)),
+         [](int choice) { return kRatingLabels[choice]; },
+         [](int choice, player_search::Query &query) { query.minRating = kMinRatings[choice]; }},
+        {"FOOT", 4,
+         [](int choice) { return choice == 0 ? "ANY" : footLongLabels[choice - 1]; },
+         [](int choice, player_search::Query &query) { query.foot = choice - 1; }},
+        {"CONTRACT", static_cast<int>(std::size(kContractLabels)),
+         [](int choice) { return kContractLabels[choice]; },
+         [](int choice, player_search::Query &query) { query.maxContract = choice == 0 ? 7 : choice - 1; }},
+        {"STATUS", static_cast<int>(std::size(kStatusLabels)),
+         [](int choice) { return kStatusLabels[choice]; },
+         [](int choice, player_search::Query &query) { query.excludedPeriodTypes = kStatusExclusions[choice]; }},
+        {"DIVISION", static_cast<int>(std::size(divisionNames)) + 1,
+         [](int choice) { return choice == 0 ? "ANY" : divisionNames[choice - 1]; },
+         [](int choice, player_search::Query &query) {
+             if (choice > 0) {
+                 query.minDivision = query.maxDivision = choice - 1;
+             }
+         }},
+};
+static_assert(std::size(kCriteria) == 7, "one choice per criterion");
+} // namespace
+
+void PlayerSearchScreen::draw(bool attachClickCallbacks) {
+    context.writeHeader("PLAYER SEARCH", 1, nullptr);
+
+    if (showingResults) {
+        drawResults(attachClickCallbacks);
+    } else {
+        drawCriteria(attachClickCallbacks);
+    }
+}
+
+void PlayerSearchScreen::drawCriteria(bool attachClickCallbacks) {
+    context.writeSubHeader("CLICK A CRITERION TO CHANGE IT", 2, nullptr);
+
+    player_search::Query query;
+    for (std::size_t i = 0; i < std::size(kCriteria); ++i) {
+        const Criterion &criterion = kCriteria[i];
+        criterion.apply(choices[i], query);
+
+        char text[70];
+        snprintf(text, sizeof(text), "%-12s %s", criterion.name, criterion.label(choices[i]));
+        int line = static_cast<int>(i) + 3;
+        context.writeText(text, line, context.defaultTextColor(line), TEXT_TYPE_SMALL,
+                          attachClickCallbacks ? std::function<void(void)>{ [this, i] {
+                              choices[i] = (choices[i] + 1) % kCriteria[i].optionCount;
+                              context.resetClickableAreas();
+                              context.setClickableAreasConfigured(false);
+                          }} : nullptr,
+                          0);
+    }
+
+    const player_search::Index &index = player_search::live();
+    std::size_t matches = index.match(query).count();
+    char text[70];
+    snprintf(text, sizeof(text), "SHOW %zu PLAYERS", matches);
+    context.writeText(text, 11, Colors::TEXT_1, TEXT_TYPE_SMALL,
+                      attachClickCallbacks ? std::function<void(void)>{ [this] { showResults(true); }} : nullptr, 0);
+}
+
+void PlayerSearchScreen::drawResults(bool attachClickCallbacks) {
+    context.writeSubHeader("« CHANGE SEARCH", 2,
+                           attachClickCallbacks ? std::function<void(void)>{ [this] { showResults(false); }}
+                                                : nullptr);
+
+    player_search::Query query;
+    for (std::size_t i = 0; i < std::size(kCriteria); ++i) {
+        kCriteria[i].apply(choices[i], query);
+    }
+    std::vector<PlayerRow> players = player_search::search(query);
+
+    if (players.empty()) {
+        context.writeText("No players match", 8, Colors::TEXT_1, TEXT_TYPE_SMALL, nullptr, 0);
+        context.setPagination(0, 0);
+        return;
+    }
+
+    int textLine = 4;
+    int pageSize = 25;
+    int currentPage = context.currentPage();
+    int totalPages = 0;
+
+    if (players.size() > 25) {
+        pageSize = 24;
+        totalPages = static_cast<int>(std::ceil(static_cast<double>(players.size()) / pageSize));
+    }
+
+    if (currentPage == 0 || currentPage > totalPages) {
+        currentPage = 1;
+    }
+
+    context.setPagination(currentPage, totalPages);
+
+    std::size_t start = static_cast<std::size_t>((currentPage - 1) * pageSize);
+    context.writePlayers(PlayerRowSpan(players).subspan(start, pageSize), textLine, nullptr);
+}
+
+void PlayerSearchScreen::showResults(bool show) {
+    showingResults = show;
+    context.setPagination(0, 0);
+    context.setFooterLine("");
+    context.resetClickableAreas();
+    context.setClickableAreasConfigured(false);
+}
@@ -0,0 +1,22 @@
+// Player search screen.
+#pragma once
+
+#include <array>
+
+#include "screen.h"
+
+class PlayerSearchScreen : public Screen {
+public:
+    explicit PlayerSearchScreen(const ScreenContext &ctx) : context(ctx) {}
+    void draw(bool attachClickCallbacks) override;
+
+private:
+    void drawCriteria(bool attachClickCallbacks);
+    void drawResults(bool attachClickCallbacks);
+    void showResults(bool show);
+
+    ScreenContext context;
+    // The option picked for each criterion, kept while the user looks elsewhere.
+    std::array<int, 7> choices{};
+    bool showingResults = false;
+};
@@ -4,6 +4,8 @@
 #include <memory>
 #include <string>
 
+#include "dirty_tracker.h"
+#include "roster_index.h"
 #include "text.h"
 #include "game_utils.h"
 
@@ -13,7 +15,7 @@ constexpr int kLoanPeriodType = 20;
 constexpr int kTurnsPerWeek = 3;
 
 struct LoanState {
-    club_player playerInfo;
+    PlayerSelection selection;
     int weeks = 0;
     int fee = 0;
     int16_t playerIdx = -1;
@@ -39,6 +41,9 @@ void finalizeLoan(ScreenContext &context, const std::shared_ptr<LoanState> &stat
 
     context.resetKeyPressCallbacks();
 
+    // The save may have been reloaded while the loan was being entered.
+    state->playerIdx = game_utils::resolvePlayer(state->selection);
+    state->fromClubIdx = game_utils::findClubIndexForPlayer(state->playerIdx);
     if (state->playerIdx < 0 || state->fromClubIdx < 0) {
         context.setFooterLine("Player not found");
         return;
@@ -63,11 +68,12 @@ void finalizeLoan(ScreenContext &context, const std::shared_ptr<LoanState> &stat
         return;
     }
 
-    for (int slot = 0; slot < 24; ++slot) {
-        if (fromClub.player_index[slot] == state->playerIdx) {
-            fromClub.player_index[slot] = -1;
-            break;
-        }
+    dirty_tracker::markClub(myClubIdx);
+    dirty_tracker::markClub(state->fromClubIdx);
+    dirty_tracker::markPlayer(state->playerIdx);
+    roster_index::Placement placement = roster_index::find(state->playerIdx);
+    if (placement.club == state->fromClubIdx) {
+        roster_index::setSlot(state->fromClubIdx, placement.slot, -1);
     }
 
     int destSlot = game_utils::findEmptySlot(myClub);
@@ -76,7 +82,8 @@ void finalizeLoan(ScreenContext &context, const std::shared_ptr<LoanState> &stat
         return;
     }
 
-    myClub.player_index[destSlot] = state->playerIdx;
+    roster_index::setSlot(myClubIdx, destSlot, state->playerIdx);
+    roster_index::check("a loan");
     myClub.bank_account -= state->fee;
     fromClub.bank_account += state->fee;
 
@@ -87,15 +94,15 @@ void finalizeLoan(ScreenContext &context, const std::shared_ptr<LoanState> &stat
     context.setFooterLine("Player is loaned");
 }
 
-void startLoanFlow(ScreenContext &context, const club_player &playerInfo) {
+void startLoanFlow(ScreenContext &context, const PlayerSelection &selection) {
     if (!context.startReadingTextInput || !context.endReadingTextInput || !context.currentTextInput ||
         !context.addKeyPressCallback || !context.resetKeyPressCallbacks || !context.setFooterLine) {
         return;
     }
 
     auto state = std::make_shared<LoanState>();
-    state->playerInfo = playerInfo;
-    state->playerIdx = game_utils::findPlayerIndex(playerInfo.player);
+    state->selection = selection;
+    state->playerIdx = game_utils::resolvePlayer(state->selection);
     if (state->playerIdx >= 0) {
         state->fromClubIdx = game_utils::findClubIndexForPlayer(state->playerIdx);
     }
@@ -125,7 +132,7 @@ void startLoanFlow(ScreenContext &context, const club_player &playerInfo) {
         }
 
         state->weeks = weeks;
-        state->fee = weeks * state->playerInfo.player.wage;
+        state->fee = weeks * getPlayer(state->playerIdx).wage;
 
         context.endReadingTextInput();
         context.resetKeyPressCallbacks();
@@ -148,29 +155,36 @@ void startLoanFlow(ScreenContext &context, const club_player &playerInfo) {
     context.addKeyPressCallback(SDLK_ESCAPE, [&context]() { clearInput(context); });
 }
 
-void startLoanOrBuyFlow(ScreenContext &context, const club_player &playerInfo) {
+// The player is picked out when the row is clicked, so a reload or undo before the key press
+// cannot turn the offer, loan or search into one for whoever holds that index by then.
+void startLoanOrBuyFlow(ScreenContext &context, const PlayerRow &row) {
+    PlayerSelection selection = game_utils::selectPlayer(row);
     if (!context.addKeyPressCallback || !context.resetKeyPressCallbacks || !context.setFooterLine) {
         if (context.makeOffer) {
-            context.makeOffer(playerInfo);
+            context.makeOffer(selection);
         }
         return;
     }
 
     context.resetKeyPressCallbacks();
-    context.setFooterLine("           Loan or buy [L/B]?");
+    context.setFooterLine("           Loan, buy or find similar [L/B/S]?");
 
-    context.addKeyPressCallback('b', [&context, playerInfo]() {
+    context.addKeyPressCallback('b', [&context, selection]() {
         if (context.makeOffer) {
-            context.makeOffer(playerInfo);
+            context.makeOffer(selection);
         }
     });
-    context.addKeyPressCallback('B', [&context, playerInfo]() {
+    context.addKeyPressCallback('B', [&context, selection]() {
         if (context.makeOffer) {
-            context.makeOffer(playerInfo);
+            context.makeOffer(selection);
         }
     });
-    context.addKeyPressCallback('l', [&context, playerInfo]() { startLoanFlow(context, playerInfo); });
-    context.addKeyPressCallback('L', [&context, playerInfo]() { startLoanFlow(context, playerInfo); });
+    context.addKeyPressCallback('l', [&context, selection]() { startLoanFlow(context, selection); });
+    context.addKeyPressCallback('L', [&context, selection]() { startLoanFlow(context, selection); });
+    if (context.showSimilarPlayers) {
+        context.addKeyPressCallback('s', [&context, selection]() { context.showSimilarPlayers(selection); });
+        context.addKeyPressCallback('S', [&context, selection]() { context.showSimilarPlayers(selection); });
+    }
     context.addKeyPressCallback(SDLK_ESCAPE, [&context]() { clearInput(context); });
 }
 } // namespace
@@ -180,24 +194,33 @@ void ScoutScreen::draw(bool attachClickCallbacks) {
 
     if (context.selectedDivision() == -1) {
         context.writeDivisionsMenu("CHOOSE DIVISION TO SCOUT", attachClickCallbacks);
+        context.writeText("SEARCH ALL PLAYERS", 9, Colors::TEXT_1, TEXT_TYPE_SMALL,
+                          attachClickCallbacks && context.openPlayerSearch
+                          ? std::function<void(void)>{ [this] { context.openPlayerSearch(); }}
+                          : nullptr,
+                          0);
+        context.writeText("FIND BY NAME", 10, Colors::TEXT_1, TEXT_TYPE_SMALL,
+                          attachClickCallbacks && context.openNameSearch
+                          ? std::function<void(void)>{ [this] { context.openNameSearch(); }}
+                          : nullptr,
+                          0);
     } else if (context.selectedClub() == -1) {
         context.writeClubMenu("CHOOSE TEAM TO SCOUT", attachClickCallbacks);
     } else {
         ClubRecord &club = getClub(context.selectedClub());
-        std::vector<club_player> players{};
+        std::vector<PlayerRow> players{};
 
         for (int i = 0; i < 24; ++i) {
             if (club.player_index[i] == -1) {
                 continue;
             }
-            PlayerRecord &p = getPlayer(club.player_index[i]);
-            players.push_back(club_player{club, p});
+            players.push_back({static_cast<int16_t>(context.selectedClub()), club.player_index[i]});
         }
 
         int textLine = 4;
-        context.writePlayers(players, textLine, attachClickCallbacks ? [this](const club_player &playerInfo) {
-            startLoanOrBuyFlow(context, playerInfo);
-        } : std::function<void(const club_player &)>{});
+        context.writePlayers(players, textLine, attachClickCallbacks ? [this](const PlayerRow &row) {
+            startLoanOrBuyFlow(context, row);
+        } : std::function<void(const PlayerRow &)>{});
 
         context.writeText(
                 "« Back",
@@ -8,6 +8,8 @@
 #include <SDL.h>
 #include "pm3_defs.hh"
 
+struct PlayerSelection;
+
 struct ScreenContext {
     std::function<void(const char *)> drawBackground;
     std::function<void(const char *, int, const std::function<void(void)> &)> writeTextLarge;
@@ -30,9 +32,9 @@ struct ScreenContext {
     std::function<void(int)> saveGameConfirm;
     std::function<void(const char *, int, const std::function<void(void)> &)> writeHeader;
     std::function<void(const char *, int, const std::function<void(void)> &)> writeSubHeader;
-    std::function<std::vector<club_player>&()> freePlayersRef;
+    std::function<std::vector<PlayerRow>&()> freePlayersRef;
     std::function<void()> refreshFreePlayers;
-    std::function<int(std::vector<club_player> &, int &, const std::function<void(const club_player &)> &)> writePlayers;
+    std::function<int(PlayerRowSpan, int &, const std::function<void(const PlayerRow &)> &)> writePlayers;
     std::function<void(const char *)> setFooterLine;
     std::function<void()> resetTextBlocks;
     std::function<int()> selectedDivision;
@@ -43,9 +45,16 @@ struct ScreenContext {
     std::function<void(SDL_Keycode, const std::function<void(void)> &)> addKeyPressCallback;
     std::function<void()> resetKeyPressCallbacks;
     std::function<void(std::function<void(void)>)> startReadingTextInput;
+    std::function<void(std::function<void(void)>)> startReadingNameInput;
+    std::function<bool()> readingTextInput;
     std::function<void()> endReadingTextInput;
     std::function<const char *()> currentTextInput;
-    std::function<void(const club_player &)> makeOffer;
+    std::function<void(const PlayerSelection &)> makeOffer;
+    std::function<void()> openPlayerSearch;
+    std::function<void()> openNameSearch;
+    std::function<void(int)> scoutClub;
+    std::function<void(const PlayerSelection &)> showSimilarPlayers;
+    std::function<const PlayerSelection &()> similarPlayersTarget;
     std::function<void(const char *, bool)> writeDivisionsMenu;
     std::function<void(const char *, bool)> writeClubMenu;
     std::function<void(struct gamea::ManagerRecord &, ClubRecord &, int8_t)> convertPlayerToCoach;
@@ -0,0 +1,44 @@
+#include "similar_players_screen.h"
+
+#include <cstdio>
+#include <vector>
+
+#include "config/constants.h"
+#include "game_utils.h"
+#include "similar_players.h"
+#include "text.h"
+
+namespace {
+constexpr std::size_t kMaxSimilar = 20;
+} // namespace
+
+void SimilarPlayersScreen::draw(bool attachClickCallbacks) {
+    context.writeHeader("SIMILAR PLAYERS", 1, nullptr);
+
+    // The save may have been reloaded since the player was picked.
+    int16_t target = game_utils::resolvePlayer(context.similarPlayersTarget());
+    if (target < 0) {
+        context.writeText("Player not found", 8, Colors::TEXT_1, TEXT_TYPE_SMALL, nullptr, 0);
+        return;
+    }
+
+    char heading[70];
+    snprintf(heading, sizeof(heading), "LIKE %.12s, WITHIN YOUR BUDGET", getPlayer(target).name);
+    context.writeSubHeader(heading, 2, nullptr);
+
+    std::vector<PlayerRow> players;
+    int myClubIdx = gameData.manager[0].club_idx;
+    for (const similar_players::Neighbour &neighbour : similar_players::findSimilar(target, kMaxSimilar, myClubIdx)) {
+        players.push_back({static_cast<int16_t>(neighbour.club), neighbour.player});
+    }
+
+    if (players.empty()) {
+        context.writeText("No affordable players found", 8, Colors::TEXT_1, TEXT_TYPE_SMALL, nullptr, 0);
+        return;
+    }
+
+    int textLine = 4;
+    context.writePlayers(players, textLine, attachClickCallbacks ? [this](const PlayerRow &row) {
+        context.makeOffer(game_utils::selectPlayer(row));
+    } : std::function<void(const PlayerRow &)>{});
+}
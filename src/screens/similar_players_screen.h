@@ -0,0 +1,13 @@
+// Similar players screen.
+#pragma once
+
+#include "screen.h"
+
+class SimilarPlayersScreen : public Screen {
+public:
+    explicit SimilarPlayersScreen(const ScreenContext &ctx) : context(ctx) {}
+    void draw(bool attachClickCallbacks) override;
+
+private:
+    ScreenContext context;
+};
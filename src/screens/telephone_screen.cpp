@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 
+#include "dirty_tracker.h"
 #include "text.h"
 #include "pm3_data.h"
 #include "game_utils.h"
@@ -141,6 +142,7 @@ void TelephoneScreen::draw(bool attachClickCallbacks) {
             showInsufficientFunds();
             return false;
         }
+        dirty_tracker::markClub(club);
         club.bank_account -= amount;
         return true;
     };
@@ -187,6 +189,7 @@ void TelephoneScreen::draw(bool attachClickCallbacks) {
                     }
 
                     for (int i = 0; i < 24; ++i) {
+                        dirty_tracker::markPlayer(club.player_index[i]);
                         PlayerRecord &player = getPlayer(club.player_index[i]);
                         player.morl = 9;
                     }
@@ -212,6 +215,7 @@ void TelephoneScreen::draw(bool attachClickCallbacks) {
                     }
 
                     for (int i = 0; i < 24; ++i) {
+                        dirty_tracker::markPlayer(club.player_index[i]);
                         PlayerRecord &player = getPlayer(club.player_index[i]);
                         player.hn = std::min(player.hn + std::rand() % 2, 99);
                         player.tk = std::min(player.tk + std::rand() % 2, 99);
@@ -245,6 +249,7 @@ void TelephoneScreen::draw(bool attachClickCallbacks) {
                     }
 
                     for (int i = 0; i < 24; ++i) {
+                        dirty_tracker::markPlayer(club.player_index[i]);
                         PlayerRecord &player = getPlayer(club.player_index[i]);
 
                         player.hn += std::rand() % 4;
@@ -286,6 +291,7 @@ void TelephoneScreen::draw(bool attachClickCallbacks) {
                     }
 
                     for (int i = 0; i < 24; ++i) {
+                        dirty_tracker::markPlayer(club.player_index[i]);
                         PlayerRecord &player = getPlayer(club.player_index[i]);
                         player.hn = std::min(player.hn + std::rand() % 8, 99);
                         player.tk = std::min(player.tk + std::rand() % 8, 99);
@@ -312,6 +318,7 @@ void TelephoneScreen::draw(bool attachClickCallbacks) {
                     std::string result = "No banned player found";
 
                     for (int i = 0; i < 24; ++i) {
+                        dirty_tracker::markPlayer(club.player_index[i]);
                         PlayerRecord &player = getPlayer(club.player_index[i]);
                         if (player.period > 0 && player.period_type == 0) {
                             if (std::rand() % 2 == 0) {
@@ -343,6 +350,7 @@ void TelephoneScreen::draw(bool attachClickCallbacks) {
                         return;
                     }
 
+                    dirty_tracker::markGameData(&manager.stadium, sizeof(manager.stadium));
                     club.seating_max = 25000;
 
                     manager.stadium.ground_facilities.level = 2;
@@ -384,6 +392,7 @@ void TelephoneScreen::draw(bool attachClickCallbacks) {
                     if (!attemptSpend(club, upgradeCost)) {
                         return;
                     }
+                    dirty_tracker::markGameData(&manager.stadium, sizeof(manager.stadium));
                     club.seating_max = 50000;
 
                     manager.stadium.ground_facilities.level = 2;
@@ -426,6 +435,7 @@ void TelephoneScreen::draw(bool attachClickCallbacks) {
                         return;
                     }
 
+                    dirty_tracker::markGameData(&manager.stadium, sizeof(manager.stadium));
                     club.seating_max = 100000;
 
                     manager.stadium.ground_facilities.level = 3;
@@ -0,0 +1,304 @@
+// Monte Carlo projection of the rest of the league season: plays the remaining fixtures many
+// times from squad-based team strengths and counts titles, promotions and relegations.
+#include "season_simulator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <thread>
+#include <utility>
+
+#include "player_attributes.h"
+
+namespace season_simulator {
+namespace {
+constexpr int kClubs = static_cast<int>(sizeof(gameb) / sizeof(ClubRecord));
+constexpr int kPlayers = static_cast<int>(sizeof(gamec) / sizeof(PlayerRecord));
+constexpr int kWeeks = static_cast<int>(sizeof(ClubRecord::Timetable::week) / sizeof(ClubRecord::TimetableWeek));
+constexpr int kTurnsPerWeek = 3;
+constexpr int kLastUnavailablePeriodType = 17; // banned, on international duty or injured up to here
+
+constexpr double kBaseGoals = 1.35;
+constexpr double kStrengthExponent = 2.0;
+constexpr int kMaxGoals = 9;
+constexpr int kBatchSeasons = 64;
+
+// xoshiro256**, seeded through splitmix64. Small state, so every batch can own one.
+class Rng {
+public:
+    explicit Rng(std::uint64_t seed) {
+        for (std::uint64_t &word : state) {
+            seed += 0x9e3779b97f4a7c15ULL;
+            std::uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    std::uint64_t next() {
+        std::uint64_t result = rotl(state[1] * 5, 7) * 9;
+        std::uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+private:
+    static std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    std::uint64_t state[4];
+};
+
+// A fixture with both sides' goal distributions as cumulative 32-bit thresholds, so a match
+// takes one random number and a short scan.
+struct Match {
+    uint8_t first;
+    uint8_t second;
+    std::array<std::uint32_t, kMaxGoals> firstGoals;
+    std::array<std::uint32_t, kMaxGoals> secondGoals;
+};
+
+std::array<std::uint32_t, kMaxGoals> poissonThresholds(double expected) {
+    std::array<std::uint32_t, kMaxGoals> thresholds{};
+    double probability = std::exp(-expected);
+    double cumulative = 0.0;
+    for (int goals = 0; goals < kMaxGoals; ++goals) {
+        cumulative += probability;
+        probability *= expected / (goals + 1);
+        thresholds[goals] = static_cast<std::uint32_t>(std::min(cumulative, 1.0) * 4294967295.0);
+    }
+    return thresholds;
+}
+
+int drawGoals(const std::array<std::uint32_t, kMaxGoals> &thresholds, std::uint32_t random) {
+    int goals = 0;
+    while (goals < kMaxGoals && random >= thresholds[goals]) {
+        ++goals;
+    }
+    return goals;
+}
+
+std::vector<Match> prepareMatches(const Season &season) {
+    std::vector<Match> matches;
+    matches.reserve(season.fixtures.size());
+    for (const Fixture &fixture : season.fixtures) {
+        double ratio = std::max(season.teams[fixture.first].strength, 1.0f) /
+                       std::max(season.teams[fixture.second].strength, 1.0f);
+        double advantage = std::pow(ratio, kStrengthExponent);
+        matches.push_back({fixture.first, fixture.second, poissonThresholds(kBaseGoals * advantage),
+                           poissonThresholds(kBaseGoals / advantage)});
+    }
+    return matches;
+}
+
+struct Tally {
+    std::vector<std::uint32_t> titles, promotions, relegations;
+    std::vector<std::uint64_t> points, positions;
+
+    explicit Tally(std::size_t teams)
+        : titles(teams), promotions(teams), relegations(teams), points(teams), positions(teams) {}
+};
+
+struct Row {
+    int32_t points;
+    int32_t goalDifference;
+    int32_t goalsFor;
+};
+
+void playSeason(const Season &season, const std::vector<Match> &matches, Rng &rng, std::vector<Row> &rows,
+                std::vector<std::uint64_t> &keys, Tally &tally) {
+    for (std::size_t t = 0; t < season.teams.size(); ++t) {
+        const Team &team = season.teams[t];
+        rows[t] = {team.points, team.goalsFor - team.goalsAgainst, team.goalsFor};
+    }
+
+    for (const Match &match : matches) {
+        std::uint64_t random = rng.next();
+        int first = drawGoals(match.firstGoals, static_cast<std::uint32_t>(random >> 32));
+        int second = drawGoals(match.secondGoals, static_cast<std::uint32_t>(random));
+        Row &a = rows[match.first];
+        Row &b = rows[match.second];
+        a.goalsFor += first;
+        b.goalsFor += second;
+        a.goalDifference += first - second;
+        b.goalDifference += second - first;
+        a.points += first > second ? 3 : first == second ? 1 : 0;
+        b.points += second > first ? 3 : first == second ? 1 : 0;
+    }
+
+    for (int d = 0; d < kDivisions; ++d) {
+        int start = season.divisionStart[d];
+        int size = season.divisionStart[d + 1] - start;
+        // Points, then goal difference, then goals scored; the earlier table row on a full tie.
+        keys.clear();
+        for (int i = 0; i < size; ++i) {
+            const Row &row = rows[start + i];
+            keys.push_back((static_cast<std::uint64_t>(row.points + 0x8000) << 40) |
+                           (static_cast<std::uint64_t>(row.goalDifference + 0x8000) << 24) |
+                           (static_cast<std::uint64_t>(row.goalsFor & 0xffff) << 8) |
+                           static_cast<std::uint64_t>(255 - i));
+        }
+        std::sort(keys.begin(), keys.end(), std::greater<>());
+
+        int promoted = std::min(kPromotionPlaces[d], size);
+        int relegatedFrom = size - std::min(kRelegationPlaces[d], size);
+        for (int position = 0; position < size; ++position) {
+            int t = start + 255 - static_cast<int>(keys[position] & 0xff);
+            tally.titles[t] += position == 0;
+            tally.promotions[t] += position < promoted;
+            tally.relegations[t] += position >= relegatedFrom;
+            tally.points[t] += static_cast<std::uint64_t>(rows[t].points);
+            tally.positions[t] += static_cast<std::uint64_t>(position + 1);
+        }
+    }
+}
+} // namespace
+
+float teamStrength(const ClubRecord &club, const gamec &players, const player_attributes::RoleRatings &ratings) {
+    std::vector<std::pair<float, float>> available; // goalkeeping rating, best outfield rating
+    for (int slot = 0; slot < 24; ++slot) {
+        int16_t idx = club.player_index[slot];
+        if (idx < 0 || idx >= kPlayers) {
+            continue;
+        }
+        PlayerRecord player = players.player[idx];
+        if (player.period > 0 && player.period_type <= kLastUnavailablePeriodType) {
+            continue;
+        }
+        double outfield = std::max({ratings.rating[1][idx], ratings.rating[2][idx], ratings.rating[3][idx]});
+        available.emplace_back(static_cast<float>(ratings.rating[0][idx]), static_cast<float>(outfield));
+    }
+    if (available.empty()) {
+        return 0.0f;
+    }
+
+    auto keeper = std::max_element(available.begin(), available.end(),
+                                   [](const auto &a, const auto &b) { return a.first < b.first; });
+    float total = keeper->first;
+    available.erase(keeper);
+    std::vector<float> outfield;
+    for (const auto &ratings : available) {
+        outfield.push_back(ratings.second);
+    }
+    std::size_t picked = std::min<std::size_t>(outfield.size(), 10);
+    std::partial_sort(outfield.begin(), outfield.begin() + static_cast<std::ptrdiff_t>(picked), outfield.end(),
+                      std::greater<>());
+    for (std::size_t i = 0; i < picked; ++i) {
+        total += outfield[i];
+    }
+    return total / 11.0f;
+}
+
+Season fromSave(const gamea &game, const gameb &clubs, const gamec &players) {
+    Season season;
+    std::array<int, kClubs> teamOfClub;
+    teamOfClub.fill(-1);
+    player_attributes::RoleRatings ratings;
+    player_attributes::rateRoles(player_attributes::extract(players), ratings);
+
+    int row = 0;
+    for (int d = 0; d < kDivisions; ++d) {
+        season.divisionStart[d] = static_cast<uint16_t>(season.teams.size());
+        for (int i = 0; i < kDivisionSizes[d]; ++i, ++row) {
+            gamea::TableDivision entry = game.table.all[row];
+            if (entry.club_idx < 0 || entry.club_idx >= kClubs || teamOfClub[entry.club_idx] >= 0) {
+                continue;
+            }
+            Team team;
+            team.club = entry.club_idx;
+            team.division = static_cast<uint8_t>(d);
+            team.strength = teamStrength(clubs.club[entry.club_idx], players, ratings);
+            team.points = static_cast<int16_t>(3 * (entry.hw + entry.aw) + entry.hd + entry.ad);
+            team.goalsFor = static_cast<int16_t>(entry.hf + entry.af);
+            team.goalsAgainst = static_cast<int16_t>(entry.ha + entry.aa);
+            teamOfClub[entry.club_idx] = static_cast<int>(season.teams.size());
+            season.teams.push_back(team);
+        }
+    }
+    season.divisionStart[kDivisions] = static_cast<uint16_t>(season.teams.size());
+
+    // Every fixture is in both clubs' timetables; keep it once, from the lower club index.
+    for (std::size_t t = 0; t < season.teams.size(); ++t) {
+        int clubIdx = season.teams[t].club;
+        const ClubRecord &club = clubs.club[clubIdx];
+        for (int turn = game.turn; turn < kWeeks * kTurnsPerWeek; ++turn) {
+            int week = turn / kTurnsPerWeek;
+            int day = turn % kTurnsPerWeek;
+            int opponent = club.timetable.week[week].day[day].opponent_idx;
+            if (opponent <= clubIdx || opponent >= kClubs) {
+                continue;
+            }
+            int other = teamOfClub[opponent];
+            if (other < 0 || season.teams[other].division != season.teams[t].division ||
+                clubs.club[opponent].timetable.week[week].day[day].opponent_idx != clubIdx) {
+                continue;
+            }
+            season.fixtures.push_back({static_cast<uint8_t>(t), static_cast<uint8_t>(other)});
+        }
+    }
+    return season;
+}
+
+Result simulate(const Season &season, const Options &options) {
+    Result result;
+    result.seasons = std::max(options.seasons, 0);
+    std::size_t teamCount = season.teams.size();
+    std::vector<Match> matches = prepareMatches(season);
+
+    int batches = (result.seasons + kBatchSeasons - 1) / kBatchSeasons;
+    unsigned threads = options.threads != 0 ? options.threads : std::thread::hardware_concurrency();
+    threads = std::clamp(threads, 1u, static_cast<unsigned>(std::max(batches, 1)));
+
+    std::vector<Tally> tallies(threads, Tally(teamCount));
+    std::atomic<int> nextBatch{0};
+    auto work = [&](unsigned worker) {
+        std::vector<Row> rows(teamCount);
+        std::vector<std::uint64_t> keys;
+        for (int batch = nextBatch++; batch < batches; batch = nextBatch++) {
+            Rng rng(options.seed ^ (static_cast<std::uint64_t>(batch) * 0xd1342543de82ef95ULL));
+            int seasons = std::min(kBatchSeasons, result.seasons - batch * kBatchSeasons);
+            for (int s = 0; s < seasons; ++s) {
+                playSeason(season, matches, rng, rows, keys, tallies[worker]);
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (unsigned i = 1; i < threads; ++i) {
+        workers.emplace_back(work, i);
+    }
+    work(0);
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    double runs = std::max(result.seasons, 1);
+    result.clubs.resize(teamCount);
+    for (std::size_t t = 0; t < teamCount; ++t) {
+        std::uint64_t titles = 0, promotions = 0, relegations = 0, points = 0, positions = 0;
+        for (const Tally &tally : tallies) {
+            titles += tally.titles[t];
+            promotions += tally.promotions[t];
+            relegations += tally.relegations[t];
+            points += tally.points[t];
+            positions += tally.positions[t];
+        }
+        ClubOdds &odds = result.clubs[t];
+        odds.club = season.teams[t].club;
+        odds.division = season.teams[t].division;
+        odds.title = static_cast<double>(titles) / runs;
+        odds.promotion = static_cast<double>(promotions) / runs;
+        odds.relegation = static_cast<double>(relegations) / runs;
+        odds.averagePoints = static_cast<double>(points) / runs;
+        odds.averagePosition = static_cast<double>(positions) / runs;
+    }
+    return result;
+}
+
+} // namespace season_simulator
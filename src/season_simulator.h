@@ -0,0 +1,83 @@
+// Monte Carlo projection of the rest of the league season: plays the remaining fixtures many
+// times from squad-based team strengths and counts titles, promotions and relegations.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "player_attributes.h"
+#include "pm3_data.h"
+
+namespace season_simulator {
+
+inline constexpr int kDivisions = 5;
+// Clubs per division, Premier League first, as in gamea::table.
+inline constexpr std::array<int, kDivisions> kDivisionSizes{22, 24, 24, 22, 22};
+// Places that go up or down at the end of the season. A play-off place counts as promoted.
+inline constexpr std::array<int, kDivisions> kPromotionPlaces{0, 3, 3, 3, 1};
+inline constexpr std::array<int, kDivisions> kRelegationPlaces{3, 3, 3, 1, 0};
+
+// One row of the compact team table the simulation works on.
+struct Team {
+    int16_t club = -1;
+    uint8_t division = 0;
+    float strength = 1.0f; // average rating of the best available eleven
+    int16_t points = 0;
+    int16_t goalsFor = 0;
+    int16_t goalsAgainst = 0;
+};
+
+// Indices into Season::teams. The timetable does not say which side is at home (as far as it is
+// decoded), so neither does a fixture.
+struct Fixture {
+    uint8_t first;
+    uint8_t second;
+};
+
+struct Season {
+    // Grouped by division: division d is teams[divisionStart[d], divisionStart[d + 1]).
+    std::vector<Team> teams;
+    std::array<uint16_t, kDivisions + 1> divisionStart{};
+    std::vector<Fixture> fixtures;
+};
+
+// Rating of a club's best eleven: the best goalkeeper and the ten others with the best outfield
+// role ratings, skipping banned and injured players. Empty places count as zero. `ratings` is a
+// rateRoles pass over `players`.
+float teamStrength(const ClubRecord &club, const gamec &players, const player_attributes::RoleRatings &ratings);
+
+// Standings from gamea::table (three points for a win) and the league fixtures from the clubs'
+// timetables, from the current turn on. A fixture is only taken when both clubs' timetables list
+// each other on that day.
+Season fromSave(const gamea &game, const gameb &clubs, const gamec &players);
+
+struct Options {
+    unsigned threads = 0; // 0 uses every hardware thread
+    int seasons = 10000;
+    std::uint64_t seed = 0x5eed;
+};
+
+struct ClubOdds {
+    int16_t club = -1;
+    uint8_t division = 0;
+    double title = 0.0;
+    double promotion = 0.0;
+    double relegation = 0.0;
+    double averagePoints = 0.0;
+    double averagePosition = 0.0; // 1 = top
+};
+
+// In Season::teams order.
+struct Result {
+    int seasons = 0;
+    std::vector<ClubOdds> clubs;
+};
+
+// Goals are Poisson, with the stronger side expecting more in proportion to the square of the
+// strength ratio. Seasons run in fixed-size batches on a pool of threads, each batch with its own
+// generator seeded from Options::seed, so the result does not depend on the number of threads.
+Result simulate(const Season &season, const Options &options = {});
+
+} // namespace season_simulator
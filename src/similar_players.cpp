@@ -0,0 +1,129 @@
+// Nearest-neighbour search over the player attribute columns: the players most like a given one,
+// optionally only those a club can afford.
+#include "similar_players.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "game_utils.h"
+#include "roster_index.h"
+
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#define PM3_SIMILAR_PLAYERS_X86 1
+#endif
+
+namespace similar_players {
+namespace {
+using ColumnPointers = std::array<const std::uint8_t *, 9>;
+
+ColumnPointers columnPointers(const player_attributes::Columns &columns) {
+    return {columns.hn.data(), columns.tk.data(), columns.ps.data(), columns.sh.data(), columns.hd.data(),
+            columns.cr.data(), columns.ft.data(), columns.aggr.data(), columns.age.data()};
+}
+
+void distancesScalar(const ColumnPointers &columns, const std::array<int, 9> &target, const Weights &weights,
+                     std::uint32_t *out, std::size_t first, std::size_t last) {
+    for (std::size_t i = first; i < last; ++i) {
+        std::uint32_t distance = 0;
+        for (std::size_t a = 0; a < columns.size(); ++a) {
+            int difference = columns[a][i] - target[a];
+            distance += static_cast<std::uint32_t>(difference * difference) * weights[a];
+        }
+        out[i] = distance;
+    }
+}
+
+#if defined(PM3_SIMILAR_PLAYERS_X86)
+// Eight players per step: differences and squares in 16-bit lanes, weighted sums in 32-bit lanes.
+std::size_t distancesSse2(const ColumnPointers &columns, const std::array<int, 9> &target, const Weights &weights,
+                          std::uint32_t *out, std::size_t count) {
+    const __m128i zero = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i low = zero;
+        __m128i high = zero;
+        for (std::size_t a = 0; a < columns.size(); ++a) {
+            __m128i values = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(columns[a] + i)),
+                                               zero);
+            __m128i difference = _mm_sub_epi16(values, _mm_set1_epi16(static_cast<short>(target[a])));
+            __m128i square = _mm_mullo_epi16(difference, difference);
+            __m128i weight = _mm_set1_epi16(static_cast<short>(weights[a]));
+            __m128i productLow = _mm_mullo_epi16(square, weight);
+            __m128i productHigh = _mm_mulhi_epu16(square, weight);
+            low = _mm_add_epi32(low, _mm_unpacklo_epi16(productLow, productHigh));
+            high = _mm_add_epi32(high, _mm_unpackhi_epi16(productLow, productHigh));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), low);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i + 4), high);
+    }
+    return i;
+}
+#endif
+} // namespace
+
+void distances(const player_attributes::Columns &columns, std::size_t target, const Weights &weights,
+               std::vector<std::uint32_t> &out, player_attributes::Kernel kernel) {
+    std::size_t count = columns.size();
+    out.resize(count);
+    if (target >= count) {
+        return;
+    }
+
+    ColumnPointers pointers = columnPointers(columns);
+    std::array<int, 9> targetValues{};
+    Weights clamped{};
+    for (std::size_t a = 0; a < pointers.size(); ++a) {
+        targetValues[a] = pointers[a][target];
+        clamped[a] = std::min(weights[a], kMaxWeight);
+    }
+
+    std::size_t done = 0;
+#if defined(PM3_SIMILAR_PLAYERS_X86)
+    if (kernel != player_attributes::Kernel::Scalar && player_attributes::kernelSupported(kernel)) {
+        done = distancesSse2(pointers, targetValues, clamped, out.data(), count);
+    }
+#else
+    (void) kernel;
+#endif
+    distancesScalar(pointers, targetValues, clamped, out.data(), done, count);
+}
+
+std::vector<Neighbour> findSimilar(int16_t target, std::size_t count, int buyerClub, const Weights &weights) {
+    std::vector<Neighbour> result;
+    const player_attributes::Columns &columns = player_attributes::live();
+    if (target < 0 || static_cast<std::size_t>(target) >= columns.size() || count == 0) {
+        return result;
+    }
+
+    std::vector<std::uint32_t> distance;
+    distances(columns, static_cast<std::size_t>(target), weights, distance);
+
+    std::vector<int16_t> order(columns.size());
+    std::iota(order.begin(), order.end(), int16_t{0});
+    std::sort(order.begin(), order.end(), [&distance](int16_t a, int16_t b) {
+        return distance[a] != distance[b] ? distance[a] < distance[b] : a < b;
+    });
+
+    // Pricing is the slow part, so it only runs for candidates in distance order.
+    int budget = buyerClub >= 0 ? getClub(buyerClub).bank_account : 0;
+    for (int16_t idx : order) {
+        if (result.size() >= count) {
+            break;
+        }
+        roster_index::Placement placement = roster_index::find(idx);
+        if (idx == target || placement.club < 0 || placement.club == buyerClub) {
+            continue;
+        }
+        const ClubRecord &club = getClub(placement.club);
+        int price = determinePlayerPrice(getPlayer(idx), club, placement.slot, squadSummary(club),
+                                         valuationRating(player_attributes::liveRatings(), idx));
+        if (buyerClub >= 0 && price > budget) {
+            continue;
+        }
+        result.push_back({idx, placement.club, distance[idx], price});
+    }
+    return result;
+}
+
+} // namespace similar_players
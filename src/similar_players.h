@@ -0,0 +1,40 @@
+// Nearest-neighbour search over the player attribute columns: the players most like a given one,
+// optionally only those a club can afford.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "player_attributes.h"
+
+namespace similar_players {
+
+// Per attribute, in the order hn, tk, ps, sh, hd, cr, ft, aggr, age. At most kMaxWeight each, so
+// a distance fits the 32-bit lanes of the kernels.
+using Weights = std::array<std::uint8_t, 9>;
+inline constexpr std::uint8_t kMaxWeight = 16;
+// Skills count most; aggression is on a 0-15 scale, so it gets a larger weight per point.
+inline constexpr Weights kDefaultWeights{4, 4, 4, 4, 4, 4, 2, 8, 6};
+
+// Weighted squared distance from columns entry `target` to every entry, into `out`. Every kernel
+// gives the same integers; Kernel::Avx2 runs the SSE2 loop.
+void distances(const player_attributes::Columns &columns, std::size_t target, const Weights &weights,
+               std::vector<std::uint32_t> &out,
+               player_attributes::Kernel kernel = player_attributes::bestKernel());
+
+struct Neighbour {
+    int16_t player;
+    int club;
+    std::uint32_t distance;
+    int price;
+};
+
+// The `count` squad players nearest to `target` in playerData, nearest first (lower index on
+// ties). With a buyer club, players already there are skipped, and so is anyone whose
+// determinePlayerPrice exceeds its bank account.
+std::vector<Neighbour> findSimilar(int16_t target, std::size_t count, int buyerClub = -1,
+                                   const Weights &weights = kDefaultWeights);
+
+} // namespace similar_players
@@ -0,0 +1,161 @@
+// Background prefetch of the save slots: a worker thread keeps every present slot parsed in
+// memory and refreshes it when its files change, so loading a slot needs no disk reads.
+#include "slot_cache.h"
+
+#include <system_error>
+
+#include "folder_watch.h"
+#include "save_view.h"
+
+namespace io {
+namespace {
+constexpr std::chrono::milliseconds kPollInterval{500};
+} // namespace
+
+bool stampSlot(const Pm3Installation &installation, int gameNumber, SlotStamp &stamp) {
+    if (!installation.valid() || gameNumber < 1 || gameNumber > kSaveSlotCount) {
+        return false;
+    }
+    std::error_code ec;
+    for (int i = 0; i < 3; ++i) {
+        const auto &path = installation.slotFiles[gameNumber - 1][i];
+        stamp.writeTimes[i] = std::filesystem::last_write_time(path, ec);
+        if (ec) {
+            return false;
+        }
+        stamp.sizes[i] = std::filesystem::file_size(path, ec);
+        if (ec) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SlotCache::~SlotCache() {
+    stop();
+}
+
+void SlotCache::watch(const std::filesystem::path &gamePath) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (gamePath != watchedGamePath) {
+        watchedGamePath = gamePath;
+        slots = {};
+        ++requestedScans;
+        wake.notify_all();
+    }
+    if (!worker.joinable()) {
+        stopping = false;
+        worker = std::thread([this] { run(); });
+    }
+}
+
+void SlotCache::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        wake.notify_all();
+    }
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+std::shared_ptr<const CachedSlot> SlotCache::find(int gameNumber) const {
+    if (gameNumber < 1 || gameNumber > kSaveSlotCount) {
+        return nullptr;
+    }
+    std::shared_ptr<const CachedSlot> slot;
+    std::filesystem::path gamePath;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        slot = slots[gameNumber - 1];
+        gamePath = watchedGamePath;
+    }
+
+    // The worker may not have seen the latest write yet; never hand out a stale slot.
+    SlotStamp current;
+    if (!slot || !stampSlot(*resolveInstallation(gamePath), gameNumber, current) || current != slot->stamp) {
+        return nullptr;
+    }
+    return slot;
+}
+
+bool SlotCache::waitForScan(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!worker.joinable()) {
+        return false;
+    }
+    std::uint64_t ticket = ++requestedScans;
+    wake.notify_all();
+    return scanned.wait_for(lock, timeout, [this, ticket] { return completedScans >= ticket; });
+}
+
+void SlotCache::scan(const std::filesystem::path &gamePath) {
+    auto installation = resolveInstallation(gamePath);
+    for (int gameNumber = 1; gameNumber <= kSaveSlotCount; ++gameNumber) {
+        std::shared_ptr<const CachedSlot> previous;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            previous = slots[gameNumber - 1];
+        }
+
+        SlotStamp stamp;
+        std::shared_ptr<const CachedSlot> next;
+        if (stampSlot(*installation, gameNumber, stamp)) {
+            if (previous && previous->stamp == stamp) {
+                continue;
+            }
+            // Read into the slot's own buffers rather than mapping files DOSBox may be rewriting.
+            // Slots that are missing, wrong-sized or changed while being read stay uncached;
+            // loadGame reads and reports those itself, and the next change notice rescans them.
+            const auto &files = installation->slotFiles[gameNumber - 1];
+            auto slot = std::make_shared<CachedSlot>();
+            slot->gameNumber = gameNumber;
+            slot->stamp = stamp;
+            SlotStamp after;
+            if (readExact(files[0], &slot->gameA, sizeof(gamea)) &&
+                readExact(files[1], &slot->gameB, sizeof(gameb)) &&
+                readExact(files[2], &slot->gameC, sizeof(gamec)) &&
+                stampSlot(*installation, gameNumber, after) && after == stamp) {
+                next = std::move(slot);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (watchedGamePath == gamePath) {
+            slots[gameNumber - 1] = std::move(next);
+        }
+    }
+}
+
+void SlotCache::run() {
+    FolderWatch savesWatch;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        std::filesystem::path gamePath = watchedGamePath;
+        std::uint64_t serving = requestedScans;
+        bool requested = serving != completedScans;
+        lock.unlock();
+
+        auto installation = resolveInstallation(gamePath);
+        if (installation->valid() && savesWatch.folder() != installation->savesFolder) {
+            savesWatch = FolderWatch(installation->savesFolder);
+            requested = true;
+        }
+        if (savesWatch.poll() || requested) {
+            scan(gamePath);
+        }
+
+        lock.lock();
+        completedScans = serving;
+        scanned.notify_all();
+        wake.wait_for(lock, kPollInterval, [this, serving] { return stopping || requestedScans != serving; });
+    }
+}
+
+SlotCache &slotCache() {
+    static SlotCache cache;
+    return cache;
+}
+
+} // namespace io
@@ -0,0 +1,76 @@
+// Background prefetch of the save slots: a worker thread keeps every present slot parsed in
+// memory and refreshes it when its files change, so loading a slot needs no disk reads.
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "pm3_data.h"
+#include "pm3_installation.h"
+
+namespace io {
+
+struct SlotStamp {
+    std::array<std::filesystem::file_time_type, 3> writeTimes{};
+    std::array<std::uintmax_t, 3> sizes{};
+
+    bool operator==(const SlotStamp &other) const {
+        return writeTimes == other.writeTimes && sizes == other.sizes;
+    }
+    bool operator!=(const SlotStamp &other) const { return !(*this == other); }
+};
+
+// Stats GAMEnA/B/C; false if any of them is missing.
+bool stampSlot(const Pm3Installation &installation, int gameNumber, SlotStamp &stamp);
+
+struct CachedSlot {
+    int gameNumber = 0;
+    SlotStamp stamp;
+    gamea gameA{};
+    gameb gameB{};
+    gamec gameC{};
+};
+
+class SlotCache {
+public:
+    SlotCache() = default;
+    ~SlotCache();
+
+    SlotCache(const SlotCache &) = delete;
+    SlotCache &operator=(const SlotCache &) = delete;
+
+    // Points the cache at a PM3 folder, starting the worker on first use.
+    void watch(const std::filesystem::path &gamePath);
+    void stop();
+
+    // The cached slot, only if its files on disk are still the ones it was parsed from.
+    std::shared_ptr<const CachedSlot> find(int gameNumber) const;
+
+    // Asks for a full rescan and waits until it has finished.
+    bool waitForScan(std::chrono::milliseconds timeout);
+
+private:
+    void run();
+    void scan(const std::filesystem::path &gamePath);
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable scanned;
+    std::thread worker;
+    bool stopping = false;
+    std::filesystem::path watchedGamePath;
+    std::array<std::shared_ptr<const CachedSlot>, kSaveSlotCount> slots;
+    std::uint64_t requestedScans = 0;
+    std::uint64_t completedScans = 0;
+};
+
+// The cache used by loadGame.
+SlotCache &slotCache();
+
+} // namespace io
@@ -197,30 +197,32 @@ void writeTextSmall(TextRenderer &renderer, const char *text, int textLine,
                        offsetLeft);
 }
 
-int writePlayers(TextRenderer &renderer, std::vector<club_player> &players, int &textLine,
-                 const std::function<void(const club_player &)> &clickCallback) {
+int writePlayers(TextRenderer &renderer, PlayerRowSpan players, int &textLine,
+                 const std::function<void(const PlayerRow &)> &clickCallback) {
     writePlayerSubHeader(renderer,
                          "CLUB NAME        T PLAYER NAME  HN TK PS SH HD CR FT F M A AG WAGES",
                          3,
                          nullptr);
 
-    for (auto &player: players) {
+    for (const PlayerRow &row : players) {
+        const ClubRecord &club = getClub(row.club);
+        const PlayerRecord &player = getPlayer(row.player);
         char playerRow[77];
         snprintf(playerRow, sizeof(playerRow),
                  "%16.16s %1c %12.12s %2.2d %2.2d %2.2d %2.2d %2.2d %2.2d %2.2d %1.1s %1.1d %1.1d %2.2d %5d",
-                 player.club.name, determinePlayerType(player.player), player.player.name, player.player.hn,
-                 player.player.tk, player.player.ps, player.player.sh, player.player.hd, player.player.cr,
-                 player.player.ft, footShortLabels[player.player.foot], player.player.morl, player.player.aggr,
-                 player.player.age, player.player.wage);
+                 club.name, determinePlayerType(player), player.name, player.hn,
+                 player.tk, player.ps, player.sh, player.hd, player.cr,
+                 player.ft, footShortLabels[player.foot], player.morl, player.aggr,
+                 player.age, player.wage);
 
         std::function<void(void)> playerCallback;
         if (clickCallback) {
-            playerCallback = [player, clickCallback] { clickCallback(player); };
+            playerCallback = [row, clickCallback] { clickCallback(row); };
         }
 
         writePlayer(renderer,
                     playerRow,
-                    determinePlayerType(player.player),
+                    determinePlayerType(player),
                     textLine++,
                     playerCallback);
     }
@@ -0,0 +1,177 @@
+// Undo/redo for the in-memory save (gameData/clubData/playerData). A step is opened in O(1) and
+// saves a copy of each 4 KB page the first time the step writes to it, so the journal only ever
+// holds the pages that were actually edited.
+#include "undo_journal.h"
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "dirty_tracker.h"
+#include "pm3_data.h"
+
+namespace undo_journal {
+namespace {
+constexpr std::size_t pagesFor(std::size_t size) {
+    return (size + kPageSize - 1) / kPageSize;
+}
+
+constexpr std::size_t kGameDataPages = pagesFor(sizeof(gamea));
+constexpr std::size_t kClubDataPages = pagesFor(sizeof(gameb));
+constexpr std::size_t kTotalPages = kGameDataPages + kClubDataPages + pagesFor(sizeof(gamec));
+
+struct PageLocation {
+    char gameLetter;
+    std::uint8_t *bytes;
+    std::size_t offset;
+    std::size_t size;
+};
+
+PageLocation locate(std::size_t page) {
+    char gameLetter = 'A';
+    auto *base = reinterpret_cast<std::uint8_t *>(&gameData);
+    std::size_t total = sizeof(gamea);
+    if (page >= kGameDataPages + kClubDataPages) {
+        gameLetter = 'C';
+        base = reinterpret_cast<std::uint8_t *>(&playerData);
+        total = sizeof(gamec);
+        page -= kGameDataPages + kClubDataPages;
+    } else if (page >= kGameDataPages) {
+        gameLetter = 'B';
+        base = reinterpret_cast<std::uint8_t *>(&clubData);
+        total = sizeof(gameb);
+        page -= kGameDataPages;
+    }
+    std::size_t offset = page * kPageSize;
+    return {gameLetter, base + offset, offset, std::min(kPageSize, total - offset)};
+}
+
+struct SavedPage {
+    std::size_t page;
+    std::unique_ptr<std::uint8_t[]> bytes;
+};
+
+struct Step {
+    std::vector<SavedPage> pages;
+    std::bitset<kTotalPages> captured;
+};
+
+std::deque<Step> gUndo;
+std::vector<Step> gRedo;
+bool gStepOpen = false;
+bool gRestoring = false;
+
+// Swaps a step's saved pages with the live ones, turning it into the step that reverses itself.
+void swapIn(Step &step) {
+    gRestoring = true;
+    for (SavedPage &saved : step.pages) {
+        PageLocation location = locate(saved.page);
+        std::swap_ranges(location.bytes, location.bytes + location.size, saved.bytes.get());
+        dirty_tracker::markRange(location.gameLetter, location.offset, location.size);
+    }
+    gRestoring = false;
+}
+} // namespace
+
+void beginStep() {
+    gStepOpen = false;
+}
+
+void capture(char gameLetter, std::size_t offset, std::size_t size) {
+    std::size_t first = 0;
+    std::size_t total = 0;
+    switch (gameLetter) {
+        case 'A':
+            total = sizeof(gamea);
+            break;
+        case 'B':
+            first = kGameDataPages;
+            total = sizeof(gameb);
+            break;
+        case 'C':
+            first = kGameDataPages + kClubDataPages;
+            total = sizeof(gamec);
+            break;
+        default:
+            return;
+    }
+    if (gRestoring || size == 0 || offset >= total) {
+        return;
+    }
+
+    if (!gStepOpen) {
+        gUndo.emplace_back();
+        gRedo.clear();
+        gStepOpen = true;
+        if (gUndo.size() > kMaxSteps) {
+            gUndo.pop_front();
+        }
+    }
+    Step &step = gUndo.back();
+    std::size_t end = std::min(offset + size, total);
+    for (std::size_t page = first + offset / kPageSize; page <= first + (end - 1) / kPageSize; ++page) {
+        if (step.captured.test(page)) {
+            continue;
+        }
+        PageLocation location = locate(page);
+        SavedPage saved{page, std::make_unique<std::uint8_t[]>(location.size)};
+        std::memcpy(saved.bytes.get(), location.bytes, location.size);
+        step.pages.push_back(std::move(saved));
+        step.captured.set(page);
+    }
+}
+
+bool undo() {
+    if (gUndo.empty()) {
+        return false;
+    }
+    swapIn(gUndo.back());
+    gRedo.push_back(std::move(gUndo.back()));
+    gUndo.pop_back();
+    gStepOpen = false;
+    return true;
+}
+
+bool redo() {
+    if (gRedo.empty()) {
+        return false;
+    }
+    swapIn(gRedo.back());
+    gUndo.push_back(std::move(gRedo.back()));
+    gRedo.pop_back();
+    gStepOpen = false;
+    return true;
+}
+
+bool canUndo() {
+    return !gUndo.empty();
+}
+
+bool canRedo() {
+    return !gRedo.empty();
+}
+
+void reset() {
+    gUndo.clear();
+    gRedo.clear();
+    gStepOpen = false;
+}
+
+std::size_t journalBytes() {
+    std::size_t total = 0;
+    auto add = [&total](const Step &step) {
+        for (const SavedPage &saved : step.pages) {
+            total += locate(saved.page).size;
+        }
+    };
+    std::for_each(gUndo.begin(), gUndo.end(), add);
+    std::for_each(gRedo.begin(), gRedo.end(), add);
+    return total;
+}
+
+} // namespace undo_journal
@@ -0,0 +1,35 @@
+// Undo/redo for the in-memory save (gameData/clubData/playerData). A step is opened in O(1) and
+// saves a copy of each 4 KB page the first time the step writes to it, so the journal only ever
+// holds the pages that were actually edited.
+#pragma once
+
+#include <cstddef>
+
+namespace undo_journal {
+
+inline constexpr std::size_t kPageSize = 4096;
+// Oldest steps are dropped beyond this.
+inline constexpr std::size_t kMaxSteps = 64;
+
+// Starts a new undo step (one user action). Steps that end up touching nothing are discarded.
+void beginStep();
+
+// Copies the pages covering `size` bytes at `offset` of GAMEnA/B/C ('A', 'B' or 'C') into the
+// current step unless it already has them. dirty_tracker calls this from every mark function, so
+// it always runs before the records change.
+void capture(char gameLetter, std::size_t offset, std::size_t size);
+
+// Swaps the pages of the last step (or the last undone step) back in and marks them dirty so the
+// next save writes them. False if there is nothing to undo or redo.
+bool undo();
+bool redo();
+bool canUndo();
+bool canRedo();
+
+// Forgets all history, e.g. after the globals were replaced by a load.
+void reset();
+
+// Bytes of page copies currently held.
+std::size_t journalBytes();
+
+} // namespace undo_journal
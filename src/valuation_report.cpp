@@ -0,0 +1,250 @@
+// League-wide valuation of every contracted player, priced in parallel over a read-only copy of
+// the save, with sorted reports as CSV or JSON.
+#include "valuation_report.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#include "game_utils.h"
+#include "player_attributes.h"
+#include "roster_index.h"
+
+namespace valuation_report {
+namespace {
+constexpr int kPlayers = static_cast<int>(sizeof(gamec) / sizeof(PlayerRecord));
+
+// One club's task: reads only the dataset and writes only its own outputs.
+std::vector<PlayerValuation> priceSquad(const Dataset &dataset, const player_attributes::RoleRatings &ratings,
+                                        int clubIdx, SquadValuation &squad) {
+    std::vector<PlayerValuation> valuations;
+    const ClubRecord &club = dataset.clubs.club[clubIdx];
+    SquadSummary summary = summarizeSquad(club, dataset.players);
+    squad.club = clubIdx;
+    squad.division = normalizedLeagueTier(club);
+
+    for (int slot = 0; slot < roster_index::kSquadSlots; ++slot) {
+        int16_t idx = club.player_index[slot];
+        if (idx < 0 || idx >= kPlayers) {
+            continue;
+        }
+        PlayerRecord player = dataset.players.player[idx];
+        if (player.contract == 0) {
+            continue;
+        }
+
+        PlayerValuation valuation;
+        valuation.player = idx;
+        valuation.club = clubIdx;
+        valuation.slot = slot;
+        valuation.division = squad.division;
+        valuation.rating = determinePlayerRating(player);
+        valuation.role = determinePlayerType(player);
+        ValuationRating rated = valuationRating(ratings, idx);
+        valuation.price = determinePlayerPrice(player, club, slot, summary, rated);
+        valuation.askingPrice = determineAskingPrice(player, club, slot, summary, rated);
+        valuations.push_back(valuation);
+
+        ++squad.players;
+        squad.totalAskingPrice += valuation.askingPrice;
+        squad.totalRating += valuation.rating;
+    }
+    return valuations;
+}
+
+std::string trimmedName(const char *name, std::size_t size) {
+    std::string text(name, strnlen(name, size));
+    while (!text.empty() && text.back() == ' ') {
+        text.pop_back();
+    }
+    return text;
+}
+
+std::string playerName(const Dataset &dataset, int16_t idx) {
+    return trimmedName(dataset.players.player[idx].name, sizeof(PlayerRecord::name));
+}
+
+std::string clubName(const Dataset &dataset, int idx) {
+    return trimmedName(dataset.clubs.club[idx].name, sizeof(ClubRecord::name));
+}
+
+std::string csvField(const std::string &text) {
+    if (text.find_first_of(",\"\n") == std::string::npos) {
+        return text;
+    }
+    std::string quoted = "\"";
+    for (char c : text) {
+        quoted += c;
+        if (c == '"') {
+            quoted += '"';
+        }
+    }
+    return quoted + "\"";
+}
+
+std::string jsonString(const std::string &text) {
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+            quoted += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+            quoted += escaped;
+        } else {
+            quoted += c;
+        }
+    }
+    return quoted + "\"";
+}
+
+std::string formatRatio(double value) {
+    char text[32];
+    snprintf(text, sizeof(text), "%.3f", value);
+    return text;
+}
+
+std::string csvPlayerRow(const char *report, std::size_t rank, const PlayerValuation &valuation,
+                         const Dataset &dataset) {
+    return std::string(report) + "," + std::to_string(rank) + "," + std::to_string(valuation.division) + "," +
+           csvField(clubName(dataset, valuation.club)) + "," + csvField(playerName(dataset, valuation.player)) + "," +
+           valuation.role + "," + std::to_string(valuation.rating) + "," + std::to_string(valuation.price) + "," +
+           std::to_string(valuation.askingPrice) + ",\n";
+}
+
+std::string jsonPlayer(const PlayerValuation &valuation, const Dataset &dataset) {
+    return "{\"player\":" + std::to_string(valuation.player) +
+           ",\"name\":" + jsonString(playerName(dataset, valuation.player)) +
+           ",\"club\":" + jsonString(clubName(dataset, valuation.club)) +
+           ",\"division\":" + std::to_string(valuation.division) + ",\"role\":\"" + valuation.role +
+           "\",\"rating\":" + std::to_string(valuation.rating) + ",\"price\":" + std::to_string(valuation.price) +
+           ",\"asking_price\":" + std::to_string(valuation.askingPrice) + "}";
+}
+
+template <typename T, typename Format>
+std::string jsonArray(const std::vector<T> &items, Format format) {
+    std::string json = "[";
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        json += (i == 0 ? "\n    " : ",\n    ") + format(items[i]);
+    }
+    return json + (items.empty() ? "]" : "\n  ]");
+}
+} // namespace
+
+Report build(const Dataset &dataset, const Options &options) {
+    constexpr int kClubs = roster_index::kIndexedClubs;
+    std::vector<std::vector<PlayerValuation>> perClub(kClubs);
+    std::vector<SquadValuation> squads(kClubs);
+    // Every player is rated once up front by the SIMD kernels; the workers only look ratings up.
+    player_attributes::RoleRatings ratings;
+    player_attributes::rateRoles(player_attributes::extract(dataset.players), ratings);
+
+    unsigned threads = options.threads != 0 ? options.threads : std::thread::hardware_concurrency();
+    threads = std::clamp(threads, 1u, static_cast<unsigned>(kClubs));
+    std::atomic<int> nextClub{0};
+    auto work = [&] {
+        for (int clubIdx = nextClub++; clubIdx < kClubs; clubIdx = nextClub++) {
+            perClub[clubIdx] = priceSquad(dataset, ratings, clubIdx, squads[clubIdx]);
+        }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (unsigned i = 1; i < threads; ++i) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    Report report;
+    for (const auto &valuations : perClub) {
+        report.players.insert(report.players.end(), valuations.begin(), valuations.end());
+    }
+
+    auto dearer = [](const PlayerValuation &a, const PlayerValuation &b) {
+        return a.askingPrice != b.askingPrice ? a.askingPrice > b.askingPrice : a.player < b.player;
+    };
+    for (const PlayerValuation &valuation : report.players) {
+        report.topValueByDivision[valuation.division].push_back(valuation);
+    }
+    for (auto &division : report.topValueByDivision) {
+        std::sort(division.begin(), division.end(), dearer);
+        division.resize(std::min(division.size(), options.topCount));
+    }
+
+    for (const PlayerValuation &valuation : report.players) {
+        if (valuation.rating > 0) {
+            report.bestValueForRating.push_back(valuation);
+        }
+    }
+    std::sort(report.bestValueForRating.begin(), report.bestValueForRating.end(),
+              [](const PlayerValuation &a, const PlayerValuation &b) {
+                  std::int64_t left = static_cast<std::int64_t>(a.askingPrice) * b.rating;
+                  std::int64_t right = static_cast<std::int64_t>(b.askingPrice) * a.rating;
+                  return left != right ? left < right : a.player < b.player;
+              });
+    report.bestValueForRating.resize(std::min(report.bestValueForRating.size(), options.topCount));
+
+    std::array<std::int64_t, 5> divisionAsking{};
+    std::array<std::int64_t, 5> divisionRating{};
+    for (const SquadValuation &squad : squads) {
+        divisionAsking[squad.division] += squad.totalAskingPrice;
+        divisionRating[squad.division] += squad.totalRating;
+    }
+    for (SquadValuation squad : squads) {
+        if (squad.totalRating == 0 || divisionAsking[squad.division] == 0) {
+            continue;
+        }
+        double divisionRatio = static_cast<double>(divisionAsking[squad.division]) /
+                               static_cast<double>(divisionRating[squad.division]);
+        squad.overpricing = static_cast<double>(squad.totalAskingPrice) /
+                            static_cast<double>(squad.totalRating) / divisionRatio;
+        report.overpricedSquads.push_back(squad);
+    }
+    std::sort(report.overpricedSquads.begin(), report.overpricedSquads.end(),
+              [](const SquadValuation &a, const SquadValuation &b) {
+                  return a.overpricing != b.overpricing ? a.overpricing > b.overpricing : a.club < b.club;
+              });
+    return report;
+}
+
+std::string toCsv(const Report &report, const Dataset &dataset) {
+    std::string csv = "report,rank,division,club,player,role,rating,price,asking_price,overpricing\n";
+    for (const auto &division : report.topValueByDivision) {
+        for (std::size_t i = 0; i < division.size(); ++i) {
+            csv += csvPlayerRow("top_value", i + 1, division[i], dataset);
+        }
+    }
+    for (std::size_t i = 0; i < report.bestValueForRating.size(); ++i) {
+        csv += csvPlayerRow("best_value_for_rating", i + 1, report.bestValueForRating[i], dataset);
+    }
+    for (std::size_t i = 0; i < report.overpricedSquads.size(); ++i) {
+        const SquadValuation &squad = report.overpricedSquads[i];
+        csv += "overpriced_squad," + std::to_string(i + 1) + "," + std::to_string(squad.division) + "," +
+               csvField(clubName(dataset, squad.club)) + ",,,,,," + formatRatio(squad.overpricing) + "\n";
+    }
+    return csv;
+}
+
+std::string toJson(const Report &report, const Dataset &dataset) {
+    auto player = [&dataset](const PlayerValuation &valuation) { return jsonPlayer(valuation, dataset); };
+
+    std::string json = "{\n  \"top_value_by_division\": [";
+    for (std::size_t d = 0; d < report.topValueByDivision.size(); ++d) {
+        json += (d == 0 ? "\n  " : ",\n  ") + jsonArray(report.topValueByDivision[d], player);
+    }
+    json += "\n  ],\n  \"best_value_for_rating\": " + jsonArray(report.bestValueForRating, player);
+    json += ",\n  \"overpriced_squads\": " + jsonArray(report.overpricedSquads, [&dataset](const SquadValuation &squad) {
+        return "{\"club\":" + jsonString(clubName(dataset, squad.club)) +
+               ",\"division\":" + std::to_string(squad.division) + ",\"players\":" + std::to_string(squad.players) +
+               ",\"total_asking_price\":" + std::to_string(squad.totalAskingPrice) +
+               ",\"overpricing\":" + formatRatio(squad.overpricing) + "}";
+    });
+    return json + "\n}\n";
+}
+
+} // namespace valuation_report
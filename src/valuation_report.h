@@ -0,0 +1,65 @@
+// League-wide valuation of every contracted player, priced in parallel over a read-only copy of
+// the save, with sorted reports as CSV or JSON.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "pm3_data.h"
+
+namespace valuation_report {
+
+// The save being priced. Nothing may write to it while build() runs.
+struct Dataset {
+    const gameb &clubs;
+    const gamec &players;
+};
+
+struct Options {
+    unsigned threads = 0;      // 0 uses every hardware thread
+    std::size_t topCount = 10; // rows per division and in the value-for-rating list
+};
+
+struct PlayerValuation {
+    int16_t player = -1;
+    int club = -1;
+    int slot = -1;
+    int division = 0;
+    int rating = 0;
+    char role = 'A';
+    int price = 0;       // determinePlayerPrice
+    int askingPrice = 0; // what the club asks in an offer (determineAskingPrice)
+};
+
+struct SquadValuation {
+    int club = -1;
+    int division = 0;
+    int players = 0;
+    std::int64_t totalAskingPrice = 0;
+    std::int64_t totalRating = 0;
+    // Asking price per rating point over the division's; above 1 means dearer than its peers.
+    double overpricing = 0.0;
+};
+
+struct Report {
+    // Every contracted squad player of the league clubs, in club then slot order.
+    std::vector<PlayerValuation> players;
+    // Dearest asking prices first, per division.
+    std::array<std::vector<PlayerValuation>, 5> topValueByDivision;
+    // Lowest asking price per rating point first.
+    std::vector<PlayerValuation> bestValueForRating;
+    // Most overpriced first; every league club with a contracted player.
+    std::vector<SquadValuation> overpricedSquads;
+};
+
+// Prices each club's squad as one task on a pool of threads. The result does not depend on the
+// number of threads.
+Report build(const Dataset &dataset, const Options &options = {});
+
+std::string toCsv(const Report &report, const Dataset &dataset);
+std::string toJson(const Report &report, const Dataset &dataset);
+
+} // namespace valuation_report
@@ -0,0 +1,114 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+#include "backup_store.h"
+
+namespace {
+std::string readFile(const std::filesystem::path &path) {
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+void writeFile(const std::filesystem::path &path, const std::string &text) {
+    std::ofstream out(path, std::ios::binary);
+    out << text;
+}
+
+std::size_t countChunks(const std::filesystem::path &root) {
+    std::size_t count = 0;
+    for (const auto &entry : std::filesystem::recursive_directory_iterator(root / "chunks")) {
+        count += entry.is_regular_file() ? 1 : 0;
+    }
+    return count;
+}
+} // namespace
+
+int main() {
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "pm3000_test_backup_store";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir / "slot");
+
+    // Three chunks, two of them identical; a short tail chunk.
+    std::string original = std::string(io::kBackupChunkSize, 'x') + std::string(io::kBackupChunkSize, 'x') + "tail";
+    writeFile(dir / "slot" / "GAME1A", original);
+    writeFile(dir / "slot" / "GAME2A", original);
+
+    io::BackupStore store(dir / "store");
+    std::string error;
+    std::uint32_t first = store.addGeneration("GAME1", {dir / "slot" / "GAME1A"}, error);
+    if (first == 0 || countChunks(store.root()) != 2) {
+        std::cerr << "first generation failed: " << error << "\n";
+        return 1;
+    }
+
+    // Identical data in another slot and a one-byte edit only add the changed chunk.
+    std::uint32_t other = store.addGeneration("GAME2", {dir / "slot" / "GAME2A"}, error);
+    std::string edited = original;
+    edited[io::kBackupChunkSize + 5] = 'y';
+    writeFile(dir / "slot" / "GAME1A", edited);
+    std::uint32_t second = store.addGeneration("GAME1", {dir / "slot" / "GAME1A"}, error);
+    if (other == 0 || second <= first || countChunks(store.root()) != 3) {
+        std::cerr << "unchanged chunks were stored again\n";
+        return 1;
+    }
+
+    auto generations = store.generations();
+    if (generations.size() != 3 || generations[0].id != first || generations[0].label != "GAME1" ||
+        generations[0].files.size() != 1 || generations[0].files[0].size != original.size()) {
+        std::cerr << "unexpected generation list\n";
+        return 1;
+    }
+
+    if (!store.restore(first, dir / "slot", error) || readFile(dir / "slot" / "GAME1A") != original) {
+        std::cerr << "restore failed: " << error << "\n";
+        return 1;
+    }
+
+    // Pruning keeps the newest generation of the label and drops chunks only it referenced.
+    store.prune("GAME1", 1);
+    generations = store.generations();
+    if (generations.size() != 2 || generations[0].id != other || generations[1].id != second ||
+        countChunks(store.root()) != 3) {
+        std::cerr << "prune removed the wrong generations\n";
+        return 1;
+    }
+    // Nothing to drop means nothing is collected, not even a chunk no generation refers to.
+    std::filesystem::create_directories(store.root() / "chunks" / "zz");
+    writeFile(store.root() / "chunks" / "zz" / "stray", "stray");
+    store.prune("GAME1", 1);
+    if (countChunks(store.root()) != 4) {
+        std::cerr << "prune collected chunks without dropping a generation\n";
+        return 1;
+    }
+    std::filesystem::remove_all(store.root() / "chunks" / "zz");
+    store.prune("GAME2", 0);
+    store.prune("GAME1", 0);
+    if (!store.generations().empty() || countChunks(store.root()) != 0) {
+        std::cerr << "prune left chunks behind\n";
+        return 1;
+    }
+
+    // A damaged chunk is detected instead of restored.
+    writeFile(dir / "slot" / "GAME1A", original);
+    std::uint32_t third = store.addGeneration("GAME1", {dir / "slot" / "GAME1A"}, error);
+    if (third <= second) {
+        std::cerr << "generation id reused after pruning\n";
+        return 1;
+    }
+    for (const auto &entry : std::filesystem::recursive_directory_iterator(store.root() / "chunks")) {
+        if (entry.is_regular_file()) {
+            writeFile(entry.path(), "corrupt");
+            break;
+        }
+    }
+    if (store.restore(third, dir / "slot", error) || error.empty()) {
+        std::cerr << "damaged chunk restored\n";
+        return 1;
+    }
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "byte_order.h"
+
+namespace {
+bool checkTable(const char *name, std::vector<byte_order::SwapField> fields, std::size_t recordSize) {
+    std::sort(fields.begin(), fields.end(),
+              [](const auto &a, const auto &b) { return a.offset < b.offset; });
+    std::size_t end = 0;
+    for (const auto &field : fields) {
+        if ((field.width != 2 && field.width != 4) || field.count == 0 || field.offset < end ||
+            field.offset + field.width * field.count > recordSize) {
+            std::cerr << name << " field at " << field.offset << " overlaps or is out of range\n";
+            return false;
+        }
+        end = field.offset + field.width * field.count;
+    }
+    return true;
+}
+
+// Straightforward per-field swap to compare the shuffled pass against.
+template <typename T>
+void referenceSwap(T &data, const std::vector<byte_order::SwapField> &fields, std::size_t recordSize) {
+    auto *bytes = reinterpret_cast<unsigned char *>(&data);
+    for (std::size_t record = 0; record < sizeof(T) / recordSize; ++record) {
+        for (const auto &field : fields) {
+            for (std::size_t i = 0; i < field.count; ++i) {
+                unsigned char *p = bytes + record * recordSize + field.offset + i * field.width;
+                std::reverse(p, p + field.width);
+            }
+        }
+    }
+}
+
+template <typename T>
+bool checkSwap(const char *name, const std::vector<byte_order::SwapField> &fields, std::size_t recordSize) {
+    std::mt19937 rng(7);
+    auto original = std::make_unique<T>();
+    auto *bytes = reinterpret_cast<unsigned char *>(original.get());
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        bytes[i] = static_cast<unsigned char>(rng());
+    }
+
+    auto swapped = std::make_unique<T>(*original);
+    auto expected = std::make_unique<T>(*original);
+    byte_order::swap(*swapped);
+    referenceSwap(*expected, fields, recordSize);
+    if (std::memcmp(swapped.get(), expected.get(), sizeof(T)) != 0) {
+        std::cerr << name << " swap differs from the field table\n";
+        return false;
+    }
+    byte_order::swap(*swapped);
+    if (std::memcmp(swapped.get(), original.get(), sizeof(T)) != 0) {
+        std::cerr << name << " swap is not its own inverse\n";
+        return false;
+    }
+    return true;
+}
+
+uint16_t swap16(uint16_t value) {
+    return static_cast<uint16_t>((value >> 8) | (value << 8));
+}
+} // namespace
+
+int main() {
+    if (!checkTable("gamea", byte_order::gameaFields(), sizeof(gamea)) ||
+        !checkTable("club", byte_order::clubFields(), sizeof(ClubRecord)) ||
+        !checkTable("player", byte_order::playerFields(), sizeof(PlayerRecord))) {
+        return 1;
+    }
+    if (!checkSwap<gamea>("gamea", byte_order::gameaFields(), sizeof(gamea)) ||
+        !checkSwap<gameb>("gameb", byte_order::clubFields(), sizeof(ClubRecord)) ||
+        !checkSwap<gamec>("gamec", byte_order::playerFields(), sizeof(PlayerRecord))) {
+        return 1;
+    }
+
+    // Known fields across the record, including the last integer of gamea.
+    auto gameA = std::make_unique<gamea>();
+    gameA->table.all[113].xx = 0x1234;
+    gameA->manager[1].match_summary.club[1].goal[7].time = 0x0102;
+    gameA->manager[1].seating_history[22] = 0x11223344;
+    gameA->inc_number3 = 0x00ff;
+    std::memcpy(gameA->manager_name, "KEVIN", 5);
+    byte_order::swap(*gameA);
+    if (gameA->table.all[113].xx != 0x3412 || gameA->manager[1].match_summary.club[1].goal[7].time != 0x0201 ||
+        gameA->manager[1].seating_history[22] != 0x44332211 || gameA->inc_number3 != 0xff00 ||
+        std::memcmp(gameA->manager_name, "KEVIN", 5) != 0) {
+        std::cerr << "gamea fields not swapped as expected\n";
+        return 1;
+    }
+
+    // A PC slot stays as it is; the same slot written big-endian is detected and converted.
+    auto gameB = std::make_unique<gameb>();
+    auto gameC = std::make_unique<gamec>();
+    for (int club = 0; club < kClubIdxMax; ++club) {
+        for (int slot = 0; slot < 24; ++slot) {
+            gameB->club[club].player_index[slot] = slot < 16 ? static_cast<int16_t>(club * 16 + slot) : -1;
+        }
+    }
+    gameB->club[5].bank_account = 250000;
+    gameC->player[9].wage = 900;
+    if (byte_order::detect(*gameB) != byte_order::kNative ||
+        byte_order::toNative(*gameA, *gameB, *gameC) != byte_order::kNative || gameC->player[9].wage != 900) {
+        std::cerr << "native slot not detected\n";
+        return 1;
+    }
+
+    byte_order::swap(*gameB);
+    byte_order::swap(*gameC);
+    auto foreign = byte_order::kNative == byte_order::ByteOrder::Little ? byte_order::ByteOrder::Big
+                                                                       : byte_order::ByteOrder::Little;
+    if (static_cast<uint16_t>(gameB->club[3].player_index[2]) != swap16(50) ||
+        byte_order::toNative(*gameA, *gameB, *gameC) != foreign) {
+        std::cerr << "foreign slot not detected\n";
+        return 1;
+    }
+    if (gameB->club[3].player_index[2] != 50 || gameB->club[5].bank_account != 250000 ||
+        gameC->player[9].wage != 900 || gameA->table.all[113].xx != 0x1234) {
+        std::cerr << "foreign slot not converted\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+#include "column_cache.h"
+
+int main() {
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "pm3000_test_column_cache";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    std::filesystem::path path = dir / "table.pm3cache";
+
+    // Every byte of the content and the schema counts towards the key.
+    std::string content(1000, 'a');
+    column_cache::Key key = column_cache::makeKey(content, "v1");
+    std::string changed = content;
+    changed[997] = 'b';
+    if (key != column_cache::makeKey(content, "v1") || key == column_cache::makeKey(changed, "v1") ||
+        key == column_cache::makeKey(content, "v2") || key == column_cache::makeKey(content + "a", "v1")) {
+        std::cerr << "keys do not follow the content and schema\n";
+        return 1;
+    }
+
+    column_cache::Table table;
+    table.rows = 3;
+    table.numbers = {{1, -2, 3}, {2147483647, 0, -2147483647 - 1}};
+    table.texts = {{"Smith", "", "O'Brien, K."}, {"GK", "ST, LW", ""}};
+    table.counts = {402024, 400000};
+    if (!column_cache::write(path, key, table)) {
+        std::cerr << "write failed\n";
+        return 1;
+    }
+
+    column_cache::Snapshot snapshot;
+    if (!snapshot.open(path, key, 2, 2, 2) || snapshot.rows() != 3 || snapshot.count(0) != 402024 ||
+        snapshot.count(1) != 400000) {
+        std::cerr << "snapshot did not open\n";
+        return 1;
+    }
+    for (std::size_t column = 0; column < 2; ++column) {
+        for (std::size_t row = 0; row < 3; ++row) {
+            if (snapshot.number(column, row) != table.numbers[column][row] ||
+                snapshot.text(column, row) != table.texts[column][row]) {
+                std::cerr << "column " << column << " row " << row << " read back wrong\n";
+                return 1;
+            }
+        }
+    }
+
+    // Another key or another column layout is a miss, not a misread.
+    column_cache::Snapshot miss;
+    if (miss.open(path, column_cache::makeKey(changed, "v1"), 2, 2, 2) || miss.open(path, key, 3, 2, 2) ||
+        miss.open(path, key, 2, 1, 2) || miss.open(dir / "missing.pm3cache", key, 2, 2, 2)) {
+        std::cerr << "a stale snapshot opened\n";
+        return 1;
+    }
+
+    // A truncated file is rejected.
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    if (miss.open(path, key, 2, 2, 2)) {
+        std::cerr << "a truncated snapshot opened\n";
+        return 1;
+    }
+
+    // Columns of the wrong length are not written.
+    table.numbers[1].pop_back();
+    if (column_cache::write(dir / "bad.pm3cache", key, table)) {
+        std::cerr << "a ragged table was written\n";
+        return 1;
+    }
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,200 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "csv_reader.h"
+
+namespace {
+// The line splitter fifa_import_tool used before csv_reader, kept as the reference.
+std::vector<std::string> splitCsv(const std::string &line) {
+    std::vector<std::string> fields;
+    std::string current;
+    bool inQuotes = false;
+    for (size_t i = 0; i < line.size(); ++i) {
+        char c = line[i];
+        if (inQuotes) {
+            if (c == '"') {
+                if (i + 1 < line.size() && line[i + 1] == '"') {
+                    current.push_back('"');
+                    ++i;
+                } else {
+                    inQuotes = false;
+                }
+            } else {
+                current.push_back(c);
+            }
+        } else {
+            if (c == '"') {
+                inQuotes = true;
+            } else if (c == ',') {
+                fields.push_back(current);
+                current.clear();
+            } else {
+                current.push_back(c);
+            }
+        }
+    }
+    fields.push_back(current);
+    return fields;
+}
+
+std::vector<std::vector<std::string>> readAll(std::string_view text,
+                                              csv_reader::Kernel kernel = csv_reader::bestKernel()) {
+    std::vector<std::vector<std::string>> rows;
+    csv_reader::RowReader reader(text, kernel);
+    csv_reader::Row row;
+    std::string scratch;
+    while (reader.next(row)) {
+        std::vector<std::string> fields;
+        for (std::size_t i = 0; i < row.size(); ++i) {
+            fields.emplace_back(row.field(i, scratch));
+        }
+        rows.push_back(fields);
+    }
+    return rows;
+}
+// Structural offsets of the whole text, scanned in blocks cut at `cuts`.
+std::vector<std::uint32_t> scanBlocks(std::string_view text, const std::vector<std::size_t> &cuts,
+                                      csv_reader::Kernel kernel) {
+    std::vector<std::uint32_t> all;
+    std::vector<std::uint32_t> offsets;
+    bool inQuotes = false;
+    std::size_t begin = 0;
+    for (std::size_t cut : cuts) {
+        csv_reader::scanStructure(text.substr(begin, cut - begin), inQuotes, offsets, kernel);
+        for (std::uint32_t offset : offsets) {
+            all.push_back(static_cast<std::uint32_t>(begin + offset));
+        }
+        begin = cut;
+    }
+    return all;
+}
+} // namespace
+
+int main() {
+    const csv_reader::Kernel kernels[] = {csv_reader::Kernel::Scalar, csv_reader::Kernel::Sse2,
+                                          csv_reader::Kernel::Avx2};
+
+    // Lines with balanced quotes read exactly as splitCsv splits them.
+    std::mt19937 rng(21);
+    const std::string alphabet = "ab ,\"\",\"x";
+    std::vector<std::string> lines;
+    std::string text;
+    for (int i = 0; i < 2000; ++i) {
+        std::string line;
+        int length = static_cast<int>(rng() % 24);
+        for (int c = 0; c < length; ++c) {
+            line += alphabet[rng() % alphabet.size()];
+        }
+        if (std::count(line.begin(), line.end(), '"') % 2 != 0) {
+            line += '"';
+        }
+        if (line.empty()) {
+            line = "e";
+        }
+        lines.push_back(line);
+        text += line + (i % 3 == 0 ? "\r\n" : "\n");
+        if (i % 50 == 0) {
+            text += "\n";
+        }
+    }
+    for (csv_reader::Kernel kernel : kernels) {
+        if (!csv_reader::kernelSupported(kernel)) {
+            continue;
+        }
+        auto rows = readAll(text, kernel);
+        if (rows.size() != lines.size()) {
+            std::cerr << "kernel " << static_cast<int>(kernel) << " read " << rows.size() << " rows of "
+                      << lines.size() << "\n";
+            return 1;
+        }
+        for (std::size_t i = 0; i < lines.size(); ++i) {
+            if (rows[i] != splitCsv(lines[i])) {
+                std::cerr << "kernel " << static_cast<int>(kernel) << " row " << i
+                          << " differs from splitCsv: " << lines[i] << "\n";
+                return 1;
+            }
+        }
+    }
+
+    // Every kernel finds the same structure, however the text is cut into blocks: the quote state
+    // carries from one block to the next, even when a cut falls inside quotes.
+    std::string noise;
+    for (int i = 0; i < 20000; ++i) {
+        noise += "a,\"\n\r"[rng() % 5];
+    }
+    std::vector<std::uint32_t> expected;
+    bool inside = false;
+    for (std::size_t i = 0; i < noise.size(); ++i) {
+        inside ^= noise[i] == '"';
+        if (noise[i] == '"' || (!inside && (noise[i] == ',' || noise[i] == '\n'))) {
+            expected.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+    for (int trial = 0; trial < 20; ++trial) {
+        std::vector<std::size_t> cuts;
+        for (std::size_t at = rng() % 200; at < noise.size(); at += 1 + rng() % 300) {
+            cuts.push_back(at);
+        }
+        cuts.push_back(noise.size());
+        for (csv_reader::Kernel kernel : kernels) {
+            if (csv_reader::kernelSupported(kernel) && scanBlocks(noise, cuts, kernel) != expected) {
+                std::cerr << "kernel " << static_cast<int>(kernel) << " scanned the structure wrong\n";
+                return 1;
+            }
+        }
+    }
+
+    // A quoted newline stays in its field, and the chunks cut around it.
+    std::string quoted = "id,name\n1,\"two\nlines\"\n2,\"say \"\"hi\"\"\"\n3,plain";
+    auto quotedRows = readAll(quoted);
+    if (quotedRows.size() != 4 || quotedRows[1][1] != "two\nlines" || quotedRows[2][1] != "say \"hi\"" ||
+        quotedRows[3][1] != "plain") {
+        std::cerr << "quoted fields read wrong\n";
+        return 1;
+    }
+    for (const std::string *sample : {&text, &quoted}) {
+        for (std::size_t count = 1; count <= 40; count += 3) {
+            std::vector<std::vector<std::string>> joined;
+            std::string rebuilt;
+            for (std::string_view chunk : csv_reader::splitChunks(*sample, count)) {
+                rebuilt += chunk;
+                for (auto &row : readAll(chunk)) {
+                    joined.push_back(row);
+                }
+            }
+            if (rebuilt != *sample || joined != readAll(*sample)) {
+                std::cerr << "splitting into " << count << " chunks changed the rows\n";
+                return 1;
+            }
+        }
+    }
+
+    // Every chunk is parsed once, whatever the number of threads.
+    auto chunks = csv_reader::splitChunks(text, 16);
+    std::vector<std::size_t> counts(chunks.size());
+    csv_reader::forEachChunk(chunks, 4, [&](std::size_t index, std::string_view chunk) {
+        counts[index] = readAll(chunk).size();
+    });
+    std::size_t total = 0;
+    for (std::size_t count : counts) {
+        total += count;
+    }
+    if (total != lines.size()) {
+        std::cerr << "chunks held " << total << " rows\n";
+        return 1;
+    }
+
+    csv_reader::RowReader headerReader("player_id,\"short_name\",age\n");
+    csv_reader::Row header;
+    headerReader.next(header);
+    auto columns = csv_reader::resolveColumns(header, {"age", "short_name", "wage_eur"});
+    if (columns[0] != 2 || columns[1] != 1 || columns[2] != csv_reader::kMissingColumn || header.raw(5) != "") {
+        std::cerr << "columns resolved wrong\n";
+        return 1;
+    }
+    return 0;
+}
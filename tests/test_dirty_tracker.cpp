@@ -0,0 +1,77 @@
+#include <iostream>
+
+#include "dirty_tracker.h"
+#include "pm3_data.h"
+
+int main() {
+    dirty_tracker::clear();
+    if (dirty_tracker::any()) {
+        std::cerr << "tracker dirty after clear\n";
+        return 1;
+    }
+
+    // Adjacent records merge into one range; out-of-range indices and local copies are ignored.
+    dirty_tracker::markPlayer(int16_t{10});
+    dirty_tracker::markPlayer(playerData.player[11]);
+    dirty_tracker::markPlayer(int16_t{20});
+    dirty_tracker::markPlayer(int16_t{-1});
+    PlayerRecord copy = playerData.player[30];
+    dirty_tracker::markPlayer(copy);
+    auto players = dirty_tracker::dirtyRanges('C');
+    if (players.size() != 2 || players[0].offset != 10 * sizeof(PlayerRecord) ||
+        players[0].size != 2 * sizeof(PlayerRecord) || players[1].offset != 20 * sizeof(PlayerRecord)) {
+        std::cerr << "unexpected player ranges\n";
+        return 1;
+    }
+
+    dirty_tracker::markClub(clubData.club[3]);
+    dirty_tracker::markClub(kClubIdxMax);
+    auto clubs = dirty_tracker::dirtyRanges('B');
+    if (clubs.size() != 1 || clubs[0].offset != 3 * sizeof(ClubRecord) || clubs[0].size != sizeof(ClubRecord)) {
+        std::cerr << "unexpected club ranges\n";
+        return 1;
+    }
+
+    // A field straddling a block boundary dirties both blocks; the last block is clipped to gamea.
+    const auto *base = reinterpret_cast<const uint8_t *>(&gameData);
+    dirty_tracker::markGameData(base + dirty_tracker::kGameDataBlockSize - 2, 4);
+    dirty_tracker::markGameData(base + sizeof(gamea) - 1, 1);
+    auto blocks = dirty_tracker::dirtyRanges('A');
+    std::size_t lastBlock = (dirty_tracker::kGameDataBlocks - 1) * dirty_tracker::kGameDataBlockSize;
+    if (blocks.size() != 2 || blocks[0].offset != 0 || blocks[0].size != 2 * dirty_tracker::kGameDataBlockSize ||
+        blocks[1].offset != lastBlock || blocks[1].offset + blocks[1].size != sizeof(gamea)) {
+        std::cerr << "unexpected game data ranges\n";
+        return 1;
+    }
+
+    // Each record remembers when it was last marked; clear() and markAll() count for all of them.
+    std::uint64_t before = dirty_tracker::generation();
+    dirty_tracker::markClub(5);
+    if (dirty_tracker::clubGeneration(5) <= before || dirty_tracker::clubGeneration(6) > before ||
+        dirty_tracker::playerGeneration(10) > before || dirty_tracker::clubGeneration(-1) != dirty_tracker::generation()) {
+        std::cerr << "unexpected record generations\n";
+        return 1;
+    }
+    dirty_tracker::markRange('C', 40 * sizeof(PlayerRecord), 1);
+    if (dirty_tracker::playerGeneration(40) != dirty_tracker::generation()) {
+        std::cerr << "markRange left the record generation behind\n";
+        return 1;
+    }
+
+    dirty_tracker::markAll();
+    if (dirty_tracker::clubGeneration(6) != dirty_tracker::generation()) {
+        std::cerr << "markAll left a record generation behind\n";
+        return 1;
+    }
+    if (dirty_tracker::dirtyBytes() != sizeof(gamea) + sizeof(gameb) + sizeof(gamec)) {
+        std::cerr << "markAll does not cover the whole save\n";
+        return 1;
+    }
+
+    dirty_tracker::clear();
+    if (dirty_tracker::any() || dirty_tracker::dirtyBytes() != 0) {
+        std::cerr << "tracker dirty after clear\n";
+        return 1;
+    }
+    return 0;
+}
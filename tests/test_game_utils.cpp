@@ -3,8 +3,11 @@
 #include <iostream>
 #include <vector>
 
+#include "dirty_tracker.h"
 #include "game_utils.h"
+#include "player_identity.h"
 #include "pm3_data.h"
+#include "roster_index.h"
 
 int main() {
     std::memset(&playerData, 0, sizeof(playerData));
@@ -42,6 +45,17 @@ int main() {
     // findPlayerIndex and findEmptySlot.
     int16_t idx = game_utils::findPlayerIndex(playerData.player[0]);
     if (idx != 0) return 1;
+    // A copy is found by identity, and the lookup follows edits announced to dirty_tracker.
+    PlayerRecord copy = playerData.player[1];
+    if (game_utils::findPlayerIndex(copy) != 1) return 1;
+    dirty_tracker::markPlayer(int16_t{1});
+    playerData.player[7] = playerData.player[1];
+    playerData.player[1] = PlayerRecord{};
+    dirty_tracker::markPlayer(int16_t{7});
+    if (game_utils::findPlayerIndex(copy) != 7) return 1;
+    playerData.player[1] = copy;
+    playerData.player[7] = PlayerRecord{};
+    dirty_tracker::markPlayer(int16_t{7});
     if (game_utils::findEmptySlot(club) != 2) return 1; // first open slot after two starters
 
     // findFreePlayers respects contract/league.
@@ -63,5 +77,77 @@ int main() {
     levelAggression();
     if (playerData.player[0].aggr != 5 || playerData.player[3920].aggr != 5) return 1;
 
+    // Transfers and coach conversions keep the roster index in step with clubData.
+    roster_index::invalidate();
+    if (game_utils::findClubIndexForPlayer(0) != 0) return 1;
+    game_utils::completeTransfer(0, 0, 5, 1000);
+    if (game_utils::findClubIndexForPlayer(0) != 5 || clubData.club[0].player_index[0] != -1) return 1;
+
+    // The converted player takes slot 23 of a lower club; that slot's occupant leaves the squad.
+    clubData.club[5].player_index[1] = 42;
+    for (int clubIdx = 92; clubIdx <= 113; ++clubIdx) {
+        clubData.club[clubIdx].player_index[23] = static_cast<int16_t>(3000 + clubIdx);
+    }
+    roster_index::invalidate();
+    char footer[70];
+    game_utils::convertPlayerToCoach(gameData.manager[0], clubData.club[5], 1, footer, sizeof(footer));
+    int coachClub = game_utils::findClubIndexForPlayer(42);
+    if (coachClub < 92 || coachClub > 113 || clubData.club[coachClub].player_index[23] != 42) return 1;
+    if (game_utils::findClubIndexForPlayer(static_cast<int16_t>(3000 + coachClub)) != -1) return 1;
+    if (!roster_index::verify()) return 1;
+
+    // Converting from a copy of a club clears the copy's slot and leaves clubData's squad alone.
+    ClubRecord clubCopy = clubData.club[5];
+    clubCopy.player_index[1] = 43;
+    ClubRecord before = clubData.club[5];
+    game_utils::convertPlayerToCoach(gameData.manager[0], clubCopy, 1, footer, sizeof(footer));
+    if (clubCopy.player_index[1] != -1 || std::memcmp(&before, &clubData.club[5], sizeof(ClubRecord)) != 0) return 1;
+    if (!roster_index::verify()) return 1;
+    for (int clubIdx = 92; clubIdx <= 113; ++clubIdx) {
+        roster_index::setSlot(clubIdx, 23, -1);
+    }
+
+    // Selections resolve through their handle, and by identity once the handle has gone stale.
+    std::memcpy(playerData.player[7].name, "HANDLED", 7);
+    PlayerSelection selection = game_utils::selectPlayer(PlayerRow{5, 7});
+    if (game_utils::resolvePlayer(selection) != 7) return 1;
+    player_identity::retireAll();
+    playerData.player[7].morl = 9; // the live record moved on since the selection
+    if (game_utils::resolvePlayer(selection) != 7) return 1;
+
+    // Listings are index rows that paginate without copying.
+    gameData.manager[0].club_idx = 5;
+    roster_index::setSlot(5, 2, 8);
+    roster_index::setSlot(5, 3, 9);
+    std::vector<PlayerRow> rows = getMyPlayers(0);
+    PlayerRowSpan page = PlayerRowSpan(rows).subspan(1, 10);
+    if (sizeof(PlayerRow) != 4 || rows.size() != 3 || page.size() != 2 || page.begin() != rows.data() + 1) return 1;
+    if (!PlayerRowSpan(rows).subspan(rows.size() + 5, 3).empty()) return 1;
+
+    // Squad summaries are cached per club until the next marked edit.
+    SquadSummary summary = squadSummary(clubData.club[5]);
+    if (summary.squadSize != 3 || summary.roleCounts[0] + summary.roleCounts[1] + summary.roleCounts[2] +
+                                          summary.roleCounts[3] != 3) return 1;
+    dirty_tracker::markClub(5);
+    roster_index::setSlot(5, 4, 10);
+    if (squadSummary(clubData.club[5]).squadSize != 4) return 1;
+    dirty_tracker::markPlayer(int16_t{10});
+    playerData.player[10].hn = 99;
+    summary = squadSummary(clubData.club[5]);
+    if (summary.bestOverall != 99 || summary.bestInRole[0] != 99) return 1;
+
+    // A marked edit only refreshes the summary of the club it touches.
+    dirty_tracker::markClub(7);
+    roster_index::setSlot(7, 0, 11);
+    dirty_tracker::markPlayer(int16_t{11});
+    playerData.player[11].hn = 40;
+    if (squadSummary(clubData.club[7]).bestOverall != 40) return 1;
+    playerData.player[11].hn = 60; // unmarked, so club 7 keeps its summary
+    dirty_tracker::markPlayer(int16_t{10});
+    playerData.player[10].hn = 98;
+    if (squadSummary(clubData.club[7]).bestOverall != 40 || squadSummary(clubData.club[5]).bestOverall != 98) return 1;
+    dirty_tracker::clear();
+    if (squadSummary(clubData.club[7]).bestOverall != 60) return 1;
+
     return 0;
 }
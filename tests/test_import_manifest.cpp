@@ -0,0 +1,147 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+
+#include "import_manifest.h"
+
+using import_manifest::Change;
+
+int main() {
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "pm3000_test_import_manifest";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    std::filesystem::path path = dir / "GAME1.FCIMPORT";
+
+    import_manifest::Manifest manifest;
+    manifest.clubs = {{3, "ARSENAL"}, {7, "WEST HAM UNITED"}};
+    manifest.players = {
+            {101, 0, 3, 0xAAAA},              // unchanged
+            {102, 1, 3, 0xBBBB},              // new attributes
+            {103, 2, 3, 0xCCCC},              // moves to club 7
+            {104, 3, 7, 0xFFFFFFFFFFFFFFFFULL}, // leaves the export
+            {105, -1, 7, 0xEEEE},             // on the bench, moves abroad
+    };
+    std::string error;
+    if (!import_manifest::write(path, manifest, error)) {
+        std::cerr << "write failed: " << error << "\n";
+        return 1;
+    }
+    import_manifest::Manifest loaded;
+    if (!import_manifest::read(path, loaded) || loaded.clubs.size() != 2 || loaded.clubs[1].name != "WEST HAM UNITED" ||
+        loaded.clubs[1].index != 7 || loaded.players.size() != 5 || loaded.players[3].hash != 0xFFFFFFFFFFFFFFFFULL ||
+        loaded.players[4].record != -1 || loaded.players[2].club != 3) {
+        std::cerr << "manifest did not round-trip\n";
+        return 1;
+    }
+    std::ofstream(dir / "other.txt") << "PM3000 BACKUP\n";
+    if (import_manifest::read(dir / "other.txt", loaded) || import_manifest::read(dir / "missing", loaded)) {
+        std::cerr << "a file that is not a manifest was read\n";
+        return 1;
+    }
+
+    std::vector<import_manifest::Row> rows = {
+            {106, 7, 0x1},    // new at a known club
+            {101, 3, 0xAAAA},
+            {102, 3, 0xBBBC},
+            {103, 7, 0xCCCC},
+            {105, -1, 0xEEEE},
+            {107, -1, 0x2},   // new at an unknown club
+            {101, 7, 0xAAAA}, // repeated id
+    };
+    auto changes = import_manifest::diff(manifest.players, rows);
+    struct Expected {
+        Change change;
+        std::size_t previous;
+        std::size_t current;
+    };
+    const Expected expected[] = {
+            {Change::Added, import_manifest::kNone, 0},
+            {Change::AttributesChanged, 1, 2},
+            {Change::ClubChanged, 2, 3},
+            {Change::Removed, 3, import_manifest::kNone},
+            {Change::Removed, 4, import_manifest::kNone},
+    };
+    if (changes.size() != std::size(expected)) {
+        std::cerr << "found " << changes.size() << " changes\n";
+        return 1;
+    }
+    for (std::size_t i = 0; i < changes.size(); ++i) {
+        if (changes[i].change != expected[i].change || changes[i].previous != expected[i].previous ||
+            changes[i].current != expected[i].current) {
+            std::cerr << "change " << i << " classified wrong\n";
+            return 1;
+        }
+    }
+
+    // Nothing changes against itself.
+    std::vector<import_manifest::Row> same;
+    for (const auto &player : manifest.players) {
+        same.push_back({player.playerId, player.club, player.hash});
+    }
+    if (!import_manifest::diff(manifest.players, same).empty()) {
+        std::cerr << "an unchanged export produced changes\n";
+        return 1;
+    }
+
+    // Applying the changes moves squads and records, and leaves the manifest matching the rows.
+    auto swapped = [](int16_t idx) { return static_cast<int16_t>((static_cast<uint16_t>(idx) >> 8) | (idx << 8)); };
+    auto clubs = std::make_unique<gameb>();
+    auto players = std::make_unique<gamec>();
+    for (auto &club : clubs->club) {
+        for (int slot = 0; slot < 24; ++slot) {
+            club.player_index[slot] = -1;
+        }
+    }
+    for (int16_t record = 0; record < 3; ++record) {
+        clubs->club[3].player_index[record] = swapped(record);
+    }
+    clubs->club[7].player_index[0] = swapped(3);
+    players->player[3].hn = 9;
+    players->player[3].name[0] = 'X';
+    import_manifest::Hooks hooks;
+    hooks.build = [](std::size_t row, const ClubRecord &, const gamec &) {
+        PlayerRecord record{};
+        record.hn = static_cast<uint8_t>(50 + row);
+        return record;
+    };
+    hooks.refresh = [](PlayerRecord &record, std::size_t row) { record.hn = static_cast<uint8_t>(100 + row); };
+    import_manifest::ApplyStats stats = import_manifest::apply(manifest, rows, changes, *clubs, *players, hooks);
+    if (stats.added != 1 || stats.removed != 2 || stats.attributesChanged != 1 || stats.clubChanged != 1 ||
+        stats.benched != 0) {
+        std::cerr << "apply counted the changes wrong\n";
+        return 1;
+    }
+    const int16_t squad3[] = {0, 1, -1};
+    const int16_t squad7[] = {4, 2, -1};
+    for (int slot = 0; slot < 3; ++slot) {
+        if (clubs->club[3].player_index[slot] != (squad3[slot] < 0 ? -1 : swapped(squad3[slot])) ||
+            clubs->club[7].player_index[slot] != (squad7[slot] < 0 ? -1 : swapped(squad7[slot]))) {
+            std::cerr << "squads wrong after apply at slot " << slot << "\n";
+            return 1;
+        }
+    }
+    if (players->player[4].hn != 50 || players->player[1].hn != 102 || players->player[2].hn != 0 ||
+        players->player[3].hn != 0 || players->player[3].name[0] != 0) {
+        std::cerr << "records wrong after apply\n";
+        return 1;
+    }
+    if (manifest.players.size() != 4 || manifest.players[2].club != 7 || manifest.players[3].playerId != 106 ||
+        manifest.players[3].record != 4 || manifest.players[1].hash != 0xBBBC) {
+        std::cerr << "manifest wrong after apply\n";
+        return 1;
+    }
+
+    // A staged manifest only replaces the old one when committed.
+    if (!import_manifest::stage(path, manifest, error) || !import_manifest::read(path, loaded) ||
+        loaded.players.size() != 5 || !import_manifest::commitStaged(path, error) ||
+        !import_manifest::read(path, loaded) || loaded.players.size() != 4) {
+        std::cerr << "staged manifest handled wrong: " << error << "\n";
+        return 1;
+    }
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include <SDL.h>
+#include <cstring>
 #include <iostream>
 
 #include "input.h"
@@ -33,6 +34,28 @@ int main() {
     input.checkKeyPressCallback(SDLK_a);
     if (keyTriggered) return 1;
 
+    // Text input: digits only by default, name characters in name mode.
+    SDL_Event event{};
+    event.type = SDL_TEXTINPUT;
+    std::strcpy(event.text.text, "a");
+    input.startReadingTextInput(nullptr);
+    input.handleTextInputEvent(event);
+    if (std::strcmp(input.getTextInput(), "") != 0) return 1;
+    int changes = 0;
+    input.startReadingTextInput([&] { ++changes; }, TextInputMode::Name);
+    input.handleTextInputEvent(event);
+    std::strcpy(event.text.text, ".");
+    input.handleTextInputEvent(event);
+    if (std::strcmp(input.getTextInput(), "a.") != 0 || changes != 2) return 1;
+    // The key press behind typed text must not reach the shortcuts.
+    SDL_Event key{};
+    key.type = SDL_KEYDOWN;
+    key.key.keysym.sym = SDLK_q;
+    if (!input.handleTextInputEvent(key)) return 1;
+    key.key.keysym.sym = SDLK_RETURN;
+    if (input.handleTextInputEvent(key)) return 1;
+    input.endReadingTextInput();
+
     SDL_Quit();
     return 0;
 }
@@ -1,7 +1,38 @@
+#include <chrono>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
 
+#include "dirty_tracker.h"
 #include "io.h"
+#include "undo_journal.h"
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+namespace {
+void writeZeros(const std::filesystem::path &path, std::size_t size) {
+    std::ofstream out(path, std::ios::binary);
+    out << std::string(size, '\0');
+}
+
+// A delta save patches the slot files in place; a full commit renames new files over them.
+unsigned long long fileId(const std::filesystem::path &path) {
+#ifndef _WIN32
+    struct stat info{};
+    return ::stat(path.c_str(), &info) == 0 ? static_cast<unsigned long long>(info.st_ino) : 0;
+#else
+    (void) path;
+    return 0;
+#endif
+}
+} // namespace
 
 int main() {
     // Ensure constructSavesFolderPath handles missing path gracefully.
@@ -25,5 +56,283 @@ int main() {
         return 1;
     }
 
+    // Saving back to the loaded slot writes only the changed records and stays verifiable.
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "pm3000_test_io";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir / "SAVES");
+    writeZeros(dir / "pm3game.exe", 1);
+    writeZeros(dir / "SAVES" / "GAME1A", sizeof(gamea));
+    writeZeros(dir / "SAVES" / "GAME1B", sizeof(gameb));
+    writeZeros(dir / "SAVES" / "GAME1C", sizeof(gamec));
+    writeZeros(dir / "SAVES" / "SAVES.DIR", sizeof(saves));
+    writeZeros(dir / "SAVES" / "PREFS", sizeof(prefs));
+
+    Settings settings;
+    settings.gamePath = dir;
+    char footer[100];
+    if (!io::loadGame(settings, 1, footer, sizeof(footer))) {
+        std::cerr << "loadGame failed: " << footer << "\n";
+        return 1;
+    }
+    // A slot PM3 wrote has no checksum sidecar yet; the first save commits it with the files.
+    auto sidecar = io::constructChecksumSidecarPath(dir, 1);
+    if (!io::saveGame(settings, 1, footer, sizeof(footer)) || !std::filesystem::exists(sidecar)) {
+        std::cerr << "first save wrote no sidecar: " << footer << "\n";
+        return 1;
+    }
+    auto slotFile = dir / "SAVES" / "GAME1C";
+    auto before = fileId(slotFile);
+    auto sidecarBefore = fileId(sidecar);
+    dirty_tracker::markPlayer(int16_t{5});
+    playerData.player[5].aggr = 7;
+    if (!io::saveGame(settings, 1, footer, sizeof(footer)) || fileId(slotFile) != before ||
+        fileId(sidecar) != sidecarBefore || !io::verifySaveGame(dir, 1)) {
+        std::cerr << "delta save failed: " << footer << " " << io::pm3LastError() << "\n";
+        return 1;
+    }
+    gamec onDisk{};
+    io::loadBinaries(1, dir, gameData, clubData, onDisk);
+    if (onDisk.player[5].aggr != 7) {
+        std::cerr << "delta save did not write the changed record\n";
+        return 1;
+    }
+
+    // A sidecar that no longer describes the loaded files sends the save to a full commit.
+    {
+        std::ofstream stale(sidecar, std::ios::binary | std::ios::in | std::ios::out);
+        stale.seekp(-2, std::ios::end);
+        stale << "0\n";
+    }
+    sidecarBefore = fileId(sidecar);
+    dirty_tracker::markPlayer(int16_t{6});
+    playerData.player[6].aggr = 3;
+    if (!io::saveGame(settings, 1, footer, sizeof(footer)) || fileId(sidecar) == sidecarBefore ||
+        !io::verifySaveGame(dir, 1)) {
+        std::cerr << "save over a stale sidecar did not commit: " << footer << "\n";
+        return 1;
+    }
+
+    // The tools' saveBinaries keeps the sidecar in step too.
+    onDisk.player[5].aggr = 2;
+    io::saveBinaries(1, dir, gameData, clubData, onDisk);
+    if (!io::verifySaveGame(dir, 1)) {
+        std::cerr << "saveBinaries left a stale sidecar: " << io::pm3LastError() << "\n";
+        return 1;
+    }
+
+    // Short or padded slot files load as far as they go; an empty one is an error.
+    writeZeros(dir / "SAVES" / "GAME5A", sizeof(gamea) + 4);
+    writeZeros(dir / "SAVES" / "GAME5B", sizeof(gameb));
+    writeZeros(dir / "SAVES" / "GAME5C", sizeof(gamec) - sizeof(PlayerRecord));
+    {
+        auto players = std::make_unique<gamec>();
+        players->player[3931].aggr = 4;
+        io::loadBinaries(5, dir, gameData, clubData, *players);
+        if (players->player[3931].aggr != 4 || players->player[5].aggr != 0) {
+            std::cerr << "short slot file not loaded as far as it goes\n";
+            return 1;
+        }
+        writeZeros(dir / "SAVES" / "GAME5C", 0);
+        bool threw = false;
+        try {
+            io::loadBinaries(5, dir, gameData, clubData, *players);
+        } catch (const std::runtime_error &) {
+            threw = true;
+        }
+        if (!threw) {
+            std::cerr << "empty slot file loaded\n";
+            return 1;
+        }
+    }
+    for (char letter : {'A', 'B', 'C'}) {
+        std::filesystem::remove(dir / "SAVES" / (std::string("GAME5") + letter));
+    }
+
+    // PM3 rewriting SAVES.DIR in place is picked up before the next save writes it back.
+    {
+        saves external{};
+        io::loadMetadata(dir, external, prefsData);
+        external.game[6].year = 1999;
+        auto savesDirPath = dir / "SAVES" / "SAVES.DIR";
+        auto stamp = std::filesystem::last_write_time(savesDirPath);
+        std::ofstream out(savesDirPath, std::ios::binary | std::ios::in);
+        out.write(reinterpret_cast<const char *>(&external), sizeof(external));
+        out.close();
+        std::filesystem::last_write_time(savesDirPath, stamp + std::chrono::seconds(1));
+    }
+    dirty_tracker::markPlayer(int16_t{5});
+    if (!io::saveGame(settings, 1, footer, sizeof(footer))) {
+        std::cerr << "save after a SAVES.DIR rewrite failed: " << footer << "\n";
+        return 1;
+    }
+    {
+        saves onDiskDir{};
+        io::loadMetadata(dir, onDiskDir, prefsData);
+        if (onDiskDir.game[6].year != 1999 || savesDir.game[6].year != 1999) {
+            std::cerr << "save wrote back a stale SAVES.DIR\n";
+            return 1;
+        }
+    }
+
+    // Once something else rewrote the slot, the next save falls back to a full commit.
+    writeZeros(slotFile, sizeof(gamec));
+    std::filesystem::last_write_time(slotFile, std::filesystem::last_write_time(slotFile) + std::chrono::seconds(1));
+    dirty_tracker::markPlayer(int16_t{6});
+    playerData.player[6].aggr = 3;
+    before = fileId(slotFile);
+    if (!io::saveGame(settings, 1, footer, sizeof(footer)) || !io::verifySaveGame(dir, 1)) {
+        std::cerr << "full save failed: " << footer << "\n";
+        return 1;
+    }
+    io::loadBinaries(1, dir, gameData, clubData, onDisk);
+    if (onDisk.player[5].aggr != 7 || onDisk.player[6].aggr != 3 || (before != 0 && fileId(slotFile) == before)) {
+        std::cerr << "stale slot was patched instead of rewritten\n";
+        return 1;
+    }
+
+    // A slot rewritten by PM3 is reloaded once the write settles, but never over unsaved edits.
+    io::reloadChangedSaves(settings, 1, footer, sizeof(footer));
+    onDisk.player[9].aggr = 5;
+    {
+        std::ofstream out(slotFile, std::ios::binary);
+        out.write(reinterpret_cast<const char *>(&onDisk), sizeof(onDisk));
+    }
+    std::filesystem::last_write_time(slotFile, std::filesystem::last_write_time(slotFile) + std::chrono::seconds(2));
+    auto waitForReload = [&] {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (std::chrono::steady_clock::now() < deadline) {
+            if (io::reloadChangedSaves(settings, 1, footer, sizeof(footer))) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+        return false;
+    };
+    dirty_tracker::markPlayer(int16_t{1});
+    if (!waitForReload() || std::string(footer).find("UNSAVED") == std::string::npos ||
+        playerData.player[9].aggr == 5) {
+        std::cerr << "reloaded over unsaved edits: " << footer << "\n";
+        return 1;
+    }
+    dirty_tracker::clear();
+    if (!waitForReload() || std::string(footer) != "GAME1 RELOADED: 0 CLUBS, 1 PLAYERS, 0 BYTES GAME DATA" ||
+        playerData.player[9].aggr != 5) {
+        std::cerr << "external write not reloaded: " << footer << "\n";
+        return 1;
+    }
+    // A rewrite that can no longer be read when the reload runs keeps the slot and its undo history.
+    onDisk.player[9].aggr = 6;
+    {
+        std::ofstream out(slotFile, std::ios::binary);
+        out.write(reinterpret_cast<const char *>(&onDisk), sizeof(onDisk));
+    }
+    std::filesystem::last_write_time(slotFile, std::filesystem::last_write_time(slotFile) + std::chrono::seconds(4));
+    undo_journal::beginStep();
+    dirty_tracker::markPlayer(int16_t{2});
+    playerData.player[2].aggr = 4;
+    if (!waitForReload() || std::string(footer).find("UNSAVED") == std::string::npos) {
+        std::cerr << "second external write not held: " << footer << "\n";
+        return 1;
+    }
+    std::filesystem::resize_file(slotFile, 100);
+    dirty_tracker::clear();
+    if (!io::reloadChangedSaves(settings, 1, footer, sizeof(footer)) ||
+        std::string(footer) != "ERROR RELOADING GAME 1" || playerData.player[2].aggr != 4 ||
+        playerData.player[9].aggr != 5 || !undo_journal::canUndo()) {
+        std::cerr << "failed reload reset the slot: " << footer << "\n";
+        return 1;
+    }
+    // A big-endian (Amiga) slot is converted on load and written back in its own order.
+    {
+        auto clubs = std::make_unique<gameb>();
+        for (auto &club : clubs->club) {
+            for (int slot = 0; slot < 24; ++slot) {
+                club.player_index[slot] = -1;
+            }
+        }
+        clubs->club[4].player_index[0] = static_cast<int16_t>(0xb80b); // 3000 on the Amiga
+        std::ofstream out(dir / "SAVES" / "GAME2B", std::ios::binary);
+        out.write(reinterpret_cast<const char *>(clubs.get()), sizeof(gameb));
+    }
+    writeZeros(dir / "SAVES" / "GAME2A", sizeof(gamea));
+    writeZeros(dir / "SAVES" / "GAME2C", sizeof(gamec));
+    if (!io::loadGame(settings, 2, footer, sizeof(footer)) || clubData.club[4].player_index[0] != 3000) {
+        std::cerr << "big-endian slot not converted on load\n";
+        return 1;
+    }
+    dirty_tracker::markClub(4);
+    clubData.club[4].player_index[1] = 3001;
+    if (!io::saveGame(settings, 2, footer, sizeof(footer)) || !io::verifySaveGame(dir, 2)) {
+        std::cerr << "big-endian save failed: " << footer << "\n";
+        return 1;
+    }
+    {
+        auto clubs = std::make_unique<gameb>();
+        std::ifstream in(dir / "SAVES" / "GAME2B", std::ios::binary);
+        in.read(reinterpret_cast<char *>(clubs.get()), sizeof(gameb));
+        if (static_cast<uint16_t>(clubs->club[4].player_index[0]) != 0xb80b ||
+            static_cast<uint16_t>(clubs->club[4].player_index[1]) != 0xb90b) {
+            std::cerr << "big-endian slot not saved in its own order\n";
+            return 1;
+        }
+    }
+    // A bundle of slot 2 imports into slot 3 byte for byte, including bytes past the gamea struct.
+    {
+        std::ofstream out(dir / "SAVES" / "GAME2A", std::ios::binary | std::ios::app);
+        out << "TAIL";
+    }
+    savesDir.game[1].year = 1996;
+    io::saveMetadata(dir / "SAVES", savesDir, preferences);
+    auto bundlePath = dir / "career.pm3bundle";
+    if (!io::exportBundle(settings, 2, bundlePath) || !io::importBundle(settings, bundlePath, 3)) {
+        std::cerr << "bundle round trip failed: " << io::pm3LastError() << "\n";
+        return 1;
+    }
+    auto readAll = [](const std::filesystem::path &path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    };
+    for (char letter : {'A', 'B', 'C'}) {
+        if (readAll(dir / "SAVES" / (std::string("GAME2") + letter)) !=
+            readAll(dir / "SAVES" / (std::string("GAME3") + letter))) {
+            std::cerr << "bundle import differs for " << letter << "\n";
+            return 1;
+        }
+    }
+    saves importedDir{};
+    io::loadMetadata(dir, importedDir, prefsData);
+    if (importedDir.game[2].year != 1996 || importedDir.game[1].year != 1996 || !io::verifySaveGame(dir, 3)) {
+        std::cerr << "bundle import did not update SAVES.DIR\n";
+        return 1;
+    }
+    // Importing over the loaded slot replaces the loaded game, unsaved edits included.
+    playerData.player[8].aggr = 9;
+    dirty_tracker::markPlayer(int16_t{8});
+    if (!io::importBundle(settings, bundlePath, 2) || playerData.player[8].aggr != 0 || dirty_tracker::any() ||
+        clubData.club[4].player_index[1] != 3001 || !io::saveGame(settings, 2, footer, sizeof(footer)) ||
+        readAll(dir / "SAVES" / "GAME2C") != readAll(dir / "SAVES" / "GAME3C")) {
+        std::cerr << "bundle import over the loaded slot left the old game loaded\n";
+        return 1;
+    }
+    // Without a complete SAVES.DIR the copy read from this folder stands in, rather than blanks.
+    std::filesystem::resize_file(dir / "SAVES" / "SAVES.DIR", sizeof(saves) - 1);
+    if (!io::importBundle(settings, bundlePath, 3) ||
+        std::filesystem::file_size(dir / "SAVES" / "SAVES.DIR") != sizeof(saves) ||
+        !io::loadMetadata(dir, importedDir, prefsData) || importedDir.game[6].year != 1999) {
+        std::cerr << "bundle import without SAVES.DIR lost the other slots: " << io::pm3LastError() << "\n";
+        return 1;
+    }
+    // In a folder that was never read, it is refused.
+    std::filesystem::create_directories(dir / "other" / "SAVES");
+    writeZeros(dir / "other" / "pm3game.exe", 1);
+    Settings otherSettings;
+    otherSettings.gamePath = dir / "other";
+    if (io::importBundle(otherSettings, bundlePath, 3) || io::pm3LastError().find("SAVES.DIR") == std::string::npos ||
+        std::filesystem::exists(dir / "other" / "SAVES" / "SAVES.DIR")) {
+        std::cerr << "bundle import went ahead without SAVES.DIR\n";
+        return 1;
+    }
+    std::filesystem::remove_all(dir);
+
     return 0;
 }
@@ -0,0 +1,98 @@
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "dirty_tracker.h"
+#include "name_index.h"
+#include "pm3_data.h"
+
+namespace {
+void setName(char *field, std::size_t size, const char *name) {
+    std::memset(field, 0, size);
+    std::strncpy(field, name, size);
+}
+
+bool contains(const std::vector<name_index::Match> &matches, name_index::Kind kind, int index, int distance) {
+    for (const name_index::Match &match : matches) {
+        if (match.kind == kind && match.index == index) {
+            return match.distance == distance;
+        }
+    }
+    return false;
+}
+} // namespace
+
+int main() {
+    using name_index::Kind;
+
+    if (name_index::normalize("j. o'neil ", 12) != "J O NEIL" || name_index::normalize("ABCDEFGHIJKLMNOP", 4) != "ABCD") {
+        std::cerr << "normalize\n";
+        return 1;
+    }
+    if (name_index::prefixDistance("SMTH", "SMITHSON") != 1 || name_index::prefixDistance("SMI", "SMITH") != 0 ||
+        name_index::prefixDistance("XYZ", "AB") != 3) {
+        std::cerr << "prefixDistance\n";
+        return 1;
+    }
+
+    auto players = std::make_unique<gamec>();
+    auto clubs = std::make_unique<gameb>();
+    std::memset(players.get(), 0, sizeof(gamec));
+    std::memset(clubs.get(), 0, sizeof(gameb));
+    for (int i = 0; i < 3932; ++i) {
+        std::string name = "P" + std::to_string(i * 7919 % 100000);
+        setName(players->player[i].name, sizeof(players->player[i].name), name.c_str());
+    }
+    setName(players->player[10].name, 12, "A.SMITH");
+    setName(players->player[11].name, 12, "SMITHSON");
+    setName(players->player[12].name, 12, "SMYTH");
+    setName(players->player[13].name, 12, "");
+    setName(clubs->club[5].name, 16, "SMITHFIELD TOWN");
+    setName(clubs->club[6].name, 16, "MAN UNITED");
+
+    name_index::Index index(*players, *clubs);
+
+    // Prefixes of any word; the full name or the surname.
+    auto matches = index.find("smith", 20);
+    if (!contains(matches, Kind::Player, 10, 0) || !contains(matches, Kind::Player, 11, 0) ||
+        !contains(matches, Kind::Club, 5, 0) || !contains(matches, Kind::Player, 12, 1)) {
+        std::cerr << "smith lookup\n";
+        return 1;
+    }
+    if (matches.front().distance != 0 || matches.back().distance != 1) {
+        std::cerr << "prefix matches must come first\n";
+        return 1;
+    }
+    if (!contains(index.find("UNI", 5), Kind::Club, 6, 0) || !contains(index.find("a smi", 5), Kind::Player, 10, 0)) {
+        std::cerr << "word lookup\n";
+        return 1;
+    }
+
+    // Typos: a transposition (one edit from the prefix SMIT), a wrong letter.
+    if (!contains(index.find("SMIHT", 20), Kind::Player, 10, 1) ||
+        !contains(index.find("UNOTED", 20), Kind::Club, 6, 1)) {
+        std::cerr << "typo lookup\n";
+        return 1;
+    }
+    if (index.find("QQQQQQ", 20).size() != 0 || index.find("SM", 2).size() != 2) {
+        std::cerr << "unexpected result count\n";
+        return 1;
+    }
+
+    // The live index follows marked edits.
+    dirty_tracker::clear();
+    std::memset(&playerData, 0, sizeof(playerData));
+    dirty_tracker::markAll();
+    if (!name_index::live().find("ZOLA", 5).empty()) {
+        std::cerr << "empty save matched\n";
+        return 1;
+    }
+    dirty_tracker::markPlayer(int16_t{3});
+    setName(playerData.player[3].name, 12, "ZOLA");
+    if (!contains(name_index::live().find("ZOLA", 5), Kind::Player, 3, 0)) {
+        std::cerr << "live index did not follow an edit\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+
+#include "dirty_tracker.h"
+#include "player_attributes.h"
+#include "pm3_data.h"
+
+int main() {
+    using namespace player_attributes;
+
+    auto players = std::make_unique<gamec>();
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> stat(0, 99);
+    std::uniform_int_distribution<int> nibble(0, 15);
+    for (PlayerRecord &player : players->player) {
+        std::memset(&player, 0, sizeof(player));
+        player.hn = static_cast<uint8_t>(stat(rng));
+        player.tk = static_cast<uint8_t>(stat(rng));
+        player.ps = static_cast<uint8_t>(stat(rng));
+        player.sh = static_cast<uint8_t>(stat(rng));
+        player.hd = static_cast<uint8_t>(stat(rng));
+        player.cr = static_cast<uint8_t>(stat(rng));
+        player.ft = static_cast<uint8_t>(stat(rng));
+        player.aggr = static_cast<uint8_t>(nibble(rng));
+        player.age = static_cast<uint8_t>(16 + nibble(rng));
+    }
+    // Ties between roles must resolve the same way in every kernel.
+    players->player[0].hn = players->player[0].tk = players->player[0].ps = players->player[0].sh = 0;
+    std::memset(&players->player[1], 0, sizeof(PlayerRecord));
+
+    Columns columns = extract(*players);
+    if (columns.size() != std::size(players->player) || columns.aggr[5] != players->player[5].aggr ||
+        columns.age[7] != players->player[7].age) {
+        std::cerr << "columns do not mirror the records\n";
+        return 1;
+    }
+
+    // Odd sizes exercise the scalar tail after the vector loop.
+    for (std::size_t size : {columns.size(), std::size_t{7}}) {
+        Columns part = columns;
+        for (auto *column : {&part.hn, &part.tk, &part.ps, &part.sh, &part.hd, &part.cr, &part.ft, &part.aggr,
+                             &part.age}) {
+            column->resize(size);
+        }
+        for (Kernel kernel : {Kernel::Scalar, Kernel::Sse2, Kernel::Avx2}) {
+            if (!kernelSupported(kernel)) {
+                continue;
+            }
+            RoleRatings ratings;
+            rateRoles(part, ratings, kernel);
+            for (std::size_t i = 0; i < size; ++i) {
+                const PlayerRecord &player = players->player[i];
+                for (char role : {'G', 'D', 'M', 'A'}) {
+                    double expected = roleRating(role, player);
+                    double actual = ratings.rating[roleIndex(role)][i];
+                    if (std::memcmp(&expected, &actual, sizeof(double)) != 0) {
+                        std::cerr << "kernel " << static_cast<int>(kernel) << " rates player " << i << " as " << role
+                                  << " " << actual << ", expected " << expected << "\n";
+                        return 1;
+                    }
+                }
+                char role = valuationRole(roleRating('G', player), roleRating('D', player),
+                                          roleRating('M', player), roleRating('A', player));
+                if (ratings.role[i] != role) {
+                    std::cerr << "kernel " << static_cast<int>(kernel) << " picks role " << ratings.role[i]
+                              << " for player " << i << ", expected " << role << "\n";
+                    return 1;
+                }
+            }
+        }
+    }
+
+    // The live mirror follows marked edits to playerData.
+    playerData.player[42].hn = 10;
+    dirty_tracker::clear();
+    if (live().hn[42] != 10) {
+        std::cerr << "live columns not extracted\n";
+        return 1;
+    }
+    dirty_tracker::markPlayer(int16_t{42});
+    playerData.player[42].hn = 90;
+    if (live().hn[42] != 90 || liveRatings().role[42] != 'G') {
+        std::cerr << "live columns did not follow an edit\n";
+        return 1;
+    }
+    return 0;
+}
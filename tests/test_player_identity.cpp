@@ -0,0 +1,80 @@
+#include <cstring>
+#include <iostream>
+#include <memory>
+
+#include "player_identity.h"
+#include "pm3_data.h"
+
+namespace {
+void setPlayer(PlayerRecord &player, const char *name, int age, int foot, int skill) {
+    std::memset(&player, 0, sizeof(player));
+    std::strncpy(player.name, name, sizeof(player.name));
+    player.age = static_cast<uint8_t>(age);
+    player.foot = static_cast<uint8_t>(foot);
+    player.hn = player.tk = player.ps = player.sh = player.hd = player.cr = static_cast<uint8_t>(skill);
+}
+} // namespace
+
+int main() {
+    // Handles resolve until the record is retired, individually or all at once.
+    if (player_identity::resolve(PlayerHandle{}) != -1) {
+        std::cerr << "default handle resolved\n";
+        return 1;
+    }
+    PlayerHandle first = player_identity::handleFor(10);
+    PlayerHandle second = player_identity::handleFor(11);
+    if (player_identity::resolve(first) != 10 || player_identity::resolve(second) != 11) {
+        std::cerr << "fresh handles do not resolve\n";
+        return 1;
+    }
+    player_identity::retire(10);
+    if (player_identity::resolve(first) != -1 || player_identity::resolve(second) != 11 ||
+        player_identity::resolve(player_identity::handleFor(10)) != 10) {
+        std::cerr << "retire did not invalidate only that player\n";
+        return 1;
+    }
+    player_identity::retireAll();
+    if (player_identity::resolve(second) != -1 || player_identity::handleFor(5000).index != -1) {
+        std::cerr << "retireAll left a handle valid\n";
+        return 1;
+    }
+
+    // Identity lookups: exact first, then name and foot when that is unambiguous.
+    auto players = std::make_unique<gamec>();
+    std::memset(players.get(), 0, sizeof(gamec));
+    setPlayer(players->player[100], "SMITH", 24, 1, 60);
+    setPlayer(players->player[200], "JONES", 30, 2, 70);
+    setPlayer(players->player[201], "JONES", 22, 2, 50);
+    player_identity::IdentityMap map(*players);
+
+    PlayerRecord probe = players->player[100];
+    probe.morl = 7; // morale is not part of the identity
+    if (map.find(probe) != 100 || map.find(players->player[201]) != 201) {
+        std::cerr << "exact identity lookup failed\n";
+        return 1;
+    }
+
+    // A season later: older and better, but still the only SMITH kicking with that foot.
+    setPlayer(probe, "SMITH", 25, 1, 64);
+    if (map.find(probe) != 100) {
+        std::cerr << "season-later lookup failed\n";
+        return 1;
+    }
+    setPlayer(probe, "JONES", 31, 2, 72);
+    if (map.find(probe) != -1) {
+        std::cerr << "ambiguous name matched\n";
+        return 1;
+    }
+    setPlayer(probe, "SMITH", 25, 0, 64);
+    if (map.find(probe) != -1) {
+        std::cerr << "different foot matched\n";
+        return 1;
+    }
+
+    if (player_identity::identityKey(players->player[200]) == player_identity::identityKey(players->player[201]) ||
+        player_identity::nameKey(players->player[200]) != player_identity::nameKey(players->player[201])) {
+        std::cerr << "unexpected identity keys\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+
+#include "dirty_tracker.h"
+#include "game_utils.h"
+#include "player_search.h"
+#include "pm3_data.h"
+
+namespace {
+// The query evaluated record by record, as a reference for the bitmaps.
+bool matches(const player_search::Query &query, PlayerRecord player, int division) {
+    int rating = determinePlayerRating(player);
+    rating = rating > 99 ? 99 : rating;
+    bool excluded = player.period > 0 && ((query.excludedPeriodTypes >> player.period_type) & 1);
+    return (query.roles.empty() || query.roles.find(determinePlayerType(player)) != std::string::npos) &&
+           player.age >= query.minAge && player.age <= query.maxAge && rating >= query.minRating &&
+           rating <= query.maxRating && player.contract >= query.minContract &&
+           player.contract <= query.maxContract && (query.foot < 0 || player.foot == query.foot) &&
+           division >= query.minDivision && division <= query.maxDivision && !excluded;
+}
+} // namespace
+
+int main() {
+    using player_search::Query;
+
+    auto players = std::make_unique<gamec>();
+    auto clubs = std::make_unique<gameb>();
+    std::memset(players.get(), 0, sizeof(gamec));
+    std::memset(clubs.get(), 0, sizeof(gameb));
+    std::mt19937 rng(99);
+    std::uniform_int_distribution<int> stat(0, 99);
+    for (PlayerRecord &player : players->player) {
+        player.hn = static_cast<uint8_t>(stat(rng) / 2);
+        player.tk = static_cast<uint8_t>(stat(rng));
+        player.ps = static_cast<uint8_t>(stat(rng));
+        player.sh = static_cast<uint8_t>(stat(rng));
+        player.age = static_cast<uint8_t>(16 + stat(rng) % 20);
+        player.foot = static_cast<uint8_t>(stat(rng) % 3);
+        player.contract = static_cast<uint8_t>(stat(rng) % 5);
+        player.period = static_cast<uint8_t>(stat(rng) % 4 == 0 ? 3 : 0);
+        player.period_type = static_cast<uint8_t>(stat(rng) % 21);
+    }
+    // Squads of 20 for every league club; player 7 is listed twice and counts for club 0.
+    std::vector<int> divisionOf(std::size(players->player), -1);
+    for (int clubIdx = 0; clubIdx < 114; ++clubIdx) {
+        ClubRecord &club = clubs->club[clubIdx];
+        club.league = static_cast<uint8_t>(clubIdx / 23 < 5 ? clubIdx / 23 : 4);
+        for (int slot = 0; slot < 24; ++slot) {
+            int16_t idx = slot < 20 ? static_cast<int16_t>(clubIdx * 20 + slot) : int16_t{-1};
+            club.player_index[slot] = idx;
+            if (idx >= 0) {
+                divisionOf[idx] = club.league;
+            }
+        }
+    }
+    clubs->club[113].player_index[23] = 7;
+
+    player_search::Index index(*players, *clubs);
+
+    // defenders 24-28, rating >= 70, contract <= 1, not injured, division >= 1
+    Query query;
+    query.roles = "D";
+    query.minAge = 24;
+    query.maxAge = 28;
+    query.minRating = 70;
+    query.maxContract = 1;
+    query.excludedPeriodTypes = player_search::kInjuryPeriodTypes;
+    query.minDivision = 1;
+
+    std::uniform_int_distribution<int> pick(0, 7);
+    for (int round = 0; round < 200; ++round) {
+        if (round > 0) {
+            query = Query{};
+            query.roles = std::string("GDMA").substr(pick(rng) % 4, pick(rng) % 3);
+            query.minAge = 16 + pick(rng) * 2;
+            query.maxAge = query.minAge + pick(rng) * 3;
+            query.minRating = pick(rng) * 12;
+            query.maxContract = pick(rng);
+            query.foot = pick(rng) % 4 - 1;
+            query.minDivision = pick(rng) % 5;
+            query.excludedPeriodTypes = round % 3 == 0 ? player_search::kAllPeriodTypes
+                                                       : round % 3 == 1 ? player_search::kInjuryPeriodTypes : 0;
+        }
+        std::vector<PlayerRow> rows = index.rows(index.match(query));
+        std::size_t expected = 0;
+        for (int idx = 0; idx < static_cast<int>(divisionOf.size()); ++idx) {
+            if (divisionOf[idx] < 0 || !matches(query, players->player[idx], divisionOf[idx])) {
+                continue;
+            }
+            if (expected >= rows.size() || rows[expected].player != idx || rows[expected].club != idx / 20) {
+                std::cerr << "round " << round << " missed player " << idx << "\n";
+                return 1;
+            }
+            ++expected;
+        }
+        if (rows.size() != expected) {
+            std::cerr << "round " << round << " found " << rows.size() << " players, expected " << expected << "\n";
+            return 1;
+        }
+        if (round == 0 && expected == 0) {
+            std::cerr << "example query matched nobody\n";
+            return 1;
+        }
+    }
+
+    // Empty ranges and unplaced players never match.
+    Query nobody;
+    nobody.minAge = 40;
+    nobody.maxAge = 30;
+    if (index.match(nobody).count() != 0 || index.match(Query{}).test(114 * 20)) {
+        std::cerr << "unexpected match\n";
+        return 1;
+    }
+
+    // The live index follows marked edits.
+    dirty_tracker::clear();
+    std::memset(&clubData, 0, sizeof(clubData));
+    for (ClubRecord &club : clubData.club) {
+        for (int slot = 0; slot < 24; ++slot) {
+            club.player_index[slot] = -1;
+        }
+    }
+    clubData.club[3].player_index[0] = 5;
+    playerData.player[5].age = 30;
+    dirty_tracker::markAll();
+    Query thirty;
+    thirty.minAge = 30;
+    thirty.maxAge = 30;
+    if (player_search::search(thirty).size() != 1) {
+        std::cerr << "live index not built\n";
+        return 1;
+    }
+    dirty_tracker::markPlayer(int16_t{5});
+    playerData.player[5].age = 31;
+    if (!player_search::search(thirty).empty()) {
+        std::cerr << "live index did not follow an edit\n";
+        return 1;
+    }
+    return 0;
+}
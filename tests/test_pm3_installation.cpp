@@ -0,0 +1,84 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "folder_watch.h"
+#include "pm3_installation.h"
+
+namespace {
+void touch(const std::filesystem::path &path) {
+    std::ofstream out(path, std::ios::binary);
+    out << "x";
+}
+} // namespace
+
+int main() {
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "pm3000_test_pm3_installation";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    auto empty = io::resolveInstallation(dir);
+    if (empty->valid() || io::resolveInstallation(dir) != empty) {
+        std::cerr << "unchanged folder was resolved again\n";
+        return 1;
+    }
+
+    // Adding the executable and saves is picked up by the watches.
+    touch(dir / "pm3game.exe");
+    std::filesystem::create_directories(dir / "SAVES");
+    auto standard = io::resolveInstallation(dir);
+    if (!standard->valid() || standard->gameType != Pm3GameType::Standard || standard->savesFolder != dir / "SAVES" ||
+        standard->slotFiles[1][2] != dir / "SAVES" / "GAME2C" || standard->presentSlots.any()) {
+        std::cerr << "standard installation not resolved\n";
+        return 1;
+    }
+
+    touch(dir / "SAVES" / "GAME2A");
+    touch(dir / "SAVES" / "GAME2B");
+    touch(dir / "SAVES" / "GAME2C");
+    auto withSlot = io::resolveInstallation(dir);
+    if (withSlot == standard || !withSlot->presentSlots.test(1) || withSlot->presentSlots.count() != 1) {
+        std::cerr << "new slot not detected\n";
+        return 1;
+    }
+    if (io::resolveInstallation(dir) != withSlot) {
+        std::cerr << "unchanged folder was resolved again\n";
+        return 1;
+    }
+
+    io::invalidateInstallation();
+    if (io::resolveInstallation(dir) == withSlot) {
+        std::cerr << "invalidate kept the cached installation\n";
+        return 1;
+    }
+
+    // The watch reports completed writes and removals by name.
+    io::FolderWatch watch(dir / "SAVES");
+    if (watch.poll()) {
+        std::cerr << "fresh watch reported changes\n";
+        return 1;
+    }
+    touch(dir / "SAVES" / "GAME2A");
+    std::filesystem::remove(dir / "SAVES" / "GAME2B");
+    std::vector<io::FolderEvent> events;
+    if (!watch.poll(&events) || events.empty()) {
+        std::cerr << "watch missed changes\n";
+        return 1;
+    }
+    if (watch.fd() != -1) {
+        bool written = false, removed = false;
+        for (const auto &event : events) {
+            written = written || (event.name == "GAME2A" && event.written);
+            removed = removed || (event.name == "GAME2B" && event.removed);
+        }
+        if (!written || !removed) {
+            std::cerr << "watch events lack names\n";
+            return 1;
+        }
+    }
+
+    io::invalidateInstallation();
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include <cstring>
+#include <iostream>
+
+#include "pm3_data.h"
+#include "roster_index.h"
+
+int main() {
+    std::memset(&clubData, 0xff, sizeof(clubData)); // every slot -1
+    clubData.club[3].player_index[5] = 100;
+    clubData.club[50].player_index[0] = 200;
+    clubData.club[200].player_index[0] = 300; // past the indexed clubs
+    roster_index::invalidate();
+
+    auto placement = roster_index::find(100);
+    if (placement.club != 3 || placement.slot != 5) {
+        std::cerr << "player 100 placed at " << placement.club << "/" << placement.slot << "\n";
+        return 1;
+    }
+    if (roster_index::find(300).club != -1 || roster_index::find(-1).club != -1 ||
+        roster_index::find(5000).club != -1) {
+        std::cerr << "unexpected placement for unindexed players\n";
+        return 1;
+    }
+
+    // A transfer moves the player and empties the old slot.
+    roster_index::setSlot(3, 5, -1);
+    roster_index::setSlot(10, 2, 100);
+    placement = roster_index::find(100);
+    if (placement.club != 10 || placement.slot != 2 || clubData.club[3].player_index[5] != -1 ||
+        clubData.club[10].player_index[2] != 100) {
+        std::cerr << "transfer not reflected\n";
+        return 1;
+    }
+
+    // Overwriting a slot drops its previous occupant.
+    roster_index::setSlot(50, 0, 100);
+    if (roster_index::find(200).club != -1 || roster_index::find(100).club != 10) {
+        std::cerr << "overwritten slot not reflected\n";
+        return 1;
+    }
+
+    // With the player listed twice, removing the first slot falls back to the second.
+    roster_index::setSlot(10, 2, -1);
+    placement = roster_index::find(100);
+    if (placement.club != 50 || placement.slot != 0) {
+        std::cerr << "duplicate not found after removal\n";
+        return 1;
+    }
+
+    if (!roster_index::verify()) {
+        std::cerr << "index disagrees with a full scan\n";
+        return 1;
+    }
+
+    // Edits behind the index's back are picked up after invalidate.
+    clubData.club[7].player_index[1] = 400;
+    roster_index::invalidate();
+    if (roster_index::find(400).club != 7) {
+        std::cerr << "rebuild missed a new placement\n";
+        return 1;
+    }
+    return 0;
+}
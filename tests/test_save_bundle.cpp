@@ -0,0 +1,109 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "save_bundle.h"
+
+namespace {
+void writeBytes(const std::filesystem::path &path, const std::vector<std::uint8_t> &bytes) {
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+bool readsCleanly(const std::filesystem::path &path) {
+    try {
+        io::SaveBundle bundle(path);
+        bundle.section(io::BundleSection::GameB);
+        bundle.section(io::BundleSection::GameC);
+        return true;
+    } catch (const std::runtime_error &) {
+        return false;
+    }
+}
+} // namespace
+
+int main() {
+    // RLE round-trips runs, literals and their boundaries.
+    std::mt19937 rng(3);
+    std::vector<std::uint8_t> mixed;
+    for (int i = 0; i < 5000; ++i) {
+        int kind = static_cast<int>(rng() % 3);
+        std::size_t length = 1 + rng() % 300;
+        for (std::size_t j = 0; j < length; ++j) {
+            mixed.push_back(kind == 0 ? 0 : static_cast<std::uint8_t>(kind == 1 ? ' ' : rng()));
+        }
+    }
+    std::vector<std::uint8_t> decoded;
+    auto encoded = io::encodeRle(mixed.data(), mixed.size());
+    if (!io::decodeRle(encoded.data(), encoded.size(), mixed.size(), decoded) || decoded != mixed ||
+        encoded.size() >= mixed.size()) {
+        std::cerr << "RLE round trip failed\n";
+        return 1;
+    }
+    if (io::decodeRle(encoded.data(), encoded.size(), mixed.size() - 1, decoded)) {
+        std::cerr << "RLE accepted the wrong raw size\n";
+        return 1;
+    }
+    // A raw size no input of that length can expand to is refused before anything is reserved.
+    if (io::decodeRle(encoded.data(), encoded.size(), std::size_t{1} << 60, decoded)) {
+        std::cerr << "RLE accepted an impossible raw size\n";
+        return 1;
+    }
+
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "pm3000_test_save_bundle";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    std::vector<std::uint8_t> zeros(4096, 0);
+    std::vector<std::uint8_t> noise(777);
+    for (auto &byte : noise) {
+        byte = static_cast<std::uint8_t>(rng());
+    }
+    auto bytes = io::buildBundle(5, {
+            {io::BundleSection::GameB, zeros.data(), zeros.size()},
+            {io::BundleSection::GameC, noise.data(), noise.size()},
+            {io::BundleSection::GameaTail, nullptr, 0},
+    }, true);
+    auto path = dir / ("slot" + std::string{io::kBundleExtension});
+    writeBytes(path, bytes);
+    io::SaveBundle bundle(path);
+    if (bundle.sourceSlot() != 5 || bundle.section(io::BundleSection::GameB) != zeros ||
+        bundle.section(io::BundleSection::GameC) != noise || !bundle.section(io::BundleSection::GameaTail).empty() ||
+        bundle.has(io::BundleSection::Prefs) || bytes.size() > noise.size() + 512) {
+        std::cerr << "bundle contents mismatch\n";
+        return 1;
+    }
+
+    // Any damaged byte is caught: in the header by its checksum, in a section by the section's.
+    for (std::size_t at : {std::size_t{20}, bytes.size() - 800, bytes.size() - 1}) {
+        auto damaged = bytes;
+        damaged[at] ^= 0x40;
+        writeBytes(dir / "damaged.pm3bundle", damaged);
+        if (readsCleanly(dir / "damaged.pm3bundle")) {
+            std::cerr << "damage at " << at << " not detected\n";
+            return 1;
+        }
+    }
+    // Sections larger than the file they stand for are refused.
+    std::vector<std::uint8_t> oversized(sizeof(gameb) + 1, 0);
+    writeBytes(dir / "oversized.pm3bundle", io::buildBundle(1, {
+            {io::BundleSection::GameB, oversized.data(), oversized.size()},
+            {io::BundleSection::GameC, noise.data(), noise.size()},
+    }, true));
+    if (readsCleanly(dir / "oversized.pm3bundle")) {
+        std::cerr << "oversized section accepted\n";
+        return 1;
+    }
+    writeBytes(dir / "truncated.pm3bundle", std::vector<std::uint8_t>(bytes.begin(), bytes.begin() + 30));
+    if (readsCleanly(dir / "truncated.pm3bundle")) {
+        std::cerr << "truncated bundle accepted\n";
+        return 1;
+    }
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
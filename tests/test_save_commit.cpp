@@ -0,0 +1,102 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+#include "config/constants.h"
+#include "save_commit.h"
+
+namespace {
+std::string readFile(const std::filesystem::path &path) {
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+void writeFile(const std::filesystem::path &path, const std::string &text) {
+    std::ofstream out(path, std::ios::binary);
+    out << text;
+}
+} // namespace
+
+int main() {
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "pm3000_test_save_commit";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    writeFile(dir / "GAME1A", "old-a");
+    writeFile(dir / "GAME1B", "old-b");
+
+    // A full commit replaces existing files, creates new ones and leaves nothing behind.
+    std::string a = "new-a", b = "new-b", c = "new-c", tail = "+tail";
+    std::string error;
+    bool committed = io::commitFiles(dir, {
+            {dir / "GAME1A", a.data(), a.size()},
+            {dir / "GAME1B", b.data(), b.size(), tail.data(), tail.size()},
+            {dir / "GAME1C", c.data(), c.size()},
+    }, error);
+    if (!committed) {
+        std::cerr << "commit failed: " << error << "\n";
+        return 1;
+    }
+    if (readFile(dir / "GAME1A") != "new-a" || readFile(dir / "GAME1B") != "new-b+tail" ||
+        readFile(dir / "GAME1C") != "new-c") {
+        std::cerr << "commit wrote unexpected contents\n";
+        return 1;
+    }
+    for (const auto &entry : std::filesystem::directory_iterator(dir)) {
+        std::string name = entry.path().filename().string();
+        if (name != "GAME1A" && name != "GAME1B" && name != "GAME1C") {
+            std::cerr << "leftover file " << name << "\n";
+            return 1;
+        }
+    }
+    if (io::recoverInterruptedCommit(dir)) {
+        std::cerr << "clean folder reported as repaired\n";
+        return 1;
+    }
+
+    // Simulate a crash in the middle of the swap: GAME1A already swapped, GAME1B moved aside,
+    // GAME1C (new file) swapped in. Recovery must restore the previous state.
+    writeFile(dir / COMMIT_JOURNAL_PATH, "PM3000 COMMIT\n1 GAME1A\n1 GAME1B\n0 GAME2C\n");
+    writeFile(dir / "GAME1A.pm3old", "new-a");
+    writeFile(dir / "GAME1A", "newer-a");
+    std::filesystem::rename(dir / "GAME1B", dir / "GAME1B.pm3old");
+    writeFile(dir / "GAME1B.pm3new", "newer-b");
+    writeFile(dir / "GAME2C", "newer-c");
+
+    if (!io::recoverInterruptedCommit(dir)) {
+        std::cerr << "interrupted commit not detected\n";
+        return 1;
+    }
+    if (readFile(dir / "GAME1A") != "new-a" || readFile(dir / "GAME1B") != "new-b+tail" ||
+        std::filesystem::exists(dir / "GAME2C") || std::filesystem::exists(dir / "GAME1B.pm3new") ||
+        std::filesystem::exists(dir / COMMIT_JOURNAL_PATH)) {
+        std::cerr << "interrupted commit not rolled back\n";
+        return 1;
+    }
+
+    // Temp files without a journal are dropped.
+    writeFile(dir / "GAME1C.pm3new", "partial");
+    if (!io::recoverInterruptedCommit(dir) || std::filesystem::exists(dir / "GAME1C.pm3new") ||
+        readFile(dir / "GAME1C") != "new-c") {
+        std::cerr << "stray temp file not cleaned\n";
+        return 1;
+    }
+
+    // A target in a missing folder fails without touching anything else.
+    error.clear();
+    if (io::commitFiles(dir, {{dir / "GAME1A", a.data(), a.size()},
+                              {dir / "missing" / "GAME1B", b.data(), b.size()}}, error) || error.empty()) {
+        std::cerr << "commit into missing folder succeeded\n";
+        return 1;
+    }
+    if (readFile(dir / "GAME1A") != "new-a" || readFile(dir / "GAME1B") != "new-b+tail" ||
+        std::filesystem::exists(dir / "GAME1A.pm3new")) {
+        std::cerr << "failed commit left changes behind\n";
+        return 1;
+    }
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
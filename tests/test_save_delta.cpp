@@ -0,0 +1,98 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+#include "config/constants.h"
+#include "save_delta.h"
+
+namespace {
+std::string readFile(const std::filesystem::path &path) {
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+void writeFile(const std::filesystem::path &path, const std::string &text) {
+    std::ofstream out(path, std::ios::binary);
+    out << text;
+}
+} // namespace
+
+int main() {
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "pm3000_test_save_delta";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    writeFile(dir / "GAME1A", "aaaaaaaaaa");
+    writeFile(dir / "GAME1B", "bbbbbbbbbb");
+
+    // Only the given ranges are written; the rest of the file keeps its bytes on disk.
+    std::string imageA = "0123456789", imageB = "ABCDEFGHIJ";
+    std::string error;
+    if (!io::patchFiles(dir, {{dir / "GAME1A", imageA.data(), {{1, 2}, {8, 2}}},
+                              {dir / "GAME1B", imageB.data(), {{0, 1}}}}, error)) {
+        std::cerr << "patch failed: " << error << "\n";
+        return 1;
+    }
+    if (readFile(dir / "GAME1A") != "a12aaaaa89" || readFile(dir / "GAME1B") != "Abbbbbbbbb" ||
+        std::filesystem::exists(dir / PATCH_UNDO_LOG_PATH)) {
+        std::cerr << "patch wrote unexpected contents\n";
+        return 1;
+    }
+
+    // A range past the end of the file is refused before anything is written.
+    if (io::patchFiles(dir, {{dir / "GAME1A", imageA.data(), {{0, 1}}},
+                             {dir / "GAME1B", imageB.data(), {{9, 5}}}}, error) || error.empty()) {
+        std::cerr << "out of bounds patch succeeded\n";
+        return 1;
+    }
+    if (readFile(dir / "GAME1A") != "a12aaaaa89") {
+        std::cerr << "refused patch changed a file\n";
+        return 1;
+    }
+
+    // Simulate a crash after the undo log was written and GAME1A was half patched: recovery
+    // restores the bytes recorded in the log.
+    std::string newer = "xxxxxxxxxx";
+    if (!io::writePatchUndoLog(dir, {{dir / "GAME1A", newer.data(), {{0, 3}, {5, 2}}}}, error)) {
+        std::cerr << "undo log failed: " << error << "\n";
+        return 1;
+    }
+    writeFile(dir / "GAME1A", "xxxaaaaa89");
+    if (!io::recoverInterruptedPatch(dir) || std::filesystem::exists(dir / PATCH_UNDO_LOG_PATH) ||
+        readFile(dir / "GAME1A") != "a12aaaaa89") {
+        std::cerr << "interrupted patch not rolled back\n";
+        return 1;
+    }
+
+    // A log that was never completed means no file was touched; it is just dropped.
+    writeFile(dir / PATCH_UNDO_LOG_PATH, "PM3UNDO1 truncated");
+    if (!io::recoverInterruptedPatch(dir) || std::filesystem::exists(dir / PATCH_UNDO_LOG_PATH) ||
+        readFile(dir / "GAME1A") != "a12aaaaa89") {
+        std::cerr << "incomplete undo log not discarded\n";
+        return 1;
+    }
+    if (io::recoverInterruptedPatch(dir)) {
+        std::cerr << "clean folder reported as repaired\n";
+        return 1;
+    }
+
+    // Sidecar checksums catch any byte that differs from what was saved.
+    std::string contents = readFile(dir / "GAME1A");
+    std::string sidecar = io::formatChecksumSidecar({{"GAME1A", contents.size(),
+                                                      io::checksum(contents.data(), contents.size())}});
+    writeFile(dir / ("GAME1" + std::string(CHECKSUM_SIDECAR_SUFFIX)), sidecar);
+    if (!io::verifyChecksumSidecar(dir / ("GAME1" + std::string(CHECKSUM_SIDECAR_SUFFIX)), error)) {
+        std::cerr << "sidecar rejected matching file: " << error << "\n";
+        return 1;
+    }
+    writeFile(dir / "GAME1A", "a12aaaaa88");
+    if (io::verifyChecksumSidecar(dir / ("GAME1" + std::string(CHECKSUM_SIDECAR_SUFFIX)), error)) {
+        std::cerr << "sidecar accepted a changed file\n";
+        return 1;
+    }
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+
+#include "save_view.h"
+
+namespace {
+template <typename T>
+void writeStruct(const std::filesystem::path &path, const T &data) {
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char *>(&data), sizeof(T));
+}
+
+template <typename T>
+std::unique_ptr<T> readStruct(const std::filesystem::path &path) {
+    auto data = std::make_unique<T>();
+    std::ifstream in(path, std::ios::binary);
+    in.read(reinterpret_cast<char *>(data.get()), sizeof(T));
+    return data;
+}
+} // namespace
+
+int main() {
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "pm3000_test_save_view";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    auto a = std::make_unique<gamea>();
+    auto b = std::make_unique<gameb>();
+    auto c = std::make_unique<gamec>();
+    std::memset(a.get(), 0, sizeof(gamea));
+    std::memset(b.get(), 0, sizeof(gameb));
+    std::memset(c.get(), 0, sizeof(gamec));
+    a->year = 1995;
+    a->turn = 42;
+    std::strncpy(b->club[7].name, "ARSENAL", sizeof(b->club[7].name));
+    b->club[7].player_index[0] = 1234;
+    c->player[1234].hn = 77;
+    c->player[3931].wage = 999;
+
+    writeStruct(dir / "GAME1A", *a);
+    writeStruct(dir / "GAME1B", *b);
+    writeStruct(dir / "GAME1C", *c);
+
+    io::SaveView view(dir / "GAME1A", dir / "GAME1B", dir / "GAME1C");
+    if (view.gameA().year != 1995 || view.gameA().turn != 42) return 1;
+    if (std::strcmp(view.gameB().club[7].name, "ARSENAL") != 0) return 1;
+    if (view.gameB().club[7].player_index[0] != 1234) return 1;
+    if (view.gameC().player[1234].hn != 77 || view.gameC().player[3931].wage != 999) return 1;
+
+    // Edits stay private to the mapping and never reach the file.
+    view.editPlayer(1234).hn = 12;
+    view.editClub(7).bank_account = 5000000;
+    view.editGameA().year = 2001;
+    if (view.gameC().player[1234].hn != 12 || view.gameB().club[7].bank_account != 5000000) return 1;
+    if (readStruct<gamec>(dir / "GAME1C")->player[1234].hn != 77) {
+        std::cerr << "edit leaked into GAME1C\n";
+        return 1;
+    }
+    if (readStruct<gamea>(dir / "GAME1A")->year != 1995) {
+        std::cerr << "edit leaked into GAME1A\n";
+        return 1;
+    }
+
+    auto outA = std::make_unique<gamea>();
+    auto outB = std::make_unique<gameb>();
+    auto outC = std::make_unique<gamec>();
+    view.copyTo(*outA, *outB, *outC);
+    if (outA->year != 2001 || outC->player[1234].hn != 12 || outC->player[3931].wage != 999) return 1;
+
+    // Wrong sizes and missing files are rejected.
+    {
+        std::ofstream truncated(dir / "GAME2A", std::ios::binary);
+        truncated.write(reinterpret_cast<const char *>(a.get()), 100);
+    }
+    bool threw = false;
+    try {
+        io::SaveView bad(dir / "GAME2A", dir / "GAME1B", dir / "GAME1C");
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    if (!threw) return 1;
+
+    threw = false;
+    try {
+        io::MappedFile missing(dir / "NOPE");
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    if (!threw) return 1;
+
+    // readExact fills caller buffers and refuses files of any other size.
+    auto readA = std::make_unique<gamea>();
+    if (!io::readExact(dir / "GAME1A", readA.get(), sizeof(gamea)) || readA->year != 1995) return 1;
+    if (io::readExact(dir / "GAME2A", readA.get(), sizeof(gamea))) return 1;
+    if (io::readExact(dir / "NOPE", readA.get(), sizeof(gamea))) return 1;
+
+    io::MappedFile moved(dir / "GAME1A");
+    io::MappedFile target = std::move(moved);
+    if (target.size() != sizeof(gamea) || !moved.empty()) return 1;
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "save_watcher.h"
+
+namespace {
+void writeFilled(const std::filesystem::path &path, std::size_t size, char fill) {
+    std::ofstream out(path, std::ios::binary);
+    out << std::string(size, fill);
+}
+} // namespace
+
+int main() {
+    int gameNumber = 0;
+    char gameLetter = 0;
+    if (!io::parseSaveFileName("GAME3B", gameNumber, gameLetter) || gameNumber != 3 || gameLetter != 'B' ||
+        io::parseSaveFileName("GAME9A", gameNumber, gameLetter) ||
+        io::parseSaveFileName("GAME1D", gameNumber, gameLetter) ||
+        io::parseSaveFileName("GAME1.SUM", gameNumber, gameLetter) ||
+        io::parseSaveFileName("SAVES.DIR", gameNumber, gameLetter)) {
+        std::cerr << "parseSaveFileName failed\n";
+        return 1;
+    }
+
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "pm3000_test_save_watcher";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    using Clock = io::SaveWatcher::Clock;
+    io::SaveWatcher watcher(dir, std::chrono::milliseconds(500));
+    Clock::time_point t0 = Clock::now();
+
+    // A half-written file is never reported, however long it stays that way.
+    auto path = dir / "GAME2B";
+    writeFilled(path, sizeof(gameb) / 2, '\x01');
+    writeFilled(dir / "NOTES.TXT", 4, 'x');
+    if (!watcher.poll(t0).empty() || !watcher.poll(t0 + std::chrono::seconds(5)).empty()) {
+        std::cerr << "partial write reported\n";
+        return 1;
+    }
+
+    // Completing the write restarts the quiet period.
+    writeFilled(path, sizeof(gameb), '\x01');
+    Clock::time_point t1 = t0 + std::chrono::seconds(6);
+    if (!watcher.poll(t1).empty() || !watcher.poll(t1 + std::chrono::milliseconds(100)).empty()) {
+        std::cerr << "file reported before the quiet period\n";
+        return 1;
+    }
+    auto settled = watcher.poll(t1 + std::chrono::seconds(1));
+    if (settled.size() != 1 || settled[0].gameNumber != 2 || settled[0].gameLetter != 'B' || settled[0].path != path) {
+        std::cerr << "settled file not reported\n";
+        return 1;
+    }
+    if (!watcher.poll(t1 + std::chrono::seconds(2)).empty()) {
+        std::cerr << "settled file reported twice\n";
+        return 1;
+    }
+
+    auto before = std::make_unique<gameb>();
+    auto after = std::make_unique<gameb>();
+    *after = *before;
+    after->club[7].seating_max = 1;
+    after->club[100].name[0] = 'Z';
+    io::RecordChanges changes;
+    io::diffRecords(*before, *after, changes);
+
+    auto players = std::make_unique<gamec>();
+    auto playersAfter = std::make_unique<gamec>(*players);
+    playersAfter->player[3931].age = 30;
+    io::diffRecords(*players, *playersAfter, changes);
+
+    if (changes.clubs.size() != 2 || changes.clubs[0] != 7 || changes.clubs[1] != 100 || changes.players.size() != 1 ||
+        changes.players[0] != 3931 || changes.gameDataBytes != 0) {
+        std::cerr << "diffRecords mismatch\n";
+        return 1;
+    }
+    if (io::summarizeChanges(2, changes) != "GAME2 RELOADED: 2 CLUBS, 1 PLAYERS, 0 BYTES GAME DATA" ||
+        io::summarizeChanges(2, {}) != "GAME2 RELOADED: NO RECORDS CHANGED") {
+        std::cerr << "summary mismatch: " << io::summarizeChanges(2, changes) << "\n";
+        return 1;
+    }
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
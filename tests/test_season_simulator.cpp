@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "pm3_data.h"
+#include "season_simulator.h"
+
+namespace {
+using season_simulator::kDivisionSizes;
+
+// Every division as a double round robin (circle method), one round per turn from turn 0.
+void buildLeague(gamea &game, gameb &clubs, gamec &players) {
+    std::memset(&game, 0, sizeof(gamea));
+    std::memset(&clubs, 0, sizeof(gameb));
+    std::memset(&players, 0, sizeof(gamec));
+    for (ClubRecord &club : clubs.club) {
+        for (int slot = 0; slot < 24; ++slot) {
+            club.player_index[slot] = -1;
+        }
+    }
+
+    int first = 0;
+    for (int d = 0; d < 5; ++d) {
+        int size = kDivisionSizes[d];
+        for (int i = 0; i < size; ++i) {
+            int clubIdx = first + i;
+            game.table.all[clubIdx].club_idx = static_cast<int16_t>(clubIdx);
+            clubs.club[clubIdx].league = static_cast<uint8_t>(d);
+            for (int slot = 0; slot < 16; ++slot) {
+                int16_t idx = static_cast<int16_t>(clubIdx * 16 + slot);
+                PlayerRecord &player = players.player[idx];
+                uint8_t skill = static_cast<uint8_t>(70 - 8 * d + (clubIdx * 7 + slot) % 9);
+                player.hn = player.tk = player.ps = player.sh = player.hd = player.cr = player.ft = skill;
+                player.age = 25;
+                player.contract = 2;
+                clubs.club[clubIdx].player_index[slot] = idx;
+            }
+        }
+
+        std::vector<int> order(size);
+        std::iota(order.begin(), order.end(), first);
+        for (int round = 0; round < size - 1; ++round) {
+            for (int i = 0; i < size / 2; ++i) {
+                int a = order[i];
+                int b = order[size - 1 - i];
+                for (int turn : {round, round + size - 1}) {
+                    clubs.club[a].timetable.week[turn / 3].day[turn % 3].opponent_idx = static_cast<uint8_t>(b);
+                    clubs.club[b].timetable.week[turn / 3].day[turn % 3].opponent_idx = static_cast<uint8_t>(a);
+                }
+            }
+            std::rotate(order.begin() + 1, order.end() - 1, order.end());
+        }
+        first += size;
+    }
+}
+
+std::size_t expectedFixtures(int fromTurn) {
+    std::size_t fixtures = 0;
+    for (int size : kDivisionSizes) {
+        int rounds = 2 * (size - 1);
+        fixtures += static_cast<std::size_t>(std::max(rounds - fromTurn, 0) * size / 2);
+    }
+    return fixtures;
+}
+} // namespace
+
+int main() {
+    auto game = std::make_unique<gamea>();
+    auto clubs = std::make_unique<gameb>();
+    auto players = std::make_unique<gamec>();
+    buildLeague(*game, *clubs, *players);
+
+    season_simulator::Season season = season_simulator::fromSave(*game, *clubs, *players);
+    if (season.teams.size() != 114 || season.divisionStart[1] != 22 || season.divisionStart[5] != 114 ||
+        season.fixtures.size() != expectedFixtures(0)) {
+        std::cerr << "full season read as " << season.teams.size() << " teams and " << season.fixtures.size()
+                  << " fixtures\n";
+        return 1;
+    }
+
+    // A timetable entry the opponent does not confirm is not a fixture.
+    uint8_t opponent = clubs->club[30].timetable.week[0].day[0].opponent_idx;
+    clubs->club[30].timetable.week[0].day[0].opponent_idx = 60;
+    if (season_simulator::fromSave(*game, *clubs, *players).fixtures.size() != expectedFixtures(0) - 1) {
+        std::cerr << "one-sided fixture was counted\n";
+        return 1;
+    }
+    clubs->club[30].timetable.week[0].day[0].opponent_idx = opponent;
+
+    game->turn = 23;
+    game->table.all[5].hw = 3;
+    game->table.all[5].hd = 1;
+    game->table.all[5].aw = 2;
+    game->table.all[5].hf = 9;
+    game->table.all[5].aa = 4;
+    season = season_simulator::fromSave(*game, *clubs, *players);
+    if (season.fixtures.size() != expectedFixtures(23) || season.teams[5].points != 16 ||
+        season.teams[5].goalsFor != 9 || season.teams[5].goalsAgainst != 4) {
+        std::cerr << "mid-season read wrong: " << season.fixtures.size() << " fixtures, " << season.teams[5].points
+                  << " points\n";
+        return 1;
+    }
+
+    // Unavailable players do not count towards the strength.
+    player_attributes::RoleRatings ratings;
+    player_attributes::rateRoles(player_attributes::extract(*players), ratings);
+    float strength = season_simulator::teamStrength(clubs->club[40], *players, ratings);
+    for (int slot = 0; slot < 16; ++slot) {
+        PlayerRecord &player = players->player[clubs->club[40].player_index[slot]];
+        player.period = 3;
+        player.period_type = static_cast<uint8_t>(slot % 2 == 0 ? 5 : 20);
+    }
+    float depleted = season_simulator::teamStrength(clubs->club[40], *players, ratings);
+    if (!(depleted < strength) || depleted <= 0.0f) {
+        std::cerr << "strength " << strength << " with everyone, " << depleted << " with half injured\n";
+        return 1;
+    }
+
+    season_simulator::Options options;
+    options.seasons = 700;
+    options.threads = 1;
+    season_simulator::Result single = season_simulator::simulate(season, options);
+    options.threads = 4;
+    season_simulator::Result parallel = season_simulator::simulate(season, options);
+    for (std::size_t t = 0; t < single.clubs.size(); ++t) {
+        const auto &a = single.clubs[t];
+        const auto &b = parallel.clubs[t];
+        if (a.title != b.title || a.promotion != b.promotion || a.relegation != b.relegation ||
+            a.averagePoints != b.averagePoints || a.averagePosition != b.averagePosition) {
+            std::cerr << "thread count changed the odds of team " << t << "\n";
+            return 1;
+        }
+    }
+
+    for (int d = 0; d < 5; ++d) {
+        double titles = 0.0, promotions = 0.0, relegations = 0.0;
+        for (int t = season.divisionStart[d]; t < season.divisionStart[d + 1]; ++t) {
+            titles += single.clubs[t].title;
+            promotions += single.clubs[t].promotion;
+            relegations += single.clubs[t].relegation;
+        }
+        if (std::fabs(titles - 1.0) > 1e-9 || std::fabs(promotions - season_simulator::kPromotionPlaces[d]) > 1e-9 ||
+            std::fabs(relegations - season_simulator::kRelegationPlaces[d]) > 1e-9) {
+            std::cerr << "division " << d << " odds do not add up\n";
+            return 1;
+        }
+    }
+
+    // A far stronger side nearly always wins the league.
+    for (int slot = 0; slot < 16; ++slot) {
+        PlayerRecord &player = players->player[clubs->club[50].player_index[slot]];
+        player.hn = player.tk = player.ps = player.sh = player.hd = player.cr = player.ft = 99;
+    }
+    game->turn = 0;
+    season = season_simulator::fromSave(*game, *clubs, *players);
+    season_simulator::Result favourite = season_simulator::simulate(season, options);
+    if (favourite.clubs[50].club != 50 || favourite.clubs[50].title < 0.95 ||
+        favourite.clubs[50].averagePosition > 1.2) {
+        std::cerr << "favourite won " << favourite.clubs[50].title << " of titles\n";
+        return 1;
+    }
+
+    // With nothing left to play the standings decide.
+    game->turn = 41 * 3;
+    game->table.all[100].hw = 20;
+    season = season_simulator::fromSave(*game, *clubs, *players);
+    season_simulator::Result finished = season_simulator::simulate(season, options);
+    if (!season.fixtures.empty() || finished.clubs[100].title != 1.0 || finished.clubs[100].promotion != 1.0) {
+        std::cerr << "finished season not decided by the table\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include <cstring>
+#include <iostream>
+#include <random>
+
+#include "dirty_tracker.h"
+#include "game_utils.h"
+#include "player_attributes.h"
+#include "pm3_data.h"
+#include "roster_index.h"
+#include "similar_players.h"
+
+int main() {
+    using player_attributes::Kernel;
+
+    // Full byte range, so the kernels' 16-bit squares are exercised at their limit.
+    player_attributes::Columns columns;
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> byte(0, 255);
+    for (auto *column : {&columns.hn, &columns.tk, &columns.ps, &columns.sh, &columns.hd, &columns.cr, &columns.ft,
+                         &columns.aggr, &columns.age}) {
+        column->resize(1003);
+        for (std::uint8_t &value : *column) {
+            value = static_cast<std::uint8_t>(byte(rng));
+        }
+    }
+    columns.hn[0] = 0;
+    columns.hn[1] = 255;
+    similar_players::Weights weights{16, 1, 2, 3, 4, 5, 6, 7, 200};
+
+    std::vector<std::uint32_t> reference;
+    similar_players::distances(columns, 0, weights, reference, Kernel::Scalar);
+    if (reference[0] != 0 || reference[1] < 255u * 255u * 16u) {
+        std::cerr << "scalar distances are wrong\n";
+        return 1;
+    }
+    for (Kernel kernel : {Kernel::Sse2, Kernel::Avx2}) {
+        std::vector<std::uint32_t> actual;
+        similar_players::distances(columns, 0, weights, actual, kernel);
+        if (actual != reference) {
+            std::cerr << "kernel " << static_cast<int>(kernel) << " disagrees with the scalar distances\n";
+            return 1;
+        }
+    }
+
+    // Two clubs: the buyer (club 0) and a seller with a near twin, a far player and a star.
+    std::memset(&clubData, 0, sizeof(clubData));
+    std::memset(&playerData, 0, sizeof(playerData));
+    for (ClubRecord &club : clubData.club) {
+        for (int slot = 0; slot < 24; ++slot) {
+            club.player_index[slot] = -1;
+        }
+    }
+    auto setPlayer = [](int16_t idx, int skill, int age) {
+        PlayerRecord &player = playerData.player[idx];
+        player.hn = player.tk = player.ps = player.sh = player.hd = player.cr = player.ft =
+                static_cast<uint8_t>(skill);
+        player.age = static_cast<uint8_t>(age);
+        player.wage = 300;
+    };
+    setPlayer(10, 60, 25);
+    setPlayer(20, 61, 25);
+    setPlayer(21, 30, 31);
+    setPlayer(22, 62, 25);
+    setPlayer(23, 59, 25);
+    clubData.club[0].player_index[0] = 10;
+    clubData.club[0].bank_account = 1000000000;
+    clubData.club[1].player_index[0] = 20;
+    clubData.club[1].player_index[1] = 21;
+    clubData.club[1].player_index[2] = 22;
+    clubData.club[1].player_index[3] = 23;
+    roster_index::invalidate();
+    dirty_tracker::markAll();
+
+    auto near = similar_players::findSimilar(10, 3, 0);
+    if (near.size() != 3 || near[0].player != 20 || near[1].player != 23 || near[2].player != 22 ||
+        near[0].club != 1) {
+        std::cerr << "nearest players out of order\n";
+        return 1;
+    }
+
+    // A budget below the twin's price drops it but keeps the cheap, distant player.
+    clubData.club[0].bank_account = near[2].price - 1;
+    dirty_tracker::markClub(0);
+    for (const similar_players::Neighbour &neighbour : similar_players::findSimilar(10, 10, 0)) {
+        if (neighbour.price > clubData.club[0].bank_account || neighbour.player == 10) {
+            std::cerr << "unaffordable or own player offered\n";
+            return 1;
+        }
+    }
+    if (similar_players::findSimilar(10, 10, 0).back().player != 21) {
+        std::cerr << "cheap player missing\n";
+        return 1;
+    }
+    return 0;
+}
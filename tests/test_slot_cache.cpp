@@ -0,0 +1,67 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "slot_cache.h"
+
+namespace {
+void writeFilled(const std::filesystem::path &path, std::size_t size, char fill) {
+    std::ofstream out(path, std::ios::binary);
+    out << std::string(size, fill);
+}
+
+void writeSlot(const std::filesystem::path &saves, int gameNumber, char fill) {
+    std::string prefix = "GAME" + std::to_string(gameNumber);
+    writeFilled(saves / (prefix + "A"), sizeof(gamea), fill);
+    writeFilled(saves / (prefix + "B"), sizeof(gameb), fill);
+    writeFilled(saves / (prefix + "C"), sizeof(gamec), fill);
+}
+} // namespace
+
+int main() {
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "pm3000_test_slot_cache";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir / "SAVES");
+    writeFilled(dir / "pm3game.exe", 1, 'x');
+    writeSlot(dir / "SAVES", 1, '\x01');
+    writeSlot(dir / "SAVES", 3, '\x03');
+    writeFilled(dir / "SAVES" / "GAME3C", 10, '\x03'); // wrong size, never cached
+
+    io::SlotCache cache;
+    cache.watch(dir);
+    if (!cache.waitForScan(std::chrono::seconds(10))) {
+        std::cerr << "scan did not finish\n";
+        return 1;
+    }
+    auto first = cache.find(1);
+    if (!first || first->gameNumber != 1 || first->gameC.player[0].name[0] != '\x01' || cache.find(2) ||
+        cache.find(3)) {
+        std::cerr << "unexpected cached slots\n";
+        return 1;
+    }
+
+    // A rewritten slot is never served stale, and is picked up again by the next scan.
+    auto path = dir / "SAVES" / "GAME1C";
+    writeFilled(path, sizeof(gamec), '\x07');
+    std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(1));
+    if (cache.find(1)) {
+        std::cerr << "stale slot served\n";
+        return 1;
+    }
+    if (!cache.waitForScan(std::chrono::seconds(10))) {
+        std::cerr << "rescan did not finish\n";
+        return 1;
+    }
+    auto second = cache.find(1);
+    if (!second || second->gameC.player[0].name[0] != '\x07') {
+        std::cerr << "rewritten slot not reloaded\n";
+        return 1;
+    }
+
+    cache.stop();
+    io::invalidateInstallation();
+    std::filesystem::remove_all(dir);
+    return 0;
+}
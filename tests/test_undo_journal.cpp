@@ -0,0 +1,70 @@
+#include <iostream>
+
+#include "dirty_tracker.h"
+#include "pm3_data.h"
+#include "undo_journal.h"
+
+int main() {
+    undo_journal::reset();
+    dirty_tracker::clear();
+    if (undo_journal::canUndo() || undo_journal::undo()) {
+        std::cerr << "undo available after reset\n";
+        return 1;
+    }
+
+    // One step touching a player and a club keeps only the two pages they live on.
+    undo_journal::beginStep();
+    dirty_tracker::markPlayer(int16_t{5});
+    playerData.player[5].hn = 42;
+    dirty_tracker::markClub(1);
+    clubData.club[1].bank_account = 123456;
+    if (undo_journal::journalBytes() != 2 * undo_journal::kPageSize) {
+        std::cerr << "journal holds " << undo_journal::journalBytes() << " bytes, expected two pages\n";
+        return 1;
+    }
+
+    dirty_tracker::clear();
+    if (!undo_journal::undo() || playerData.player[5].hn != 0 || clubData.club[1].bank_account != 0) {
+        std::cerr << "undo did not restore the records\n";
+        return 1;
+    }
+    if (dirty_tracker::dirtyRanges('B').empty() || dirty_tracker::dirtyRanges('C').empty()) {
+        std::cerr << "undo did not mark the restored records dirty\n";
+        return 1;
+    }
+    if (undo_journal::canUndo() || !undo_journal::canRedo()) {
+        std::cerr << "unexpected history after undo\n";
+        return 1;
+    }
+
+    if (!undo_journal::redo() || playerData.player[5].hn != 42 || clubData.club[1].bank_account != 123456) {
+        std::cerr << "redo did not reapply the edit\n";
+        return 1;
+    }
+
+    // A fresh edit after an undo drops the redo history.
+    undo_journal::undo();
+    undo_journal::beginStep();
+    auto *gameBytes = reinterpret_cast<uint8_t *>(&gameData);
+    dirty_tracker::markGameData(gameBytes + 10, 1);
+    gameBytes[10] = 9;
+    if (undo_journal::canRedo() || !undo_journal::canUndo()) {
+        std::cerr << "new edit did not clear redo\n";
+        return 1;
+    }
+
+    // Steps that never write are not recorded, and the history is bounded.
+    for (std::size_t i = 0; i < undo_journal::kMaxSteps + 10; ++i) {
+        undo_journal::beginStep();
+        dirty_tracker::markPlayer(static_cast<int16_t>(i));
+    }
+    std::size_t steps = 0;
+    while (undo_journal::undo()) {
+        ++steps;
+    }
+    if (steps != undo_journal::kMaxSteps) {
+        std::cerr << "kept " << steps << " steps\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+
+#include "game_utils.h"
+#include "pm3_data.h"
+#include "valuation_report.h"
+
+namespace {
+bool sameValuations(const std::vector<valuation_report::PlayerValuation> &a,
+                    const std::vector<valuation_report::PlayerValuation> &b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].player != b[i].player || a[i].club != b[i].club || a[i].askingPrice != b[i].askingPrice) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+int main() {
+    auto clubs = std::make_unique<gameb>();
+    auto players = std::make_unique<gamec>();
+    std::memset(clubs.get(), 0, sizeof(gameb));
+    std::memset(players.get(), 0, sizeof(gamec));
+    std::mt19937 rng(77);
+    std::uniform_int_distribution<int> stat(10, 99);
+    for (PlayerRecord &player : players->player) {
+        player.hn = static_cast<uint8_t>(stat(rng));
+        player.tk = static_cast<uint8_t>(stat(rng));
+        player.ps = static_cast<uint8_t>(stat(rng));
+        player.sh = static_cast<uint8_t>(stat(rng));
+        player.hd = static_cast<uint8_t>(stat(rng));
+        player.cr = static_cast<uint8_t>(stat(rng));
+        player.age = static_cast<uint8_t>(17 + stat(rng) % 18);
+        player.contract = static_cast<uint8_t>(stat(rng) % 4);
+        player.wage = static_cast<uint16_t>(stat(rng) * 10);
+    }
+    std::strncpy(players->player[0].name, "COMMA,\"Q\"", sizeof(players->player[0].name));
+    for (int clubIdx = 0; clubIdx < kClubIdxMax; ++clubIdx) {
+        ClubRecord &club = clubs->club[clubIdx];
+        club.league = static_cast<uint8_t>(clubIdx / 23 < 5 ? clubIdx / 23 : 4);
+        for (int slot = 0; slot < 24; ++slot) {
+            club.player_index[slot] = slot < 18 && clubIdx < 114 ? static_cast<int16_t>(clubIdx * 18 + slot) : -1;
+        }
+    }
+
+    valuation_report::Dataset dataset{*clubs, *players};
+    valuation_report::Report single = valuation_report::build(dataset, {1, 5});
+    valuation_report::Report parallel = valuation_report::build(dataset, {8, 5});
+    if (!sameValuations(single.players, parallel.players) ||
+        !sameValuations(single.bestValueForRating, parallel.bestValueForRating) ||
+        toCsv(single, dataset) != toCsv(parallel, dataset)) {
+        std::cerr << "thread count changed the report\n";
+        return 1;
+    }
+
+    // The dataset version prices exactly like the live functions over the globals.
+    std::memcpy(&clubData, clubs.get(), sizeof(gameb));
+    std::memcpy(&playerData, players.get(), sizeof(gamec));
+    for (const valuation_report::PlayerValuation &valuation : single.players) {
+        const PlayerRecord &player = getPlayer(valuation.player);
+        const ClubRecord &club = getClub(valuation.club);
+        int price = determinePlayerPrice(player, club, valuation.slot);
+        int importance = std::max(determinePlayerImportance(player, club), 1);
+        int asking = static_cast<int>(price * (1.0 + (importance - 1) * 0.15));
+        if (player.contract == 0 || valuation.price != price || valuation.askingPrice != asking) {
+            std::cerr << "player " << valuation.player << " priced " << valuation.askingPrice << ", expected "
+                      << asking << "\n";
+            return 1;
+        }
+    }
+
+    for (const auto &division : single.topValueByDivision) {
+        if (division.size() != 5) {
+            std::cerr << "division top list has " << division.size() << " rows\n";
+            return 1;
+        }
+        for (std::size_t i = 1; i < division.size(); ++i) {
+            if (division[i].askingPrice > division[i - 1].askingPrice ||
+                division[i].division != division[0].division) {
+                std::cerr << "division top list out of order\n";
+                return 1;
+            }
+        }
+    }
+    const auto &best = single.bestValueForRating;
+    for (std::size_t i = 1; i < best.size(); ++i) {
+        if (static_cast<double>(best[i].askingPrice) / best[i].rating <
+            static_cast<double>(best[i - 1].askingPrice) / best[i - 1].rating) {
+            std::cerr << "value-for-rating list out of order\n";
+            return 1;
+        }
+    }
+    if (single.overpricedSquads.size() != 114 ||
+        single.overpricedSquads.front().overpricing < single.overpricedSquads.back().overpricing) {
+        std::cerr << "overpriced squads wrong\n";
+        return 1;
+    }
+
+    std::string csv = toCsv(single, dataset);
+    std::string json = toJson(single, dataset);
+    if (csv.rfind("report,rank,division,club,player,role,rating,price,asking_price,overpricing\n", 0) != 0 ||
+        json.find("\"overpriced_squads\": [") == std::string::npos ||
+        (csv.find("COMMA") != std::string::npos && csv.find("\"COMMA,\"\"Q\"\"\"") == std::string::npos) ||
+        (json.find("COMMA") != std::string::npos && json.find("COMMA,\\\"Q\\\"") == std::string::npos)) {
+        std::cerr << "unexpected report text\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,68 @@
+// Command-line helper to list and restore PM3000 backup generations.
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string>
+
+#include "io.h"
+
+namespace {
+
+struct Args {
+    std::string pm3Path;
+    bool list = false;
+    std::uint32_t restore = 0;
+};
+
+std::optional<Args> parseArgs(int argc, char **argv) {
+    Args args;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if ((a == "--pm3" || a == "-p") && i + 1 < argc) {
+            args.pm3Path = argv[++i];
+        } else if (a == "--list" || a == "-l") {
+            args.list = true;
+        } else if ((a == "--restore" || a == "-r") && i + 1 < argc) {
+            args.restore = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+    }
+
+    if (args.pm3Path.empty() || (args.list == (args.restore != 0))) {
+        return std::nullopt;
+    }
+    return args;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    auto parsed = parseArgs(argc, argv);
+    if (!parsed) {
+        std::cerr << "Usage: backup_tool --pm3 /path/to/PM3 (--list | --restore <generation>)\n";
+        return 1;
+    }
+    Args args = *parsed;
+
+    if (args.list) {
+        for (const auto &generation : io::backupStore(args.pm3Path).generations()) {
+            std::time_t time = static_cast<std::time_t>(generation.time);
+            char when[32] = "";
+            std::strftime(when, sizeof(when), "%Y-%m-%d %H:%M:%S", std::localtime(&time));
+            std::cout << generation.id << "  " << when << "  " << generation.label;
+            for (const auto &file : generation.files) {
+                std::cout << "  " << file.name;
+            }
+            std::cout << "\n";
+        }
+        return 0;
+    }
+
+    if (!io::restoreBackup(args.pm3Path, args.restore)) {
+        std::cerr << "Restore failed: " << io::pm3LastError() << "\n";
+        return 1;
+    }
+    std::cout << "Restored backup " << args.restore << "\n";
+    return 0;
+}
@@ -0,0 +1,74 @@
+// Command-line helper to export a save slot to a .pm3bundle file and import one into a slot.
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string>
+
+#include "io.h"
+
+namespace {
+
+struct Args {
+    std::string pm3Path;
+    std::string bundlePath;
+    int gameNumber = 0;
+    bool exporting = false;
+    bool importing = false;
+    bool compress = true;
+};
+
+std::optional<Args> parseArgs(int argc, char **argv) {
+    Args args;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if ((a == "--pm3" || a == "-p") && i + 1 < argc) {
+            args.pm3Path = argv[++i];
+        } else if ((a == "--game" || a == "-g") && i + 1 < argc) {
+            args.gameNumber = std::atoi(argv[++i]);
+        } else if ((a == "--export" || a == "-e") && i + 1 < argc) {
+            args.exporting = true;
+            args.bundlePath = argv[++i];
+        } else if ((a == "--import" || a == "-i") && i + 1 < argc) {
+            args.importing = true;
+            args.bundlePath = argv[++i];
+        } else if (a == "--raw") {
+            args.compress = false;
+        }
+    }
+
+    if (args.pm3Path.empty() || args.gameNumber < 1 || args.gameNumber > 8 || args.exporting == args.importing) {
+        return std::nullopt;
+    }
+    return args;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    auto parsed = parseArgs(argc, argv);
+    if (!parsed) {
+        std::cerr << "Usage: bundle_tool --pm3 /path/to/PM3 --game <1-8> "
+                     "(--export <file.pm3bundle> [--raw] | --import <file.pm3bundle>)\n";
+        return 1;
+    }
+    Args args = *parsed;
+
+    Settings settings;
+    settings.gamePath = args.pm3Path;
+    if (args.exporting) {
+        if (!io::exportBundle(settings, args.gameNumber, args.bundlePath, args.compress)) {
+            std::cerr << "Export failed: " << io::pm3LastError() << "\n";
+            return 1;
+        }
+        std::cout << "Exported save game " << args.gameNumber << " to " << args.bundlePath << "\n";
+        return 0;
+    }
+
+    if (!io::importBundle(settings, args.bundlePath, args.gameNumber)) {
+        std::cerr << "Import failed: " << io::pm3LastError() << "\n";
+        return 1;
+    }
+    std::cout << "Imported " << args.bundlePath << " into save game " << args.gameNumber << "\n";
+    return 0;
+}
@@ -0,0 +1,131 @@
+// Benchmark for csv_reader: builds an FC-style CSV in memory, times the structural scan alone and
+// then reading every field of every row, reporting MB/s for both. Exits non-zero when the full
+// read is below the minimum throughput, when one is given.
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "csv_reader.h"
+
+namespace {
+
+constexpr int kColumns = 110;
+
+// Mostly small numbers, with the quoted names, position lists and URLs of a real export.
+std::string syntheticCsv(std::size_t bytes) {
+    std::string text;
+    text.reserve(bytes + 4096);
+    for (int c = 0; c < kColumns; ++c) {
+        text += (c == 0 ? "" : ",") + std::string("column_") + std::to_string(c);
+    }
+    text += '\n';
+
+    std::mt19937 rng(2026);
+    std::uniform_int_distribution<int> stat(20, 99);
+    for (int id = 1; text.size() < bytes; ++id) {
+        text += std::to_string(id) + ",\"https://example.com/player/" + std::to_string(id) + "/?a=1,b=2\"";
+        text += ",J. Smith,\"Long \"\"Nickname\"\" Name, Jr.\",\"ST, LW\",Right,Some Club FC";
+        for (int c = 7; c < kColumns; ++c) {
+            text += ',';
+            text += std::to_string(stat(rng));
+        }
+        text += '\n';
+    }
+    return text;
+}
+
+bool parseKernel(const std::string &name, csv_reader::Kernel &kernel) {
+    if (name == "scalar") {
+        kernel = csv_reader::Kernel::Scalar;
+    } else if (name == "sse2") {
+        kernel = csv_reader::Kernel::Sse2;
+    } else if (name == "avx2") {
+        kernel = csv_reader::Kernel::Avx2;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+double mbPerSecond(std::size_t bytes, std::chrono::steady_clock::time_point start) {
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(bytes) / (1 << 20) / seconds;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    std::size_t megabytes = 1024;
+    unsigned threads = 0;
+    csv_reader::Kernel kernel = csv_reader::bestKernel();
+    double minimumMbPerSecond = 0.0;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--megabytes" && i + 1 < argc) {
+            megabytes = std::strtoul(argv[++i], nullptr, 10);
+        } else if ((a == "--threads" || a == "-t") && i + 1 < argc) {
+            threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (a == "--minimum" && i + 1 < argc) {
+            minimumMbPerSecond = std::atof(argv[++i]);
+        } else if (a == "--kernel" && i + 1 < argc && parseKernel(argv[i + 1], kernel)) {
+            ++i;
+        } else {
+            std::cerr << "Usage: csv_reader_bench [--megabytes <n>] [--threads <n>] [--kernel scalar|sse2|avx2] "
+                         "[--minimum <MB/s>]\n";
+            return 1;
+        }
+    }
+    if (!csv_reader::kernelSupported(kernel)) {
+        std::cerr << "This CPU does not support the requested kernel\n";
+        return 1;
+    }
+
+    std::string text = syntheticCsv(megabytes << 20);
+    auto chunks = csv_reader::splitChunks(text, 64);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::size_t> structural(chunks.size());
+    csv_reader::forEachChunk(chunks, threads, [&](std::size_t index, std::string_view chunk) {
+        std::vector<std::uint32_t> offsets;
+        bool inQuotes = false;
+        for (std::size_t at = 0; at < chunk.size(); at += 64 * 1024) {
+            csv_reader::scanStructure(chunk.substr(at, 64 * 1024), inQuotes, offsets, kernel);
+            structural[index] += offsets.size();
+        }
+    });
+    double scanMbPerSecond = mbPerSecond(text.size(), start);
+
+    start = std::chrono::steady_clock::now();
+    std::vector<std::size_t> fieldBytes(chunks.size());
+    csv_reader::forEachChunk(chunks, threads, [&](std::size_t index, std::string_view chunk) {
+        csv_reader::RowReader reader(chunk, kernel);
+        csv_reader::Row row;
+        std::string scratch;
+        std::size_t total = 0;
+        while (reader.next(row)) {
+            for (std::size_t f = 0; f < row.size(); ++f) {
+                total += row.field(f, scratch).size();
+            }
+        }
+        fieldBytes[index] = total;
+    });
+
+    double readMbPerSecond = mbPerSecond(text.size(), start);
+    std::size_t characters = 0;
+    std::size_t total = 0;
+    for (std::size_t index = 0; index < chunks.size(); ++index) {
+        characters += structural[index];
+        total += fieldBytes[index];
+    }
+    std::cout << text.size() / (1 << 20) << " MB: scan " << scanMbPerSecond << " MB/s (" << characters
+              << " structural characters), read " << readMbPerSecond << " MB/s (" << total << " field bytes)\n";
+    if (readMbPerSecond < minimumMbPerSecond) {
+        std::cerr << "Below the minimum of " << minimumMbPerSecond << " MB/s\n";
+        return 1;
+    }
+    return 0;
+}
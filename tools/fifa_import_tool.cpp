@@ -1,6 +1,7 @@
 // Command-line helper to import FC (FIFA-style) player CSV data into PM3 playdata.
 #include <algorithm>
 #include <cctype>
+#include <charconv>
 #include <cstddef>
 #include <cstdlib>
 #include <filesystem>
@@ -16,11 +17,16 @@
 #include <numeric>
 #include <random>
 #include <system_error>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 #include <array>
 
+#include "column_cache.h"
+#include "csv_reader.h"
+#include "import_manifest.h"
 #include "io.h"
+#include "save_view.h"
 #include "pm3_defs.hh"
 
 namespace {
@@ -39,6 +45,9 @@ struct Args {
     int debugPlayerId = 0;
     bool importLoans = false;
     std::string droppedClubsPath;
+    unsigned threads = 0;
+    bool useCache = true;
+    bool update = false;
 };
 
 std::optional<Args> parseArgs(int argc, char **argv) {
@@ -67,6 +76,12 @@ std::optional<Args> parseArgs(int argc, char **argv) {
             args.importLoans = true;
         } else if (a == "--dropped-clubs" && i + 1 < argc) {
             args.droppedClubsPath = argv[++i];
+        } else if ((a == "--threads" || a == "-t") && i + 1 < argc) {
+            args.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (a == "--no-cache") {
+            args.useCache = false;
+        } else if (a == "--update") {
+            args.update = true;
         }
     }
 
@@ -76,60 +91,34 @@ std::optional<Args> parseArgs(int argc, char **argv) {
     if (!args.baseData && (args.gameNumber < 1 || args.gameNumber > 8)) {
         return std::nullopt;
     }
+    if (args.update && args.playerId > 0) {
+        return std::nullopt;
+    }
     return args;
 }
 
-// Minimal CSV splitter that respects quoted fields.
-std::vector<std::string> splitCsv(const std::string &line) {
-    std::vector<std::string> fields;
-    std::string current;
-    bool inQuotes = false;
-    for (size_t i = 0; i < line.size(); ++i) {
-        char c = line[i];
-        if (inQuotes) {
-            if (c == '"') {
-                if (i + 1 < line.size() && line[i + 1] == '"') {
-                    current.push_back('"');
-                    ++i;
-                } else {
-                    inQuotes = false;
-                }
-            } else {
-                current.push_back(c);
-            }
-        } else {
-            if (c == '"') {
-                inQuotes = true;
-            } else if (c == ',') {
-                fields.push_back(current);
-                current.clear();
-            } else {
-                current.push_back(c);
-            }
-        }
+// Kept beside the data it describes: GAMEn.FCIMPORT in the saves folder, or PM3000.FCIMPORT in
+// the PM3 folder for the default data.
+std::filesystem::path importManifestPath(const Args &args) {
+    constexpr const char *kImportManifestSuffix = ".FCIMPORT";
+    if (args.baseData) {
+        return std::filesystem::path(args.pm3Path) / (std::string("PM3000") + kImportManifestSuffix);
     }
-    fields.push_back(current);
-    return fields;
+    return io::constructSavesFolderPath(args.pm3Path) /
+           (std::string{kGameFilePrefix} + std::to_string(args.gameNumber) + kImportManifestSuffix);
 }
 
-int parseNumber(const std::string &field) {
-    std::string digits;
-    digits.reserve(field.size());
-    for (char c : field) {
-        if (std::isdigit(static_cast<unsigned char>(c)) || (c == '-' && digits.empty())) {
-            digits.push_back(c);
-        } else if (!digits.empty()) {
-            break; // stop at the first non-digit once we've started capturing
-        }
-    }
-    if (digits.empty() || digits == "-") {
-        return 0;
-    }
-    try {
-        return std::stoi(digits);
-    } catch (...) {
-        return 0;
-    }
+// The first integer in the field, or 0 when there is none or it does not fit an int. Reads the
+// field in place: no digit string, no std::stoi.
+int parseNumber(std::string_view field) {
+    const char *first = field.data();
+    const char *last = field.data() + field.size();
+    while (first != last && *first != '-' && !std::isdigit(static_cast<unsigned char>(*first))) {
+        ++first;
+    }
+    int value = 0;
+    std::from_chars(first, last, value); // leaves value at 0 on a lone '-' or an overflow
+    return value;
 }
 
 uint8_t clampByte(int v) {
@@ -146,7 +135,7 @@ uint8_t scaleToTen(int stat) {
     return static_cast<uint8_t>(scaled);
 }
 
-std::string sanitizeName(const std::string &raw) {
+std::string sanitizeName(std::string_view raw) {
     std::string out;
     out.reserve(raw.size());
     bool lastSpace = false;
@@ -201,29 +190,130 @@ void writeFixed(char *dest, size_t destSize, const std::string &value) {
     }
 }
 
-struct ColumnMap {
-    std::unordered_map<std::string, size_t> index;
+// The columns the importer reads. Their indices are looked up once, from the header.
+enum class Col : size_t {
+    PlayerId,
+    ShortName,
+    Overall,
+    PlayerPositions,
+    Age,
+    PreferredFoot,
+    ClubName,
+    ClubLoanedFrom,
+    LeagueName,
+    LeagueLevel,
+    LeagueId,
+    Pace,
+    Shooting,
+    Passing,
+    Dribbling,
+    Defending,
+    Physic,
+    AttackingHeadingAccuracy,
+    SkillBallControl,
+    MentalityAggression,
+    MentalityComposure,
+    GoalkeepingDiving,
+    GoalkeepingHandling,
+    GoalkeepingKicking,
+    GoalkeepingPositioning,
+    GoalkeepingReflexes,
+    GoalkeepingSpeed,
+    AttackingCrossing,
+    AttackingFinishing,
+    AttackingShortPassing,
+    AttackingVolleys,
+    SkillDribbling,
+    SkillCurve,
+    SkillFkAccuracy,
+    SkillLongPassing,
+    MovementAcceleration,
+    MovementSprintSpeed,
+    MovementAgility,
+    MovementReactions,
+    MovementBalance,
+    PowerShotPower,
+    PowerJumping,
+    PowerStamina,
+    PowerStrength,
+    PowerLongShots,
+    MentalityInterceptions,
+    MentalityPositioning,
+    MentalityVision,
+    MentalityPenalties,
+    DefendingMarkingAwareness,
+    DefendingStandingTackle,
+    DefendingSlidingTackle,
+    WageEur,
+    ClubContractValidUntilYear,
+    Count
 };
 
-ColumnMap buildColumnMap(const std::vector<std::string> &headers) {
-    ColumnMap map;
-    for (size_t i = 0; i < headers.size(); ++i) {
-        map.index[headers[i]] = i;
-    }
-    return map;
-}
+const std::vector<std::string_view> kColumnNames = {
+        "player_id",
+        "short_name",
+        "overall",
+        "player_positions",
+        "age",
+        "preferred_foot",
+        "club_name",
+        "club_loaned_from",
+        "league_name",
+        "league_level",
+        "league_id",
+        "pace",
+        "shooting",
+        "passing",
+        "dribbling",
+        "defending",
+        "physic",
+        "attacking_heading_accuracy",
+        "skill_ball_control",
+        "mentality_aggression",
+        "mentality_composure",
+        "goalkeeping_diving",
+        "goalkeeping_handling",
+        "goalkeeping_kicking",
+        "goalkeeping_positioning",
+        "goalkeeping_reflexes",
+        "goalkeeping_speed",
+        "attacking_crossing",
+        "attacking_finishing",
+        "attacking_short_passing",
+        "attacking_volleys",
+        "skill_dribbling",
+        "skill_curve",
+        "skill_fk_accuracy",
+        "skill_long_passing",
+        "movement_acceleration",
+        "movement_sprint_speed",
+        "movement_agility",
+        "movement_reactions",
+        "movement_balance",
+        "power_shot_power",
+        "power_jumping",
+        "power_stamina",
+        "power_strength",
+        "power_long_shots",
+        "mentality_interceptions",
+        "mentality_positioning",
+        "mentality_vision",
+        "mentality_penalties",
+        "defending_marking_awareness",
+        "defending_standing_tackle",
+        "defending_sliding_tackle",
+        "wage_eur",
+        "club_contract_valid_until_year",
+};
 
-const std::string &getField(const ColumnMap &map, const std::vector<std::string> &row, const std::string &key) {
-    static const std::string kEmpty;
-    auto it = map.index.find(key);
-    if (it == map.index.end()) {
-        return kEmpty;
-    }
-    size_t idx = it->second;
-    if (idx >= row.size()) {
-        return kEmpty;
+bool isEnglishLeague(int leagueId) {
+    static const std::array<int, 4> kEnglishLeagueIds = {13, 14, 60, 61}; // EPL + EFL tiers
+    for (int id : kEnglishLeagueIds) {
+        if (leagueId == id) {
+            return true;
+        }
     }
-    return row[idx];
+    return false;
 }
 
 struct FifaRow {
@@ -283,70 +373,124 @@ struct FifaRow {
     int contractYear = 0;
 };
 
-std::optional<FifaRow> parseFifaRow(const ColumnMap &cols, const std::vector<std::string> &row) {
+// The integer columns past the filter, each with the FifaRow member it fills.
+struct NumberColumn {
+    Col column;
+    int FifaRow::*member;
+};
+
+const std::vector<NumberColumn> kNumberColumns = {
+        {Col::LeagueLevel, &FifaRow::leagueLevel},
+        {Col::Overall, &FifaRow::overall},
+        {Col::Age, &FifaRow::age},
+        {Col::Pace, &FifaRow::pace},
+        {Col::Shooting, &FifaRow::shooting},
+        {Col::Passing, &FifaRow::passing},
+        {Col::Dribbling, &FifaRow::dribbling},
+        {Col::Defending, &FifaRow::defending},
+        {Col::Physic, &FifaRow::physic},
+        {Col::AttackingHeadingAccuracy, &FifaRow::heading},
+        {Col::SkillBallControl, &FifaRow::ballControl},
+        {Col::AttackingCrossing, &FifaRow::attackingCrossing},
+        {Col::AttackingFinishing, &FifaRow::attackingFinishing},
+        {Col::AttackingShortPassing, &FifaRow::attackingShortPassing},
+        {Col::AttackingVolleys, &FifaRow::attackingVolleys},
+        {Col::SkillDribbling, &FifaRow::skillDribbling},
+        {Col::SkillCurve, &FifaRow::skillCurve},
+        {Col::SkillFkAccuracy, &FifaRow::skillFkAccuracy},
+        {Col::SkillLongPassing, &FifaRow::skillLongPassing},
+        {Col::MovementAcceleration, &FifaRow::movementAcceleration},
+        {Col::MovementSprintSpeed, &FifaRow::movementSprintSpeed},
+        {Col::MovementAgility, &FifaRow::movementAgility},
+        {Col::MovementReactions, &FifaRow::movementReactions},
+        {Col::MovementBalance, &FifaRow::movementBalance},
+        {Col::PowerShotPower, &FifaRow::powerShotPower},
+        {Col::PowerJumping, &FifaRow::powerJumping},
+        {Col::PowerStamina, &FifaRow::powerStamina},
+        {Col::PowerStrength, &FifaRow::powerStrength},
+        {Col::PowerLongShots, &FifaRow::powerLongShots},
+        {Col::MentalityInterceptions, &FifaRow::mentalityInterceptions},
+        {Col::MentalityPositioning, &FifaRow::mentalityPositioning},
+        {Col::MentalityVision, &FifaRow::mentalityVision},
+        {Col::MentalityPenalties, &FifaRow::mentalityPenalties},
+        {Col::DefendingMarkingAwareness, &FifaRow::defendingMarking},
+        {Col::DefendingStandingTackle, &FifaRow::defendingStandingTackle},
+        {Col::DefendingSlidingTackle, &FifaRow::defendingSlidingTackle},
+        {Col::MentalityAggression, &FifaRow::aggression},
+        {Col::MentalityComposure, &FifaRow::composure},
+        {Col::GoalkeepingDiving, &FifaRow::gkDiving},
+        {Col::GoalkeepingHandling, &FifaRow::gkHandling},
+        {Col::GoalkeepingKicking, &FifaRow::gkKicking},
+        {Col::GoalkeepingPositioning, &FifaRow::gkPositioning},
+        {Col::GoalkeepingReflexes, &FifaRow::gkReflexes},
+        {Col::GoalkeepingSpeed, &FifaRow::gkSpeed},
+        {Col::WageEur, &FifaRow::wageEur},
+        {Col::ClubContractValidUntilYear, &FifaRow::contractYear},
+};
+
+// Column indices resolved once from the header, in the order a row is decoded: the filter columns
+// first, then the integers straight into FifaRow, then the text columns.
+struct ParsePlan {
+    size_t leagueId = csv_reader::kMissingColumn;
+    size_t playerId = csv_reader::kMissingColumn;
+    std::vector<std::pair<size_t, int FifaRow::*>> numbers;
+    std::vector<size_t> columns; // by Col
+};
+
+ParsePlan compileParsePlan(const csv_reader::Row &header) {
+    ParsePlan plan;
+    plan.columns = csv_reader::resolveColumns(header, kColumnNames);
+    for (size_t i = 0; i < plan.columns.size(); ++i) {
+        if (plan.columns[i] == csv_reader::kMissingColumn) {
+            throw std::runtime_error("CSV missing required column: " + std::string(kColumnNames[i]));
+        }
+    }
+    plan.leagueId = plan.columns[static_cast<size_t>(Col::LeagueId)];
+    plan.playerId = plan.columns[static_cast<size_t>(Col::PlayerId)];
+    for (const NumberColumn &number : kNumberColumns) {
+        plan.numbers.emplace_back(plan.columns[static_cast<size_t>(number.column)], number.member);
+    }
+    return plan;
+}
+
+// Rows outside the English leagues (or other than filterPlayerId, when set) are rejected after
+// decoding two fields, which is most of a worldwide export.
+std::optional<FifaRow> parseFifaRow(const ParsePlan &plan, const csv_reader::Row &row, int filterPlayerId,
+                                    std::string &scratch) {
+    int leagueId = parseNumber(row.field(plan.leagueId, scratch));
+    if (!isEnglishLeague(leagueId)) {
+        return std::nullopt;
+    }
+    int playerId = parseNumber(row.field(plan.playerId, scratch));
+    if (filterPlayerId > 0 && playerId != filterPlayerId) {
+        return std::nullopt;
+    }
+
     FifaRow out;
-    out.name = sanitizeName(getField(cols, row, "short_name"));
-    out.playerId = parseNumber(getField(cols, row, "player_id"));
-    out.clubName = sanitizeName(getField(cols, row, "club_name"));
-    out.clubLoanedFrom = sanitizeName(getField(cols, row, "club_loaned_from"));
-    out.leagueName = sanitizeName(getField(cols, row, "league_name"));
-    out.leagueLevel = parseNumber(getField(cols, row, "league_level"));
-    out.leagueId = parseNumber(getField(cols, row, "league_id"));
-    out.positions = getField(cols, row, "player_positions");
-    out.overall = parseNumber(getField(cols, row, "overall"));
-    out.age = parseNumber(getField(cols, row, "age"));
-    std::string foot = getField(cols, row, "preferred_foot");
+    out.leagueId = leagueId;
+    out.playerId = playerId;
+    for (const auto &[column, member] : plan.numbers) {
+        out.*member = parseNumber(row.field(column, scratch));
+    }
+    if (out.overall <= 0) {
+        return std::nullopt;
+    }
+
+    // The view points into the row or into scratch, so each field is used before the next is read.
+    auto field = [&](Col column) { return row.field(plan.columns[static_cast<size_t>(column)], scratch); };
+    out.name = sanitizeName(field(Col::ShortName));
+    if (out.name.empty()) {
+        return std::nullopt;
+    }
+    out.clubName = sanitizeName(field(Col::ClubName));
+    out.clubLoanedFrom = sanitizeName(field(Col::ClubLoanedFrom));
+    out.leagueName = sanitizeName(field(Col::LeagueName));
+    out.positions = std::string(field(Col::PlayerPositions));
+    std::string_view foot = field(Col::PreferredFoot);
     if (foot == "Left") out.preferredFoot = 0;
     else if (foot == "Right") out.preferredFoot = 1;
     else if (foot == "Both") out.preferredFoot = 2;
 
-    out.pace = parseNumber(getField(cols, row, "pace"));
-    out.shooting = parseNumber(getField(cols, row, "shooting"));
-    out.passing = parseNumber(getField(cols, row, "passing"));
-    out.dribbling = parseNumber(getField(cols, row, "dribbling"));
-    out.defending = parseNumber(getField(cols, row, "defending"));
-    out.physic = parseNumber(getField(cols, row, "physic"));
-    out.heading = parseNumber(getField(cols, row, "attacking_heading_accuracy"));
-    out.ballControl = parseNumber(getField(cols, row, "skill_ball_control"));
-    out.attackingCrossing = parseNumber(getField(cols, row, "attacking_crossing"));
-    out.attackingFinishing = parseNumber(getField(cols, row, "attacking_finishing"));
-    out.attackingShortPassing = parseNumber(getField(cols, row, "attacking_short_passing"));
-    out.attackingVolleys = parseNumber(getField(cols, row, "attacking_volleys"));
-    out.skillDribbling = parseNumber(getField(cols, row, "skill_dribbling"));
-    out.skillCurve = parseNumber(getField(cols, row, "skill_curve"));
-    out.skillFkAccuracy = parseNumber(getField(cols, row, "skill_fk_accuracy"));
-    out.skillLongPassing = parseNumber(getField(cols, row, "skill_long_passing"));
-    out.movementAcceleration = parseNumber(getField(cols, row, "movement_acceleration"));
-    out.movementSprintSpeed = parseNumber(getField(cols, row, "movement_sprint_speed"));
-    out.movementAgility = parseNumber(getField(cols, row, "movement_agility"));
-    out.movementReactions = parseNumber(getField(cols, row, "movement_reactions"));
-    out.movementBalance = parseNumber(getField(cols, row, "movement_balance"));
-    out.powerShotPower = parseNumber(getField(cols, row, "power_shot_power"));
-    out.powerJumping = parseNumber(getField(cols, row, "power_jumping"));
-    out.powerStamina = parseNumber(getField(cols, row, "power_stamina"));
-    out.powerStrength = parseNumber(getField(cols, row, "power_strength"));
-    out.powerLongShots = parseNumber(getField(cols, row, "power_long_shots"));
-    out.mentalityInterceptions = parseNumber(getField(cols, row, "mentality_interceptions"));
-    out.mentalityPositioning = parseNumber(getField(cols, row, "mentality_positioning"));
-    out.mentalityVision = parseNumber(getField(cols, row, "mentality_vision"));
-    out.mentalityPenalties = parseNumber(getField(cols, row, "mentality_penalties"));
-    out.defendingMarking = parseNumber(getField(cols, row, "defending_marking_awareness"));
-    out.defendingStandingTackle = parseNumber(getField(cols, row, "defending_standing_tackle"));
-    out.defendingSlidingTackle = parseNumber(getField(cols, row, "defending_sliding_tackle"));
-    out.aggression = parseNumber(getField(cols, row, "mentality_aggression"));
-    out.composure = parseNumber(getField(cols, row, "mentality_composure"));
-    out.gkDiving = parseNumber(getField(cols, row, "goalkeeping_diving"));
-    out.gkHandling = parseNumber(getField(cols, row, "goalkeeping_handling"));
-    out.gkKicking = parseNumber(getField(cols, row, "goalkeeping_kicking"));
-    out.gkPositioning = parseNumber(getField(cols, row, "goalkeeping_positioning"));
-    out.gkReflexes = parseNumber(getField(cols, row, "goalkeeping_reflexes"));
-    out.gkSpeed = parseNumber(getField(cols, row, "goalkeeping_speed"));
-    out.wageEur = parseNumber(getField(cols, row, "wage_eur"));
-    out.contractYear = parseNumber(getField(cols, row, "club_contract_valid_until_year"));
-
-    if (out.name.empty() || out.overall <= 0) {
-        return std::nullopt;
-    }
     return out;
 }
 
@@ -893,16 +1037,6 @@ std::vector<std::string> buildGeneratedNamePool() {
     return kLastNames;
 }
 
-bool isEnglishLeague(int leagueId) {
-    static const std::array<int, 4> kEnglishLeagueIds = {13, 14, 60, 61}; // EPL + EFL tiers
-    for (int id : kEnglishLeagueIds) {
-        if (leagueId == id) {
-            return true;
-        }
-    }
-    return false;
-}
-
 std::string clubSortKey(const ClubRecord &club) {
     std::string key(club.name, strnlen(club.name, sizeof(club.name)));
     for (char &c : key) {
@@ -1050,109 +1184,185 @@ void writeLeagueSlots(gamea &gd, const std::array<std::vector<int>, 5> &tiers) {
 //    return dropped;
 //}
 
-ImportStats importCsvToPlayers(const std::string &csvPath, int baseYear, bool verbose,
-                               int filterPlayerId, int debugPlayerId, bool importLoans,
-                               gamea &gameDataOut, gameb &clubDataOut, gamec &playerOut,
-                               std::vector<int> *droppedClubsOut) {
-    std::ifstream in(csvPath);
-    if (!in) {
-        throw std::runtime_error("Failed to open CSV file: " + csvPath);
+// Bump when FifaRow, the parse plan or the row filter changes, so older snapshots stop matching.
+constexpr const char *kCacheVersion = "fifa_import_tool rows 1";
+
+// The FifaRow members a parse cache stores, as integer and text columns.
+const std::vector<int FifaRow::*> kCachedNumbers = [] {
+    std::vector<int FifaRow::*> members = {&FifaRow::leagueId, &FifaRow::playerId, &FifaRow::preferredFoot};
+    for (const NumberColumn &number : kNumberColumns) {
+        members.push_back(number.member);
     }
+    return members;
+}();
+const std::vector<std::string FifaRow::*> kCachedTexts = {
+        &FifaRow::name, &FifaRow::clubName, &FifaRow::clubLoanedFrom, &FifaRow::leagueName, &FifaRow::positions,
+};
 
-    std::string headerLine;
-    if (!std::getline(in, headerLine)) {
-        throw std::runtime_error("CSV file is empty: " + csvPath);
+column_cache::Key parseCacheKey(std::string_view text) {
+    std::string schema = kCacheVersion;
+    for (std::string_view name : kColumnNames) {
+        schema += ',';
+        schema += name;
     }
+    return column_cache::makeKey(text, schema);
+}
 
-    auto headers = splitCsv(headerLine);
-    ColumnMap colMap = buildColumnMap(headers);
-    const std::vector<std::string> requiredColumns = {
-            "player_id",
-            "short_name",
-            "overall",
-            "player_positions",
-            "age",
-            "preferred_foot",
-            "club_name",
-            "club_loaned_from",
-            "league_name",
-            "league_level",
-            "league_id",
-            "pace",
-            "shooting",
-            "passing",
-            "dribbling",
-            "defending",
-            "physic",
-            "attacking_heading_accuracy",
-            "skill_ball_control",
-            "mentality_aggression",
-            "mentality_composure",
-            "goalkeeping_diving",
-            "goalkeeping_handling",
-            "goalkeeping_kicking",
-            "goalkeeping_positioning",
-            "goalkeeping_reflexes",
-            "goalkeeping_speed",
-            "attacking_crossing",
-            "attacking_finishing",
-            "attacking_short_passing",
-            "attacking_volleys",
-            "skill_dribbling",
-            "skill_curve",
-            "skill_fk_accuracy",
-            "skill_long_passing",
-            "movement_acceleration",
-            "movement_sprint_speed",
-            "movement_agility",
-            "movement_reactions",
-            "movement_balance",
-            "power_shot_power",
-            "power_jumping",
-            "power_stamina",
-            "power_strength",
-            "power_long_shots",
-            "mentality_interceptions",
-            "mentality_positioning",
-            "mentality_vision",
-            "mentality_penalties",
-            "defending_marking_awareness",
-            "defending_standing_tackle",
-            "defending_sliding_tackle",
-            "wage_eur",
-            "club_contract_valid_until_year"
-    };
-    for (const auto &key : requiredColumns) {
-        if (!colMap.index.count(key)) {
-            throw std::runtime_error("CSV missing required column: " + key);
+// The rows a previous run kept from this exact file, read from its snapshot.
+bool loadCachedRows(const std::filesystem::path &path, const column_cache::Key &key, std::vector<FifaRow> &rows,
+                    ImportStats &stats) {
+    column_cache::Snapshot snapshot;
+    if (!snapshot.open(path, key, kCachedNumbers.size(), kCachedTexts.size(), 2)) {
+        return false;
+    }
+    rows.assign(snapshot.rows(), FifaRow{});
+    for (size_t column = 0; column < kCachedNumbers.size(); ++column) {
+        for (size_t row = 0; row < rows.size(); ++row) {
+            rows[row].*kCachedNumbers[column] = snapshot.number(column, row);
         }
     }
+    for (size_t column = 0; column < kCachedTexts.size(); ++column) {
+        for (size_t row = 0; row < rows.size(); ++row) {
+            rows[row].*kCachedTexts[column] = std::string(snapshot.text(column, row));
+        }
+    }
+    stats.parsed = static_cast<size_t>(snapshot.count(0));
+    stats.skipped = static_cast<size_t>(snapshot.count(1));
+    return true;
+}
 
-    std::map<std::string, size_t> bucketIndex;
-    std::vector<ClubBucket> buckets;
-    ImportStats stats;
-
-    std::string line;
-    while (std::getline(in, line)) {
-        if (line.empty()) {
-            continue;
+bool saveCachedRows(const std::filesystem::path &path, const column_cache::Key &key,
+                    const std::vector<FifaRow> &rows, const ImportStats &stats) {
+    column_cache::Table table;
+    table.rows = rows.size();
+    for (int FifaRow::*member : kCachedNumbers) {
+        auto &column = table.numbers.emplace_back();
+        column.reserve(rows.size());
+        for (const FifaRow &row : rows) {
+            column.push_back(row.*member);
         }
-        auto fields = splitCsv(line);
-        ++stats.parsed;
-        auto parsedRow = parseFifaRow(colMap, fields);
-        if (!parsedRow) {
-            ++stats.skipped;
-            continue;
+    }
+    for (std::string FifaRow::*member : kCachedTexts) {
+        auto &column = table.texts.emplace_back();
+        column.reserve(rows.size());
+        for (const FifaRow &row : rows) {
+            column.push_back(row.*member);
         }
-        if (filterPlayerId > 0 && parsedRow->playerId != filterPlayerId) {
-            ++stats.skipped;
-            continue;
+    }
+    table.counts = {static_cast<std::uint64_t>(stats.parsed), static_cast<std::uint64_t>(stats.skipped)};
+    return column_cache::write(path, key, table);
+}
+
+// Hash of the columns that end up in a PlayerRecord. The club and league columns are left out, so a
+// transfer on its own does not count as new attributes.
+uint64_t rowHash(const FifaRow &row) {
+    std::string bytes;
+    for (int FifaRow::*member : kCachedNumbers) {
+        if (member != &FifaRow::leagueId && member != &FifaRow::leagueLevel) {
+            int value = row.*member;
+            bytes.append(reinterpret_cast<const char *>(&value), sizeof(value));
         }
-        if (!isEnglishLeague(parsedRow->leagueId)) {
-            ++stats.skipped;
-            continue;
+    }
+    for (const std::string *text : {&row.name, &row.positions, &row.clubLoanedFrom}) {
+        bytes += *text;
+        bytes += '\0';
+    }
+    return column_cache::makeKey(bytes, kCacheVersion).low;
+}
+
+// The rows of the English leagues (or just filterPlayerId), in file order.
+std::vector<FifaRow> parseCsvRows(std::string_view text, const std::string &csvPath, int filterPlayerId,
+                                  unsigned threads, ImportStats &stats) {
+    csv_reader::RowReader headerReader(text);
+    csv_reader::Row header;
+    if (!headerReader.next(header)) {
+        throw std::runtime_error("CSV file is empty: " + csvPath);
+    }
+    ParsePlan plan = compileParsePlan(header);
+
+    // Rows are parsed and filtered per chunk on several threads; clubs are bucketed afterwards in
+    // file order, so the result is the same as a single pass.
+    unsigned workers = threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+    auto chunks = csv_reader::splitChunks(text.substr(headerReader.offset()), workers * 4);
+    std::vector<std::vector<FifaRow>> chunkRows(chunks.size());
+    std::vector<ImportStats> chunkStats(chunks.size());
+    csv_reader::forEachChunk(chunks, workers, [&](size_t index, std::string_view chunk) {
+        csv_reader::RowReader reader(chunk);
+        csv_reader::Row row;
+        std::string scratch;
+        ImportStats &chunkStat = chunkStats[index];
+        while (reader.next(row)) {
+            ++chunkStat.parsed;
+            auto parsedRow = parseFifaRow(plan, row, filterPlayerId, scratch);
+            if (!parsedRow) {
+                ++chunkStat.skipped;
+                continue;
+            }
+            chunkRows[index].push_back(std::move(*parsedRow));
         }
-        std::string normClub = normalize(parsedRow->clubName);
+    });
+
+    for (const ImportStats &chunkStat : chunkStats) {
+        stats.parsed += chunkStat.parsed;
+        stats.skipped += chunkStat.skipped;
+    }
+
+    std::vector<FifaRow> rows;
+    for (auto &chunk : chunkRows) {
+        std::move(chunk.begin(), chunk.end(), std::back_inserter(rows));
+    }
+    return rows;
+}
+
+// The English-league rows of the export, from the parse cache when it matches the file.
+std::vector<FifaRow> readCsvRows(const std::string &csvPath, int filterPlayerId, unsigned threads, bool useCache,
+                                 bool verbose, ImportStats &stats) {
+    io::MappedFile file;
+    try {
+        file = io::MappedFile(csvPath);
+    } catch (const std::exception &) {
+        throw std::runtime_error("Failed to open CSV file: " + csvPath);
+    }
+    std::string_view text(reinterpret_cast<const char *>(file.data()), file.size());
+
+    // Reruns over the same export map the snapshot the first run left next to it instead of parsing.
+    // A --player-id run filters differently, so it neither reads nor writes one.
+    useCache = useCache && filterPlayerId <= 0;
+    std::filesystem::path cachePath = csvPath + ".pm3cache";
+    column_cache::Key cacheKey;
+    std::vector<FifaRow> rows;
+    bool cached = false;
+    if (useCache) {
+        cacheKey = parseCacheKey(text);
+        cached = loadCachedRows(cachePath, cacheKey, rows, stats);
+    }
+    if (!cached) {
+        rows = parseCsvRows(text, csvPath, filterPlayerId, threads, stats);
+        if (useCache && !saveCachedRows(cachePath, cacheKey, rows, stats)) {
+            std::cerr << "Warning: could not write parse cache " << cachePath.string() << "\n";
+        }
+    }
+    if (verbose && cached) {
+        std::cout << "Read " << rows.size() << " parsed rows from " << cachePath.string() << "\n";
+    }
+    return rows;
+}
+
+ImportStats importCsvToPlayers(const std::string &csvPath, int baseYear, bool verbose,
+                               int filterPlayerId, int debugPlayerId, bool importLoans, unsigned threads,
+                               bool useCache,
+                               gamea &gameDataOut, gameb &clubDataOut, gamec &playerOut,
+                               std::vector<int> *droppedClubsOut, import_manifest::Manifest *manifestOut) {
+    ImportStats stats;
+    std::vector<FifaRow> rows = readCsvRows(csvPath, filterPlayerId, threads, useCache, verbose, stats);
+    if (manifestOut) {
+        *manifestOut = {};
+    }
+
+    std::map<std::string, size_t> bucketIndex;
+    std::vector<ClubBucket> buckets;
+    for (const FifaRow &row : rows) {
+        std::string normClub = normalize(row.clubName);
         if (normClub.empty()) {
             ++stats.skipped;
             continue;
@@ -1163,20 +1373,20 @@ ImportStats importCsvToPlayers(const std::string &csvPath, int baseYear, bool ve
             idx = buckets.size();
             bucketIndex[normClub] = idx;
             ClubBucket bucket;
-            bucket.name = parsedRow->clubName.empty() ? "Club " + std::to_string(idx + 1) : parsedRow->clubName;
-            bucket.leagueName = parsedRow->leagueName;
-            bucket.leagueLevel = parsedRow->leagueLevel > 0 ? parsedRow->leagueLevel : 5;
+            bucket.name = row.clubName.empty() ? "Club " + std::to_string(idx + 1) : row.clubName;
+            bucket.leagueName = row.leagueName;
+            bucket.leagueLevel = row.leagueLevel > 0 ? row.leagueLevel : 5;
             buckets.push_back(bucket);
         } else {
             idx = it->second;
         }
-        if (parsedRow->leagueLevel > 0 && parsedRow->leagueLevel < buckets[idx].leagueLevel) {
-            buckets[idx].leagueLevel = parsedRow->leagueLevel;
+        if (row.leagueLevel > 0 && row.leagueLevel < buckets[idx].leagueLevel) {
+            buckets[idx].leagueLevel = row.leagueLevel;
         }
-        if (buckets[idx].leagueName.empty() && !parsedRow->leagueName.empty()) {
-            buckets[idx].leagueName = parsedRow->leagueName;
+        if (buckets[idx].leagueName.empty() && !row.leagueName.empty()) {
+            buckets[idx].leagueName = row.leagueName;
         }
-        buckets[idx].players.push_back(*parsedRow);
+        buckets[idx].players.push_back(row);
         ++stats.imported;
     }
 
@@ -1415,6 +1625,7 @@ ImportStats importCsvToPlayers(const std::string &csvPath, int baseYear, bool ve
         }
 
         size_t assigned = 0;
+        std::unordered_map<int, int16_t> placedRecords; // by player_id
         std::unordered_map<std::string, int> nameCounts;
         for (const auto &p : selected) {
             std::string last = extractLastName(p.name);
@@ -1447,6 +1658,9 @@ ImportStats importCsvToPlayers(const std::string &csvPath, int baseYear, bool ve
             }
             newPlayers.player[idx] = rec;
             club.player_index[assigned] = encodePlayerIndex(static_cast<int16_t>(idx), true);
+            if (p.playerId > 0) {
+                placedRecords[p.playerId] = static_cast<int16_t>(idx);
+            }
             ++assigned;
         }
 
@@ -1460,6 +1674,14 @@ ImportStats importCsvToPlayers(const std::string &csvPath, int baseYear, bool ve
         club.league = static_cast<uint8_t>(leagueTier);
 
         placements.push_back({targetIdx, leagueTier, normalize(bucket.name)});
+        if (manifestOut) {
+            manifestOut->clubs.push_back({static_cast<int16_t>(targetIdx), normalize(bucket.name)});
+            for (const FifaRow &p : players) {
+                auto placed = placedRecords.find(p.playerId);
+                int16_t record = placed != placedRecords.end() ? placed->second : int16_t{-1};
+                manifestOut->players.push_back({p.playerId, record, static_cast<int16_t>(targetIdx), rowHash(p)});
+            }
+        }
         ++clubIdx;
     }
 
@@ -1592,6 +1814,78 @@ ImportStats importCsvToPlayers(const std::string &csvPath, int baseYear, bool ve
     return stats;
 }
 
+// The ratings, age and foot of a fresh import of `row`; name, match stats, morale, injuries,
+// contract and training stay as the game left them.
+void applyAttributes(PlayerRecord &rec, const FifaRow &row, int baseYear) {
+    PlayerRecord fresh = buildRecord(row, baseYear, false);
+    rec.u13 = fresh.u13;
+    rec.u15 = fresh.u15;
+    rec.u17 = fresh.u17;
+    rec.u19 = fresh.u19;
+    rec.u21 = fresh.u21;
+    rec.u23 = fresh.u23;
+    rec.u25 = fresh.u25;
+    rec.hn = fresh.hn;
+    rec.tk = fresh.tk;
+    rec.ps = fresh.ps;
+    rec.sh = fresh.sh;
+    rec.hd = fresh.hd;
+    rec.cr = fresh.cr;
+    rec.ft = fresh.ft;
+    rec.aggr = fresh.aggr;
+    rec.age = fresh.age;
+    rec.foot = fresh.foot;
+}
+
+// Joins the export against the previous import's manifest by player_id and patches only the
+// players that were added, removed, re-rated or moved between the imported clubs. Club records,
+// league tables and every other player are left as the game has them. Updates the manifest.
+import_manifest::ApplyStats updateFromCsv(const std::string &csvPath, int baseYear, bool verbose, bool importLoans,
+                                          unsigned threads, bool useCache, import_manifest::Manifest &manifest,
+                                          gameb &clubDataOut, gamec &playerOut) {
+    ImportStats parseStats;
+    std::vector<FifaRow> rows = readCsvRows(csvPath, 0, threads, useCache, verbose, parseStats);
+    std::unordered_map<std::string, int16_t> clubByName;
+    for (const import_manifest::Club &club : manifest.clubs) {
+        clubByName.emplace(club.name, club.index);
+    }
+    std::vector<import_manifest::Row> joinRows;
+    joinRows.reserve(rows.size());
+    for (const FifaRow &row : rows) {
+        auto club = clubByName.find(normalize(row.clubName));
+        joinRows.push_back({row.playerId, club != clubByName.end() ? club->second : int16_t{-1}, rowHash(row)});
+    }
+    auto changes = import_manifest::diff(manifest.players, joinRows);
+    if (verbose) {
+        static const char *kNames[] = {"added", "removed", "re-rated", "moved"};
+        for (const import_manifest::Difference &difference : changes) {
+            int playerId = difference.current != import_manifest::kNone ? rows[difference.current].playerId
+                                                                        : manifest.players[difference.previous].playerId;
+            std::cout << "player_id " << playerId << " " << kNames[static_cast<int>(difference.change)] << "\n";
+        }
+    }
+
+    import_manifest::Hooks hooks;
+    // A new player is named as the import names them, told apart from the squad they join.
+    hooks.build = [&](size_t index, const ClubRecord &club, const gamec &players) {
+        const FifaRow &row = rows[index];
+        PlayerRecord rec = buildRecord(row, baseYear, importLoans && isLoanFieldSet(row.clubLoanedFrom));
+        std::string lastKey = uppercaseToken(extractLastName(row.name));
+        int duplicates = 1;
+        for (int slot = 0; slot < 24; ++slot) {
+            int16_t idx = decodePlayerIndex(club.player_index[slot], true);
+            if (idx >= 0 && static_cast<size_t>(idx) < std::extent_v<decltype(players.player)>) {
+                std::string name(players.player[idx].name, strnlen(players.player[idx].name, sizeof(rec.name)));
+                duplicates += uppercaseToken(extractLastName(name)) == lastKey ? 1 : 0;
+            }
+        }
+        copyString(rec.name, sizeof(rec.name), buildDisplayName(row, duplicates));
+        return rec;
+    };
+    hooks.refresh = [&](PlayerRecord &rec, size_t index) { applyAttributes(rec, rows[index], baseYear); };
+    return import_manifest::apply(manifest, joinRows, changes, clubDataOut, playerOut, hooks);
+}
+
 bool verifyGamedataRoundtrip(const std::string &pm3Path) {
     namespace fs = std::filesystem;
     std::filesystem::path path = io::constructGameFilePath(pm3Path, std::string{kGameDataFile});
@@ -1661,7 +1955,7 @@ int main(int argc, char **argv) {
     if (!parsed) {
         std::cerr << "Usage: fifa_import_tool --csv FC26_YYYYMMDD.csv --pm3 /path/to/PM3 (--game <1-8> | --base) "
                      "[--year <value>] [--verbose] [--verify-gamedata] [--player-id <id>] [--debug-player <id>] "
-                     "[--import-loans] [--dropped-clubs <path>]\n";
+                     "[--import-loans] [--dropped-clubs <path>] [--threads <n>] [--no-cache] [--update]\n";
         return 1;
     }
     Args args = *parsed;
@@ -1705,18 +1999,38 @@ int main(int argc, char **argv) {
         baseYear = 2025;
     }
 
+    // A --player-id import is for debugging and writes no manifest; it drops the old one instead
+    // (below), since that would no longer describe the rewritten slot.
+    std::filesystem::path manifestPath = importManifestPath(args);
+    import_manifest::Manifest manifest;
+    bool writeManifest = args.playerId <= 0;
+    if (args.update && !import_manifest::read(manifestPath, manifest)) {
+        std::cerr << "No previous import manifest at " << manifestPath.string() << "; run a full import first\n";
+        return 1;
+    }
+
     try {
-        std::vector<int> droppedClubs;
-        ImportStats stats = importCsvToPlayers(args.csvFile, baseYear, args.verbose,
-                                               args.playerId, args.debugPlayerId, args.importLoans,
-                                               gameDataOut, clubDataOut, playerDataOut,
-                                               args.droppedClubsPath.empty() ? nullptr : &droppedClubs);
-        std::cout << "Imported " << stats.imported << " players (parsed " << stats.parsed
-                  << ", skipped " << stats.skipped << "). Base year: " << baseYear << "\n";
-        if (!args.droppedClubsPath.empty()) {
-            writeDroppedClubs(args.droppedClubsPath, droppedClubs, clubDataOut);
-            if (args.verbose) {
-                std::cout << "Dropped club list written to " << args.droppedClubsPath << "\n";
+        if (args.update) {
+            import_manifest::ApplyStats stats = updateFromCsv(args.csvFile, baseYear, args.verbose, args.importLoans, args.threads,
+                                              args.useCache, manifest, clubDataOut, playerDataOut);
+            std::cout << "Updated players: " << stats.added << " added, " << stats.removed << " removed, "
+                      << stats.attributesChanged << " re-rated, " << stats.clubChanged << " moved ("
+                      << stats.benched << " without a squad place). Base year: " << baseYear << "\n";
+        } else {
+            std::vector<int> droppedClubs;
+            ImportStats stats = importCsvToPlayers(args.csvFile, baseYear, args.verbose,
+                                                   args.playerId, args.debugPlayerId, args.importLoans, args.threads,
+                                                   args.useCache,
+                                                   gameDataOut, clubDataOut, playerDataOut,
+                                                   args.droppedClubsPath.empty() ? nullptr : &droppedClubs,
+                                                   writeManifest ? &manifest : nullptr);
+            std::cout << "Imported " << stats.imported << " players (parsed " << stats.parsed
+                      << ", skipped " << stats.skipped << "). Base year: " << baseYear << "\n";
+            if (!args.droppedClubsPath.empty()) {
+                writeDroppedClubs(args.droppedClubsPath, droppedClubs, clubDataOut);
+                if (args.verbose) {
+                    std::cout << "Dropped club list written to " << args.droppedClubsPath << "\n";
+                }
             }
         }
     } catch (const std::exception &ex) {
@@ -1724,6 +2038,21 @@ int main(int argc, char **argv) {
         return 1;
     }
 
+    // The manifest is staged before the save and only replaces the old one after it, so it never
+    // describes files that were not written, and a save is never left without its manifest.
+    std::string error;
+    if (writeManifest && !import_manifest::stage(manifestPath, manifest, error)) {
+        std::cerr << "Failed to save data: " << error << "\n";
+        return 1;
+    }
+    if (!writeManifest) {
+        std::error_code ec;
+        std::filesystem::remove(manifestPath, ec);
+        if (ec) {
+            std::cerr << "Failed to save data: could not remove " << manifestPath.string() << "\n";
+            return 1;
+        }
+    }
     try {
         if (args.baseData) {
             io::saveDefaultGamedata(args.pm3Path, gameDataOut);
@@ -1733,9 +2062,14 @@ int main(int argc, char **argv) {
             io::saveBinaries(args.gameNumber, args.pm3Path, gameDataOut, clubDataOut, playerDataOut);
         }
     } catch (const std::exception &ex) {
+        import_manifest::discardStaged(manifestPath);
         std::cerr << "Failed to save data: " << ex.what() << "\n";
         return 1;
     }
+    if (writeManifest && !import_manifest::commitStaged(manifestPath, error)) {
+        std::cerr << error << "; the data was saved, so run a full import before the next --update\n";
+        return 1;
+    }
 
     return 0;
 }
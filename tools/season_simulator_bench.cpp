@@ -0,0 +1,72 @@
+// Benchmark for the season simulator: full five-division seasons from the first turn, with
+// spread-out team strengths. Exits non-zero when the run takes longer than the budget.
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "season_simulator.h"
+
+namespace {
+
+season_simulator::Season fullSeason() {
+    season_simulator::Season season;
+    std::mt19937 rng(1994);
+    std::uniform_real_distribution<float> spread(-12.0f, 12.0f);
+    for (int d = 0; d < season_simulator::kDivisions; ++d) {
+        season.divisionStart[d] = static_cast<uint16_t>(season.teams.size());
+        for (int i = 0; i < season_simulator::kDivisionSizes[d]; ++i) {
+            season_simulator::Team team;
+            team.club = static_cast<int16_t>(season.teams.size());
+            team.division = static_cast<uint8_t>(d);
+            team.strength = 70.0f - 8.0f * d + spread(rng);
+            season.teams.push_back(team);
+        }
+    }
+    season.divisionStart[season_simulator::kDivisions] = static_cast<uint16_t>(season.teams.size());
+
+    for (int d = 0; d < season_simulator::kDivisions; ++d) {
+        for (int a = season.divisionStart[d]; a < season.divisionStart[d + 1]; ++a) {
+            for (int b = season.divisionStart[d]; b < season.divisionStart[d + 1]; ++b) {
+                if (a != b) {
+                    season.fixtures.push_back({static_cast<uint8_t>(a), static_cast<uint8_t>(b)});
+                }
+            }
+        }
+    }
+    return season;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    season_simulator::Options options;
+    double budgetSeconds = 5.0;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--seasons" && i + 1 < argc) {
+            options.seasons = std::atoi(argv[++i]);
+        } else if ((a == "--threads" || a == "-t") && i + 1 < argc) {
+            options.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (a == "--budget" && i + 1 < argc) {
+            budgetSeconds = std::atof(argv[++i]);
+        } else {
+            std::cerr << "Usage: season_simulator_bench [--seasons <n>] [--threads <n>] [--budget <seconds>]\n";
+            return 1;
+        }
+    }
+
+    season_simulator::Season season = fullSeason();
+    auto start = std::chrono::steady_clock::now();
+    season_simulator::Result result = season_simulator::simulate(season, options);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << result.seasons << " seasons of " << season.fixtures.size() << " fixtures in " << seconds << " s ("
+              << static_cast<double>(result.seasons) / seconds << " seasons/s)\n";
+    if (seconds > budgetSeconds) {
+        std::cerr << "Over the " << budgetSeconds << " s budget\n";
+        return 1;
+    }
+    return 0;
+}
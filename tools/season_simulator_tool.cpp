@@ -0,0 +1,118 @@
+// Command-line helper to project the rest of the league season in a save slot: title, promotion
+// and relegation odds per club as CSV.
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "byte_order.h"
+#include "io.h"
+#include "season_simulator.h"
+
+namespace {
+
+struct Args {
+    std::string pm3Path;
+    std::string outputPath;
+    int gameNumber = 0;
+    season_simulator::Options options;
+};
+
+std::optional<Args> parseArgs(int argc, char **argv) {
+    Args args;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if ((a == "--pm3" || a == "-p") && i + 1 < argc) {
+            args.pm3Path = argv[++i];
+        } else if ((a == "--game" || a == "-g") && i + 1 < argc) {
+            args.gameNumber = std::atoi(argv[++i]);
+        } else if (a == "--seasons" && i + 1 < argc) {
+            args.options.seasons = std::atoi(argv[++i]);
+        } else if ((a == "--threads" || a == "-t") && i + 1 < argc) {
+            args.options.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (a == "--seed" && i + 1 < argc) {
+            args.options.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if ((a == "--output" || a == "-o") && i + 1 < argc) {
+            args.outputPath = argv[++i];
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    if (args.pm3Path.empty() || args.gameNumber < 1 || args.gameNumber > 8 || args.options.seasons < 1) {
+        return std::nullopt;
+    }
+    return args;
+}
+
+std::string clubName(const ClubRecord &club) {
+    std::string name(club.name, strnlen(club.name, sizeof(club.name)));
+    while (!name.empty() && name.back() == ' ') {
+        name.pop_back();
+    }
+    if (name.find_first_of(",\"") == std::string::npos) {
+        return name;
+    }
+    std::string quoted = "\"";
+    for (char c : name) {
+        quoted += c;
+        if (c == '"') {
+            quoted += '"';
+        }
+    }
+    return quoted + "\"";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    auto parsed = parseArgs(argc, argv);
+    if (!parsed) {
+        std::cerr << "Usage: season_simulator_tool --pm3 /path/to/PM3 --game <1-8> [--seasons <n>] "
+                     "[--threads <n>] [--seed <n>] [--output <file>]\n";
+        return 1;
+    }
+    Args args = *parsed;
+
+    auto game = std::make_unique<gamea>();
+    auto clubs = std::make_unique<gameb>();
+    auto players = std::make_unique<gamec>();
+    try {
+        io::loadBinaries(args.gameNumber, args.pm3Path, *game, *clubs, *players);
+    } catch (const std::exception &ex) {
+        std::cerr << "Load failed: " << ex.what() << "\n";
+        return 1;
+    }
+    byte_order::toNative(*game, *clubs, *players);
+
+    season_simulator::Season season = season_simulator::fromSave(*game, *clubs, *players);
+    season_simulator::Result result = season_simulator::simulate(season, args.options);
+
+    std::string csv = "division,club,strength,points,title,promotion,relegation,average_points,average_position\n";
+    for (std::size_t t = 0; t < season.teams.size(); ++t) {
+        const season_simulator::Team &team = season.teams[t];
+        const season_simulator::ClubOdds &odds = result.clubs[t];
+        char numbers[128];
+        snprintf(numbers, sizeof(numbers), "%.1f,%d,%.4f,%.4f,%.4f,%.2f,%.2f", team.strength, team.points,
+                 odds.title, odds.promotion, odds.relegation, odds.averagePoints, odds.averagePosition);
+        csv += std::to_string(team.division) + "," + clubName(clubs->club[team.club]) + "," + numbers + "\n";
+    }
+
+    if (args.outputPath.empty()) {
+        std::cout << csv;
+        return 0;
+    }
+    std::ofstream out(args.outputPath, std::ios::binary);
+    if (!out.write(csv.data(), static_cast<std::streamsize>(csv.size()))) {
+        std::cerr << "Could not write " << args.outputPath << "\n";
+        return 1;
+    }
+    std::cerr << "Simulated " << result.seasons << " seasons of " << season.fixtures.size() << " fixtures into "
+              << args.outputPath << "\n";
+    return 0;
+}
@@ -0,0 +1,91 @@
+// Command-line helper to price every contracted player in a save slot and print the valuation
+// reports as CSV or JSON.
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "byte_order.h"
+#include "io.h"
+#include "valuation_report.h"
+
+namespace {
+
+struct Args {
+    std::string pm3Path;
+    std::string outputPath;
+    int gameNumber = 0;
+    bool json = false;
+    valuation_report::Options options;
+};
+
+std::optional<Args> parseArgs(int argc, char **argv) {
+    Args args;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if ((a == "--pm3" || a == "-p") && i + 1 < argc) {
+            args.pm3Path = argv[++i];
+        } else if ((a == "--game" || a == "-g") && i + 1 < argc) {
+            args.gameNumber = std::atoi(argv[++i]);
+        } else if ((a == "--format" || a == "-f") && i + 1 < argc) {
+            std::string format = argv[++i];
+            if (format != "csv" && format != "json") {
+                return std::nullopt;
+            }
+            args.json = format == "json";
+        } else if ((a == "--threads" || a == "-t") && i + 1 < argc) {
+            args.options.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (a == "--top" && i + 1 < argc) {
+            args.options.topCount = std::strtoul(argv[++i], nullptr, 10);
+        } else if ((a == "--output" || a == "-o") && i + 1 < argc) {
+            args.outputPath = argv[++i];
+        }
+    }
+
+    if (args.pm3Path.empty() || args.gameNumber < 1 || args.gameNumber > 8) {
+        return std::nullopt;
+    }
+    return args;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    auto parsed = parseArgs(argc, argv);
+    if (!parsed) {
+        std::cerr << "Usage: valuation_report_tool --pm3 /path/to/PM3 --game <1-8> [--format csv|json] "
+                     "[--threads <n>] [--top <n>] [--output <file>]\n";
+        return 1;
+    }
+    Args args = *parsed;
+
+    auto game = std::make_unique<gamea>();
+    auto clubs = std::make_unique<gameb>();
+    auto players = std::make_unique<gamec>();
+    try {
+        io::loadBinaries(args.gameNumber, args.pm3Path, *game, *clubs, *players);
+    } catch (const std::exception &ex) {
+        std::cerr << "Load failed: " << ex.what() << "\n";
+        return 1;
+    }
+    byte_order::toNative(*game, *clubs, *players);
+
+    valuation_report::Dataset dataset{*clubs, *players};
+    valuation_report::Report report = valuation_report::build(dataset, args.options);
+    std::string text = args.json ? valuation_report::toJson(report, dataset) : valuation_report::toCsv(report, dataset);
+
+    if (args.outputPath.empty()) {
+        std::cout << text;
+        return 0;
+    }
+    std::ofstream out(args.outputPath, std::ios::binary);
+    if (!out.write(text.data(), static_cast<std::streamsize>(text.size()))) {
+        std::cerr << "Could not write " << args.outputPath << "\n";
+        return 1;
+    }
+    std::cerr << "Priced " << report.players.size() << " players into " << args.outputPath << "\n";
+    return 0;
+}